@@ -1,4 +1,4 @@
 # Platform flags
 
 export COMPILER_PREFIX := aarch64-none-elf-
-export ARCH_CXX_FLAGS  := -mcpu=cortex-a57 -DVP_64_BIT -mno-outline-atomics
+export ARCH_CXX_FLAGS  := -mcpu=cortex-a57+crc+crypto -DVP_64_BIT -mno-outline-atomics
@@ -20,6 +20,7 @@
 #include <awn/res/res_systemfiledevice.win32.hpp>
 #include <awn/res/res_filedevicemanager.hpp>
 #include <awn/res/res_zstddecompressor.hpp>
+#include <awn/res/res_yaz0decompressor.hpp>
 #include <awn/res/res_resource.hpp>
 #include <awn/res/res_archiveresource.hpp>
 #include <awn/res/res_archivefiledevice.hpp>
@@ -29,6 +30,7 @@
 
 #include <awn/res/res_sarcarchiveresource.hpp>
 #include <awn/res/res_beaarchiveresource.hpp>
+#include <awn/res/res_byamlresource.hpp>
 
 #include <awn/res/res_writemanager.hpp>
 
@@ -26,6 +26,8 @@ namespace awn::res {
             virtual Result OpenFileImpl(FileHandle *out_file_handle, const char *path, OpenMode open_mode) override;
             virtual Result CloseFileImpl(FileHandle *file_handle) override;
             virtual Result ReadFileImpl(void *read_buffer, size_t *out_read_size, FileHandle *file_handle, size_t read_size, size_t file_offset) override;
+            virtual Result MapFileImpl(FileMapping *out_file_mapping, const char *path) override;
+            virtual Result UnmapFileImpl(FileMapping *file_mapping) override;
             virtual Result GetFileSizeImpl(size_t *out_size, FileHandle *file_handle) override;
             virtual Result GetFileSizeImpl(size_t *out_size, const char *path) override;
             virtual Result CheckFileExistsImpl(const char *path) override;
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace awn::res {
+
+    class ByamlResource : public Resource {
+        private:
+            vp::res::NativeByamlIterator m_byaml_iterator;
+        public:
+            VP_RTTI_DERIVED(ByamlResource, Resource);
+        public:
+            constexpr ByamlResource() : Resource(), m_byaml_iterator() {/*...*/}
+            virtual ~ByamlResource() override {/*...*/}
+
+            virtual Result OnFileLoad(mem::Heap *heap, mem::Heap *gpu_heap, void *file, size_t file_size) override {
+                VP_UNUSED(gpu_heap);
+
+                /* Integrity checks */
+                RESULT_RETURN_UNLESS(file != nullptr && sizeof(vp::res::ResByaml) <= file_size, ResultInvalidFile);
+                vp::res::ResByaml *byaml = vp::res::ResByaml::ResCast(file);
+                RESULT_RETURN_UNLESS(byaml != nullptr, ResultInvalidFile);
+
+                /* Swap reverse endian byaml to native endian once, mapped files are copy on write */
+                byaml->NormalizeEndian(heap);
+
+                /* Iterate without runtime endian checks */
+                m_byaml_iterator = vp::res::NativeByamlIterator(file);
+                RESULT_RETURN_UNLESS(m_byaml_iterator.IsValid() == true, ResultInvalidFile);
+
+                RESULT_RETURN_SUCCESS;
+            }
+
+            constexpr const vp::res::NativeByamlIterator &GetByamlIterator() const { return m_byaml_iterator; }
+    };
+}
@@ -6,23 +6,27 @@ namespace awn::res {
         public:
             using HandleAllocator       = vp::util::AtomicIndexAllocator<u8>;
             using ZstdDecompressorArray = vp::util::HeapArray<ZstdDecompressor>;
+            using Yaz0DecompressorArray = vp::util::HeapArray<Yaz0Decompressor>;
 		private:
             HandleAllocator       m_index_allocator;
             ZstdDecompressorArray m_zstd_decompressor_array;
+            Yaz0DecompressorArray m_yaz0_decompressor_array;
             sys::ServiceEvent     m_free_event;
         public:
-            constexpr DecompressorManager() : m_index_allocator(), m_zstd_decompressor_array(), m_free_event() {/*...*/}
+            constexpr DecompressorManager() : m_index_allocator(), m_zstd_decompressor_array(), m_yaz0_decompressor_array(), m_free_event() {/*...*/}
             constexpr ~DecompressorManager() {/*...*/}
 
-            void Initialize(mem::Heap *heap, u32 core_count) {
+            void Initialize(mem::Heap *heap, u32 core_count, u32 zstd_read_depth = ZstdDecompressor::cDefaultReadDepth) {
 
                 /* Initialize arrays */
                 m_index_allocator.Initialize(heap, core_count);
                 m_zstd_decompressor_array.Initialize(heap, core_count);
+                m_yaz0_decompressor_array.Initialize(heap, core_count);
 
                 /* Initialize decompressors */
                 for (u32 i = 0; i < core_count; ++i) {
-                    m_zstd_decompressor_array[i].Initialize(heap);
+                    m_zstd_decompressor_array[i].Initialize(heap, zstd_read_depth, this);
+                    m_yaz0_decompressor_array[i].Initialize(heap);
                 }
 
                 /* Initialize auto reset free event */
@@ -37,10 +41,14 @@ namespace awn::res {
                 for (u32 i = 0; i < m_zstd_decompressor_array.GetCount(); ++i) {
                     m_zstd_decompressor_array[i].Finalize();
                 }
+                for (u32 i = 0; i < m_yaz0_decompressor_array.GetCount(); ++i) {
+                    m_yaz0_decompressor_array[i].Finalize();
+                }
 
                 /* Finalize arrays */
                 m_index_allocator.Finalize();
                 m_zstd_decompressor_array.Finalize();
+                m_yaz0_decompressor_array.Finalize();
 
                 return;
             }
@@ -58,6 +66,10 @@ namespace awn::res {
                 return index;
             }
 
+            u32 TryAllocateDecompressorHandle() {
+                return m_index_allocator.Allocate();
+            }
+
             void FreeDecompressorHandle(u32 handle) {
 
                 /* Free handle */
@@ -67,12 +79,18 @@ namespace awn::res {
                 return;
             }
 
+            ZstdDecompressor *GetZstdDecompressor(u32 handle) {
+                return std::addressof(m_zstd_decompressor_array[handle]);
+            }
+
             IDecompressor *GetDecompressor(u32 handle, CompressionType decompressor_type, u32 priority, sys::CoreMask core_mask) {
 
                 /* Get decompressor */
                 IDecompressor *decompressor = nullptr;
                 if (decompressor_type == CompressionType::Zstandard) {                    
                     decompressor = std::addressof(m_zstd_decompressor_array[handle]);
+                } else if (decompressor_type == CompressionType::Szs) {
+                    decompressor = std::addressof(m_yaz0_decompressor_array[handle]);
                 }
                 VP_ASSERT(decompressor != nullptr);
 
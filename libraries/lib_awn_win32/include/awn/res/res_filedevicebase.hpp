@@ -90,13 +90,66 @@ namespace awn::res {
         ALWAYS_INLINE Result Close();
     };
 
+    struct FileMapping {
+        void           *mapping_handle;
+        FileDeviceBase *file_device;
+        void           *mapped_address;
+        size_t          mapped_size;
+
+        constexpr void SetDefaults() {
+            mapping_handle = nullptr;
+            file_device    = nullptr;
+            mapped_address = nullptr;
+            mapped_size    = 0;
+        }
+
+        constexpr bool IsMapped() const { return file_device != nullptr; }
+
+        ALWAYS_INLINE Result Unmap();
+    };
+
     struct FileLoadContext {
-        mem::Heap  *file_heap;
-        u32         read_div;
-        bool        out_is_file_memory_allocated;
-        void       *file_buffer;
-        size_t      file_size;
-        s32         file_alignment;
+        mem::Heap   *file_heap;
+        u32          read_div;
+        bool         out_is_file_memory_allocated;
+        void        *file_buffer;
+        size_t       file_size;
+        s32          file_alignment;
+        bool         is_map_file;
+        FileMapping  out_file_mapping;
+        const char  *nisasyst_path;
+        bool         is_check_crc32b;
+        u32          expected_crc32b;
+    };
+
+    struct AsyncReadRequest {
+        void       *read_buffer;
+        FileHandle *file_handle;
+        size_t      read_size;
+        size_t      file_offset;
+        size_t      out_read_size;
+        Result      out_result;
+        bool        is_pending;
+        OVERLAPPED  overlapped;
+
+        constexpr void SetDefaults() {
+            read_buffer   = nullptr;
+            file_handle   = nullptr;
+            read_size     = 0;
+            file_offset   = 0;
+            out_read_size = 0;
+            out_result    = ResultSuccess;
+            is_pending    = false;
+            overlapped    = {};
+        }
+
+        void Finalize() {
+            VP_ASSERT(is_pending == false);
+            if (overlapped.hEvent != nullptr) {
+                ::CloseHandle(overlapped.hEvent);
+            }
+            overlapped.hEvent = nullptr;
+        }
     };
 
     struct FileSaveInfo {
@@ -110,6 +163,8 @@ namespace awn::res {
         public:
             static constexpr s32    cMinimumFileAlignment = 0x20;
             static constexpr size_t cMaxAutoReadSize      = 0x20;
+            static constexpr u32    cMaxLoadReadDepth     = 4;
+            static constexpr size_t cMaxLoadReadSize      = vp::util::c1GB;
         protected:
             vp::util::IntrusiveRedBlackTreeNode<u32> m_manager_tree_node;
             MaxDriveString                           m_device_name;
@@ -123,6 +178,10 @@ namespace awn::res {
             virtual Result ReadFileImpl(void *read_buffer, size_t *out_read_size, FileHandle *file_handle, size_t read_size, size_t file_offset)       { VP_ASSERT(false); VP_UNUSED(read_buffer, out_read_size, file_handle, read_size, file_offset); }
             virtual Result WriteFileImpl(size_t *out_written_size, FileHandle *file_handle, void *write_buffer, size_t write_size, size_t file_offset) { VP_ASSERT(false); VP_UNUSED(out_written_size, file_handle, write_buffer, write_size, file_offset); }
             virtual Result CopyFileImpl(const char *dest_path, const char *source_path, void *copy_buffer, size_t copy_size);
+            virtual Result SubmitReadFileAsyncImpl(AsyncReadRequest *read_request);
+            virtual Result CompleteReadFileAsyncImpl(AsyncReadRequest *read_request, bool is_wait);
+            virtual Result MapFileImpl(FileMapping *out_file_mapping, const char *path)                                                                { VP_UNUSED(out_file_mapping, path); return ResultFileMappingUnsupported; }
+            virtual Result UnmapFileImpl(FileMapping *file_mapping)                                                                                    { VP_UNUSED(file_mapping); RESULT_RETURN_SUCCESS; }
             virtual Result CommitImpl()                                                                                                                { VP_ASSERT(false); }
             virtual Result FlushFileImpl(FileHandle *file_handle)                                                                                      { VP_ASSERT(false); VP_UNUSED(file_handle); }
 
@@ -159,6 +218,13 @@ namespace awn::res {
             ALWAYS_INLINE Result CopyFile(const char *dest_path, const char *source_path, void *copy_buffer, size_t copy_size)                           { return this->CopyFileImpl(dest_path, source_path, copy_buffer, copy_size); }
             ALWAYS_INLINE Result FlushFile(FileHandle *file_handle)                                                                                      { return this->FlushFileImpl(file_handle); }
 
+            ALWAYS_INLINE Result SubmitReadFileAsync(AsyncReadRequest *read_request)      { return this->SubmitReadFileAsyncImpl(read_request); }
+            ALWAYS_INLINE Result WaitReadFileAsync(AsyncReadRequest *read_request)        { return this->CompleteReadFileAsyncImpl(read_request, true); }
+            ALWAYS_INLINE Result TryCompleteReadFileAsync(AsyncReadRequest *read_request) { return this->CompleteReadFileAsyncImpl(read_request, false); }
+
+            ALWAYS_INLINE Result MapFile(FileMapping *out_file_mapping, const char *path) { return this->MapFileImpl(out_file_mapping, path); }
+            ALWAYS_INLINE Result UnmapFile(FileMapping *file_mapping)                    { return this->UnmapFileImpl(file_mapping); }
+
             ALWAYS_INLINE Result Commit() { return this->CommitImpl(); }
     
             ALWAYS_INLINE Result GetFileSize(size_t *out_size, FileHandle *file_handle) { return this->GetFileSizeImpl(out_size, file_handle); }
@@ -189,4 +255,11 @@ namespace awn::res {
         file_device         = nullptr;
         return result;
     }
+
+    ALWAYS_INLINE Result FileMapping::Unmap() {
+        if (file_device == nullptr) { RESULT_RETURN_SUCCESS; }
+        const Result result = file_device->UnmapFile(this);
+        this->SetDefaults();
+        return result;
+    }
 }
@@ -33,11 +33,14 @@ namespace awn::res {
         protected:
             void                *m_file;
             size_t               m_file_size;
+            FileMapping          m_file_mapping;
         public:
             VP_RTTI_BASE(Resource);
         public:
-            constexpr ALWAYS_INLINE Resource() : m_file(), m_file_size() {/*...*/}
-            virtual ~Resource() {/*...*/}
+            constexpr ALWAYS_INLINE Resource() : m_file(), m_file_size(), m_file_mapping() {/*...*/}
+            virtual ~Resource() {
+                RESULT_ABORT_UNLESS(m_file_mapping.Unmap());
+            }
 
             virtual Result OnFileLoad(mem::Heap *heap, mem::Heap *gpu_heap, void *file, size_t file_size) { VP_UNUSED(heap, gpu_heap, file, file_size); RESULT_RETURN_SUCCESS; }
 
@@ -51,5 +54,6 @@ namespace awn::res {
 
             constexpr ALWAYS_INLINE void *GetFile()           { return m_file; }
             constexpr ALWAYS_INLINE u32   GetFileSize() const { return m_file_size; }
+            constexpr ALWAYS_INLINE bool  IsFileMapped() const { return m_file_mapping.IsMapped(); }
     };
 }
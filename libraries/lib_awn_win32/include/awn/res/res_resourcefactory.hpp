@@ -118,6 +118,12 @@ namespace awn::res {
                 resource->m_file      = resource_load_context->file_load_context.file_buffer;
                 resource->m_file_size = resource_load_context->file_load_context.file_size;
 
+                /* Transfer ownership of a file mapping to the resource */
+                if (resource_load_context->file_load_context.out_file_mapping.IsMapped() == true) {
+                    resource->m_file_mapping = resource_load_context->file_load_context.out_file_mapping;
+                    resource_load_context->file_load_context.out_file_mapping.SetDefaults();
+                }
+
                 /* Resource load callback */
                 resource->OnFileLoad(resource_load_context->resource_heap, resource_load_context->gpu_heap, resource_load_context->file_load_context.file_buffer, resource_load_context->file_load_context.file_size);
 
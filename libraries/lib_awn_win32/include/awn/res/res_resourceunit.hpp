@@ -23,10 +23,14 @@ namespace awn::res {
                 u32 is_cache_on_unload         : 1;
                 u32 compression_type           : 3;
                 u32 resource_heap_type         : 2;
-                u32 reserve0                   : 18;
+                u32 is_map_file                : 1;
+                u32 is_nisasyst_encrypted      : 1;
+                u32 is_check_crc32b            : 1;
+                u32 reserve0                   : 15;
             };
         };
         s32                  file_alignment;
+        u32                  expected_crc32b;
         size_t               resource_size;
         mem::Heap           *resource_heap;
         ResourceFactoryBase *resource_factory;
@@ -99,7 +103,15 @@ namespace awn::res {
                     u32 m_is_user_resource_size          : 1;
                     u32 m_heap_type                      : 3;
                     u32 m_compression_type               : 3;
-                    u32 m_reserve0                       : 1;
+                    u32 m_is_map_file                    : 1;
+                };
+            };
+            union {
+                u32 m_load_option_state;
+                struct {
+                    u32 m_is_nisasyst_encrypted          : 1;
+                    u32 m_is_check_crc32b                : 1;
+                    u32 m_reserve0                       : 30;
                 };
             };
             Status                       m_status;
@@ -108,6 +120,7 @@ namespace awn::res {
             u32                          m_resource_initialize_guard;
             size_t                       m_user_resource_size;
             s32                          m_file_alignment;
+            u32                          m_expected_crc32b;
 
             ResourceUnitManager         *m_resource_unit_manager;
             ResourceUnitTreeNode         m_resource_unit_manager_tree_node;
@@ -223,7 +236,7 @@ namespace awn::res {
 
             constexpr Resource *GetResource() { return m_resource; }
         public:
-            ResourceUnit() : m_state(), m_status(Status::Uninitialized), m_reference_count(), m_deferred_adjust_count{}, m_resource_initialize_guard(), m_user_resource_size(), m_file_alignment(), m_resource_unit_manager(),
+            ResourceUnit() : m_state(), m_load_option_state(), m_status(Status::Uninitialized), m_reference_count(), m_deferred_adjust_count{}, m_resource_initialize_guard(), m_user_resource_size(), m_file_alignment(), m_expected_crc32b(), m_resource_unit_manager(),
                              m_resource_unit_manager_tree_node(), m_file_path(), m_file_device(), m_resource_factory(), m_archive_binder(), m_archive_resource(), m_resource(), m_load_task(), m_heap_adjust_task(), m_unload_task(), 
                              m_resource_heap(), m_gpu_heap(), m_memory_manager(), m_finalize_async_res_mgr_list_node(), m_memory_manager_node(), m_memory_manager_free_cache_node(), m_status_update_event() 
             {
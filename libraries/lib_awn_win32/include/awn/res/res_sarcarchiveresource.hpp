@@ -19,14 +19,40 @@ namespace awn::res {
 
     class SarcArchiveResource : public ArchiveResource {
         private:
-            vp::res::SarcExtractor m_sarc_extractor;
+            vp::res::NativeSarcExtractor m_sarc_extractor;
         public:
             constexpr SarcArchiveResource() : ArchiveResource(), m_sarc_extractor() {/*...*/}
-            virtual ~SarcArchiveResource() override {/*...*/}
+            virtual ~SarcArchiveResource() override {
+                void *lookup_index = m_sarc_extractor.FinalizeLookupIndex();
+                if (lookup_index != nullptr) {
+                    ::operator delete(lookup_index);
+                }
+            }
 
             virtual Result OnFileLoad(mem::Heap *heap, mem::Heap *gpu_heap, void *file, size_t file_size) override {
-                VP_UNUSED(heap, gpu_heap, file_size);
+                VP_UNUSED(gpu_heap);
+
+                /* Swap reverse endian archives to native endian once, mapped files are copy on write */
+                vp::res::ResSarc *sarc = reinterpret_cast<vp::res::ResSarc*>(file);
+                RESULT_RETURN_UNLESS(sarc != nullptr && sizeof(vp::res::ResSarc) + sizeof(vp::res::ResSarcSfat) <= file_size && sarc->IsValid() == true, ResultInvalidFile);
+                if (sarc->IsReverseEndian() == true) {
+                    const u32 file_count = vp::util::SwapEndian(sarc->GetSfat()->file_count);
+                    RESULT_RETURN_IF(file_size < sizeof(vp::res::ResSarc) + sizeof(vp::res::ResSarcSfat) + sizeof(vp::res::ResSarcSfatEntry) * file_count + sizeof(vp::res::ResSarcSfnt), ResultInvalidFile);
+                    sarc->NormalizeEndian();
+                }
+
                 RESULT_RETURN_IF(m_sarc_extractor.Initialize(file) == false, ResultInvalidFile);
+
+                /* Build a lookup index for large archives, falling back to the sfat search if memory is unavailable */
+                const u32 file_count = m_sarc_extractor.GetFileCount();
+                if (vp::res::NativeSarcExtractor::cLookupIndexMinFileCount <= file_count) {
+                    const size_t  lookup_index_size = vp::res::NativeSarcExtractor::GetLookupIndexSize(file_count);
+                    void         *lookup_index      = ::operator new(lookup_index_size, heap, alignof(vp::res::NativeSarcExtractor::LookupEntry));
+                    if (lookup_index != nullptr) {
+                        m_sarc_extractor.InitializeLookupIndex(lookup_index, lookup_index_size);
+                    }
+                }
+
                 RESULT_RETURN_SUCCESS;
             }
 
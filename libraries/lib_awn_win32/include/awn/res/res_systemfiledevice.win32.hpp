@@ -26,6 +26,10 @@ namespace awn::res {
             virtual Result ReadFileImpl(void *read_buffer, size_t *out_read_size, FileHandle *file_handle, size_t read_size, size_t file_offset) override;
             virtual Result WriteFileImpl(size_t *out_written_size, FileHandle *file_handle, void *write_buffer, size_t write_size, size_t file_offset) override;
             virtual Result FlushFileImpl(FileHandle *file_handle) override;
+            virtual Result SubmitReadFileAsyncImpl(AsyncReadRequest *read_request) override;
+            virtual Result CompleteReadFileAsyncImpl(AsyncReadRequest *read_request, bool is_wait) override;
+            virtual Result MapFileImpl(FileMapping *out_file_mapping, const char *path) override;
+            virtual Result UnmapFileImpl(FileMapping *file_mapping) override;
             virtual Result GetFileSizeImpl(size_t *out_size, FileHandle *file_handle) override;
             virtual Result GetFileSizeImpl(size_t *out_size, const char *path) override;
             virtual Result CheckFileExistsImpl(const char *path) override;
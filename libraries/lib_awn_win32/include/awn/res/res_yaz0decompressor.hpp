@@ -0,0 +1,39 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace awn::res {
+
+    class Yaz0Decompressor : public IDecompressor {
+        public:
+            static constexpr size_t cReadSize         = 0x8'0000;
+            static constexpr u32    cDefaultReadDepth = 3;
+            static constexpr u32    cMaxReadDepth     = 8;
+        private:
+            void *m_work_memory;
+            u32   m_read_depth;
+        public:
+            VP_RTTI_DERIVED(Yaz0Decompressor, IDecompressor);
+        public:
+            constexpr Yaz0Decompressor() : m_work_memory(), m_read_depth() {/*...*/}
+            constexpr virtual ~Yaz0Decompressor() {/*...*/}
+
+            void Initialize(mem::Heap *heap, u32 read_depth = cDefaultReadDepth);
+            void Finalize();
+
+            virtual Result LoadDecompressFile(size_t *out_size, s32 *out_alignment, const char *path, FileLoadContext *file_load_context, FileDeviceBase *file_device) override;
+    };
+}
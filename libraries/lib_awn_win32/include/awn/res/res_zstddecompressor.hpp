@@ -17,44 +17,71 @@
 
 namespace awn::res {
 
+    class DecompressorManager;
+
     class ZstdDecompressor : public IDecompressor {
         public:
-            static constexpr size_t cMaxDictionaryCount = 8;
-            static constexpr size_t cReadSize           = 0xd'0000;
-            static constexpr size_t cLeftoverSize       = vp::util::c128KB;
+            static constexpr size_t cMaxDictionaryCount  = 8;
+            static constexpr size_t cReadSize            = 0xd'0000;
+            static constexpr size_t cLeftoverSize        = vp::util::c128KB;
+            static constexpr u32    cDefaultReadDepth    = 4;
+            static constexpr u32    cMaxReadDepth        = 8;
+            static constexpr u32    cMaxFrameHelpers     = 16;
+            static constexpr size_t cDecodeFramesMessage = 0x7fff'ffff'ffff'fffe;
+            static_assert(cMaxReadDepth <= 0x20);
         public:
             using DictionaryMap       = vp::util::FixedKeyIndexMap<cMaxDictionaryCount << 1>;
             using DictionaryAllocator = vp::util::FixedIndexAllocator<u8, cMaxDictionaryCount>;
+        public:
+            struct FrameDecodeContext {
+                FileDeviceBase                  *file_device;
+                FileHandle                      *file_handle;
+                void                            *output;
+                const vp::codec::ZstdFrameEntry *frame_array;
+                u32                              frame_count;
+                u32                              next_frame;
+                u32                              is_error;
+            };
         public:
             class DecompressorThread : public sys::ServiceThread {
                 public:
                     friend class ZstdDecompressor;
                 private:
-                    u32                           m_stream_count;
-                    u32                           m_is_error;
-                    void                         *m_stream_memory;
-                    vp::codec::ZstdStreamContext *m_current_stream_context;
-                    sys::ServiceEvent             m_decompress_finish_event;
-                    sys::ServiceEvent             m_stream_finish_event;
+                    u32                               m_stream_count;
+                    u32                               m_read_depth;
+                    u32                               m_is_error;
+                    void                             *m_stream_memory;
+                    vp::codec::ZstdStreamContext     *m_current_stream_context;
+                    vp::codec::NisasystStreamContext *m_current_decrypt_context;
+                    u32                              *m_current_crc32b;
+                    FrameDecodeContext               *m_frame_decode_context;
+                    ZstdDecompressor                 *m_parent_decompressor;
+                    sys::ServiceEvent                 m_stream_finish_event;
                 public:
-                    DecompressorThread(mem::Heap *heap);
+                    DecompressorThread(mem::Heap *heap, ZstdDecompressor *parent_decompressor, u32 read_depth);
                     virtual ~DecompressorThread() override;
 
                     virtual void ThreadMain(size_t stream_size) override;
+
+                    u32  GetStreamCount()                 { return vp::util::InterlockedLoadAcquire(std::addressof(m_stream_count)); }
+                    void WaitForStreamCount(u32 stream_count);
             };
         private:
             DecompressorThread   *m_decompressor_thread;
             void                 *m_work_memory;
+            mem::Heap            *m_heap;
+            DecompressorManager  *m_decompressor_manager;
+            u32                   m_read_depth;
             DictionaryMap         m_dic_map;
             ZSTD_DDict           *m_dic_array[cMaxDictionaryCount];
             DictionaryAllocator   m_dic_index_allocator;
         public:
             VP_RTTI_DERIVED(ZstdDecompressor, IDecompressor);
         public:
-            constexpr ZstdDecompressor() : m_decompressor_thread(), m_work_memory(), m_dic_map(), m_dic_array{}, m_dic_index_allocator() {/*...*/}
+            constexpr ZstdDecompressor() : m_decompressor_thread(), m_work_memory(), m_heap(), m_decompressor_manager(), m_read_depth(), m_dic_map(), m_dic_array{}, m_dic_index_allocator() {/*...*/}
             constexpr virtual ~ZstdDecompressor() {/*...*/}
 
-            void Initialize(mem::Heap *heap);
+            void Initialize(mem::Heap *heap, u32 read_depth = cDefaultReadDepth, DecompressorManager *decompressor_manager = nullptr);
             void Finalize();
 
             virtual void SetPriority(u32 priority) override;
@@ -64,6 +91,17 @@ namespace awn::res {
             virtual sys::CoreMask GetCoreMask() override { return m_decompressor_thread->GetCoreMask(); }
 
             virtual Result LoadDecompressFile(size_t *out_size, s32 *out_alignment, const char *path, FileLoadContext *file_load_context, FileDeviceBase *file_device) override;
+        private:
+            Result LoadDecompressSeekable(bool *out_is_seekable, FileLoadContext *file_load_context, FileDeviceBase *file_device, FileHandle *file_handle, size_t file_size, s32 output_alignment);
+            Result LoadDecompressGrowable(FileLoadContext *file_load_context, FileDeviceBase *file_device, FileHandle *file_handle, size_t file_size, size_t preloaded_size, size_t capacity_hint, s32 output_alignment, const ZSTD_frameHeader *frame_header, vp::codec::NisasystStreamContext *decrypt_context);
+
+            Result DecompressFrames(FrameDecodeContext *frame_decode_context);
+            Result DecompressFrame(FrameDecodeContext *frame_decode_context, const vp::codec::ZstdFrameEntry *frame_entry);
+
+            ZSTD_DDict *TryGetZsDic(u32 dic_id) {
+                const u32 index = m_dic_map.TryGetIndexByKey(dic_id);
+                return (index != DictionaryMap::cInvalidEntryIndex) ? m_dic_array[index] : nullptr;
+            }
         public:
             void RegisterZsDic(ZSTD_DDict *zstd_ddict);
             void UnregisterZsDic(ZSTD_DDict *zstd_ddict);
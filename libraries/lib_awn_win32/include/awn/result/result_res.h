@@ -62,4 +62,12 @@ namespace awn::res {
     DECLARE_RESULT(FailedToLoadResource,        42);
     DECLARE_RESULT(MemoryAllocationFailure,     43);
     DECLARE_RESULT(NoExternalHeap,              44);
+    DECLARE_RESULT(AsyncReadPending,            45);
+    DECLARE_RESULT(IncompleteRead,              46);
+    DECLARE_RESULT(NullAsyncReadRequest,        47);
+    DECLARE_RESULT(FileMappingUnsupported,      48);
+    DECLARE_RESULT(FailedToMapFile,             49);
+    DECLARE_RESULT(InvalidYaz0Stream,           50);
+    DECLARE_RESULT(Crc32bMismatch,              51);
+    DECLARE_RESULT(InvalidNisasystFile,         52);
 }
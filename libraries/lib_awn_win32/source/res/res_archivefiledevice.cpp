@@ -22,7 +22,7 @@ namespace awn::res {
         /* Integrity checks */
         RESULT_RETURN_UNLESS(out_file_handle != nullptr,                     ResultNullFileHandle);
         RESULT_RETURN_UNLESS(path != nullptr,                                ResultNullPath);
-        RESULT_RETURN_UNLESS((open_mode & OpenMode::Read) != OpenMode::Read, ResultInvalidOpenMode);
+        RESULT_RETURN_UNLESS((open_mode & OpenMode::Read) == OpenMode::Read, ResultInvalidOpenMode);
 
         /* Get entry index */
         out_file_handle->archive_entry_index = m_archive_resource->TryGetEntryIndex(path);
@@ -33,8 +33,9 @@ namespace awn::res {
         const bool result = m_archive_resource->TryGetFileByIndex(std::addressof(archive_file_return), out_file_handle->archive_entry_index);
         RESULT_RETURN_IF(result == false, ResultFailedToOpenFile);
 
-        out_file_handle->handle    = archive_file_return.file;
-        out_file_handle->file_size = archive_file_return.file_size;
+        out_file_handle->handle      = archive_file_return.file;
+        out_file_handle->file_size   = archive_file_return.file_size;
+        out_file_handle->file_device = this;
 
         RESULT_RETURN_SUCCESS;
     }
@@ -43,7 +44,7 @@ namespace awn::res {
         /* Integrity checks */
         RESULT_RETURN_UNLESS(file_handle != nullptr,           ResultNullFileHandle);
         RESULT_RETURN_UNLESS(file_handle->handle != nullptr,   ResultInvalidFileHandle);
-        RESULT_RETURN_UNLESS(file_handle->file_device != this, ResultInvalidFileHandle);
+        RESULT_RETURN_UNLESS(file_handle->file_device == this, ResultInvalidFileHandle);
 
         /* Clear handle state */
         file_handle->handle              = nullptr;
@@ -56,7 +57,7 @@ namespace awn::res {
         /* Integrity checks */
         RESULT_RETURN_UNLESS(file_handle != nullptr,           ResultNullFileHandle);
         RESULT_RETURN_UNLESS(file_handle->handle != nullptr,   ResultInvalidFileHandle);
-        RESULT_RETURN_UNLESS(file_handle->file_device != this, ResultInvalidFileHandle);
+        RESULT_RETURN_UNLESS(file_handle->file_device == this, ResultInvalidFileHandle);
 
         /* Copy file data */
         ::memcpy(read_buffer, reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(file_handle->handle) + file_offset), read_size);
@@ -67,6 +68,30 @@ namespace awn::res {
         RESULT_RETURN_SUCCESS;
     }
 
+    Result ArchiveFileDevice::MapFileImpl(FileMapping *out_file_mapping, const char *path) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(out_file_mapping != nullptr, ResultNullFileHandle);
+
+        /* Reference the file in place within the archive */
+        void        *file      = nullptr;
+        size_t       file_size = 0;
+        const Result result    = this->GetFileReferenceImpl(std::addressof(file), std::addressof(file_size), path);
+        RESULT_RETURN_UNLESS(result == ResultSuccess, result);
+
+        /* Set output mapping, the archive owns the memory so there is no mapping handle */
+        out_file_mapping->mapping_handle = nullptr;
+        out_file_mapping->file_device    = this;
+        out_file_mapping->mapped_address = file;
+        out_file_mapping->mapped_size    = file_size;
+
+        RESULT_RETURN_SUCCESS;
+    }
+    Result ArchiveFileDevice::UnmapFileImpl(FileMapping *file_mapping) {
+        RESULT_RETURN_UNLESS(file_mapping != nullptr, ResultNullFileHandle);
+        RESULT_RETURN_SUCCESS;
+    }
+
     Result ArchiveFileDevice::OpenDirectoryImpl(DirectoryHandle *out_directory_handle, const char *path) {
 
         /* Integrity checks */
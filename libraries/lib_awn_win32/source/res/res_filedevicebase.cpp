@@ -17,12 +17,68 @@
 
 namespace awn::res {
 
+    namespace {
+
+        Result DecryptAndCheckLoadedFile(size_t *out_size, const FileLoadContext *file_load_context, void *file, size_t file_size) {
+
+            /* Decrypt nisasyst in place */
+            if (file_load_context->nisasyst_path != nullptr) {
+                RESULT_RETURN_UNLESS(sizeof(vp::codec::cNisasystMagic) <= file_size && vp::codec::IsNisasystEncrypted(file, static_cast<u32>(file_size)) == true, ResultInvalidNisasystFile);
+
+                vp::codec::NisasystStreamContext decrypt_context = {};
+                vp::codec::InitializeNisasystStreamContext(std::addressof(decrypt_context), file_size, file_load_context->nisasyst_path);
+                file_size = vp::codec::StreamDecryptNisasyst(file, file_size, std::addressof(decrypt_context));
+            }
+
+            /* Check crc32b */
+            RESULT_RETURN_UNLESS(file_load_context->is_check_crc32b == false || vp::util::HashDataCrc32b(file, file_size) == file_load_context->expected_crc32b, ResultCrc32bMismatch);
+
+            *out_size = file_size;
+
+            RESULT_RETURN_SUCCESS;
+        }
+    }
+
     Result FileDeviceBase::LoadFileImpl(const char *path, FileLoadContext *file_load_context) {
 
         /* Integrity checks */
         RESULT_RETURN_IF(file_load_context->file_buffer != nullptr && file_load_context->file_size == 0, ResultInvalidFileBufferSize);
         RESULT_RETURN_IF((file_load_context->read_div & 0x1f) != 0, ResultInvalidReadDivAlignment);
 
+        /* Align alignment */
+        size_t output_alignment = (file_load_context->file_alignment < cMinimumFileAlignment) ? cMinimumFileAlignment : file_load_context->file_alignment;
+
+        /* Try a copy-on-write mapping of the file in place of a heap buffer, nisasyst files are buffered as archive mappings share memory */
+        if (file_load_context->is_map_file == true && file_load_context->file_buffer == nullptr && file_load_context->nisasyst_path == nullptr) {
+
+            FileMapping *file_mapping = std::addressof(file_load_context->out_file_mapping);
+            file_mapping->SetDefaults();
+
+            const Result map_result = this->MapFile(file_mapping, path);
+            if (map_result == ResultSuccess) {
+
+                /* Fallback to a buffered load if the mapping does not satisfy the alignment */
+                if ((reinterpret_cast<uintptr_t>(file_mapping->mapped_address) & (output_alignment - 1)) == 0) {
+
+                    /* Check crc32b */
+                    size_t       checked_size = 0;
+                    const Result check_result = DecryptAndCheckLoadedFile(std::addressof(checked_size), file_load_context, file_mapping->mapped_address, file_mapping->mapped_size);
+                    if (check_result != ResultSuccess) {
+                        RESULT_ABORT_UNLESS(file_mapping->Unmap());
+                        return check_result;
+                    }
+
+                    file_load_context->file_buffer                  = file_mapping->mapped_address;
+                    file_load_context->file_size                    = checked_size;
+                    file_load_context->file_alignment               = output_alignment;
+                    file_load_context->out_is_file_memory_allocated = false;
+                    RESULT_RETURN_SUCCESS;
+                }
+                RESULT_ABORT_UNLESS(file_mapping->Unmap());
+            }
+            RESULT_RETURN_UNLESS(map_result == ResultSuccess || map_result == ResultFileMappingUnsupported, map_result);
+        }
+
         /* Declare a file handle closed on exit */
         FileHandle handle = {};
         ON_SCOPE_EXIT {
@@ -38,9 +94,6 @@ namespace awn::res {
         const Result size_result = this->GetFileSize(std::addressof(file_size), std::addressof(handle));
         RESULT_RETURN_UNLESS(size_result == ResultSuccess, size_result);
 
-        /* Align alignment */
-        size_t output_alignment = (file_load_context->file_alignment < cMinimumFileAlignment) ? cMinimumFileAlignment : file_load_context->file_alignment;
-
         /* Check whether the otuput memory needs to be allocated */
         if (file_load_context->file_buffer == nullptr) {
 
@@ -66,21 +119,68 @@ namespace awn::res {
         RESULT_RETURN_UNLESS(file_size <= file_load_context->file_size, ResultInvalidFileBufferSize);
 
         /* Calculate read div */
-        const u32    read_clamp     = (file_load_context->read_div == 0) ? file_size : file_load_context->read_div;
+        const size_t read_div      = (file_load_context->read_div == 0) ? file_size : file_load_context->read_div;
+        const size_t read_clamp    = (cMaxLoadReadSize < read_div) ? cMaxLoadReadSize : read_div;
+        const size_t read_count    = (read_clamp == 0) ? 0 : (file_size + read_clamp - 1) / read_clamp;
+        const u32    request_count = (cMaxLoadReadDepth < read_count) ? cMaxLoadReadDepth : static_cast<u32>(read_count);
 
-        /* First read */
-        size_t file_offset = 0;
-        const Result read_result = this->ReadFile(file_load_context->file_buffer, std::addressof(file_offset), std::addressof(handle), read_clamp, file_offset);
-        RESULT_RETURN_UNLESS(read_result == ResultSuccess, read_result);
+        /* Setup read requests, waiting on any reads left in flight on exit */
+        AsyncReadRequest read_request_array[cMaxLoadReadDepth];
+        for (u32 i = 0; i < request_count; ++i) {
+            read_request_array[i].SetDefaults();
+        }
+        ON_SCOPE_EXIT {
+            for (u32 i = 0; i < request_count; ++i) {
+                if (read_request_array[i].is_pending == true) {
+                    this->WaitReadFileAsync(std::addressof(read_request_array[i]));
+                }
+                read_request_array[i].Finalize();
+            }
+        };
 
-        /* Stream read */
+        /* Stream read, keeping up to the request count of reads in flight */
+        size_t file_offset    = 0;
+        size_t submit_offset  = 0;
+        u32    submit_index   = 0;
+        u32    complete_index = 0;
+        u32    in_flight      = 0;
         while (file_offset < file_size) {
 
-            /* Read next chunk */
-            size_t size_read = 0;
-            const Result read_loop_result = this->ReadFile(reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(file_load_context->file_buffer) + file_offset), std::addressof(size_read), std::addressof(handle), read_clamp, file_offset);
-            file_offset += size_read;
-            RESULT_RETURN_UNLESS(read_loop_result == ResultSuccess, read_loop_result);
+            /* Fill the read queue */
+            while (in_flight < request_count && submit_offset < file_size) {
+
+                const size_t      size_left    = file_size - submit_offset;
+                AsyncReadRequest *read_request = std::addressof(read_request_array[submit_index]);
+                read_request->read_buffer      = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(file_load_context->file_buffer) + submit_offset);
+                read_request->file_handle      = std::addressof(handle);
+                read_request->read_size        = (read_clamp < size_left) ? read_clamp : size_left;
+                read_request->file_offset      = submit_offset;
+
+                const Result submit_result = this->SubmitReadFileAsync(read_request);
+                RESULT_RETURN_UNLESS(submit_result == ResultSuccess, submit_result);
+
+                submit_offset += read_request->read_size;
+                submit_index   = (submit_index + 1 == request_count) ? 0 : submit_index + 1;
+                ++in_flight;
+            }
+
+            /* Complete oldest read */
+            AsyncReadRequest *read_request = std::addressof(read_request_array[complete_index]);
+            const Result wait_result = this->WaitReadFileAsync(read_request);
+            complete_index = (complete_index + 1 == request_count) ? 0 : complete_index + 1;
+            --in_flight;
+            RESULT_RETURN_UNLESS(wait_result == ResultSuccess,                          wait_result);
+            RESULT_RETURN_UNLESS(read_request->out_read_size == read_request->read_size, ResultIncompleteRead);
+
+            file_offset += read_request->out_read_size;
+        }
+
+        /* Decrypt and check crc32b */
+        size_t       plain_size   = 0;
+        const Result check_result = DecryptAndCheckLoadedFile(std::addressof(plain_size), file_load_context, file_load_context->file_buffer, file_size);
+        RESULT_RETURN_UNLESS(check_result == ResultSuccess, check_result);
+        if (file_load_context->out_is_file_memory_allocated == true) {
+            file_load_context->file_size = plain_size;
         }
 
         /* Cancel alloc error for success */
@@ -89,6 +189,27 @@ namespace awn::res {
         RESULT_RETURN_SUCCESS;
     }
 
+    Result FileDeviceBase::SubmitReadFileAsyncImpl(AsyncReadRequest *read_request) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(read_request != nullptr, ResultNullAsyncReadRequest);
+
+        /* Devices without an asynchronous backend complete the read on submission */
+        read_request->out_read_size = 0;
+        read_request->is_pending    = false;
+        read_request->out_result    = this->ReadFile(read_request->read_buffer, std::addressof(read_request->out_read_size), read_request->file_handle, read_request->read_size, read_request->file_offset);
+
+        return read_request->out_result;
+    }
+
+    Result FileDeviceBase::CompleteReadFileAsyncImpl(AsyncReadRequest *read_request, [[maybe_unused]] bool is_wait) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(read_request != nullptr, ResultNullAsyncReadRequest);
+
+        return read_request->out_result;
+    }
+
     Result FileDeviceBase::SaveFileImpl(const char *path, FileSaveInfo *file_save_info) {
 
         /* Integrity checks */
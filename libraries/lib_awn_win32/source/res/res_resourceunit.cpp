@@ -440,14 +440,19 @@ namespace awn::res {
         /* TODO; Fallback on failure */
         RESULT_ABORT_UNLESS(result);
 
+        /* A resource mapped from an archive references the archive's memory */
+        const bool is_archive_mapped = (m_resource != nullptr) && (m_resource->IsFileMapped() == true) && (ArchiveFileDevice::CheckRuntimeTypeInfoStatic(m_file_device) == true);
+
         /* Remove default device */
         if (og_device == nullptr) {
             m_file_device = nullptr;
         }
 
-        /* Finalize archive binder */
-        m_archive_resource = nullptr;
-        m_archive_binder.Finalize();
+        /* Finalize archive binder, holding it until free if the archive is referenced */
+        if (is_archive_mapped == false) {
+            m_archive_resource = nullptr;
+            m_archive_binder.Finalize();
+        }
 
         /* Check if no resource or is not initializable */
         if (m_resource == nullptr || m_resource->IsRequireInitializeOnCreate() == false) {
@@ -672,7 +677,11 @@ namespace awn::res {
         /* Setup load context */
         ResourceLoadContext load_context = {
             .file_load_context = {                
-                .file_heap = (ArchiveFileDevice::CheckRuntimeTypeInfoStatic(m_file_device) == true) ? nullptr : m_resource_heap,
+                .file_heap       = (ArchiveFileDevice::CheckRuntimeTypeInfoStatic(m_file_device) == true) ? nullptr : m_resource_heap,
+                .is_map_file     = (m_is_map_file == true),
+                .nisasyst_path   = (m_is_nisasyst_encrypted == true) ? file_path : nullptr,
+                .is_check_crc32b = (m_is_check_crc32b == true),
+                .expected_crc32b = m_expected_crc32b,
             },
             .file_device      = m_file_device,
             .resource_factory = m_resource_factory,
@@ -900,6 +909,7 @@ namespace awn::res {
         m_deferred_adjust_count[1]  = 0;
         m_resource_initialize_guard = 0;
         m_state                     = 0;
+        m_load_option_state         = 0;
 
         /* Set manager */
         m_resource_unit_manager     = unit_info->resource_unit_manager;
@@ -945,6 +955,16 @@ namespace awn::res {
         /* Set is transient */
         m_is_transient_on_load = async_resource_load_info->is_transient;
 
+        /* Set is map file */
+        m_is_map_file = async_resource_load_info->is_map_file;
+
+        /* Set nisasyst encryption, the key is generated from the loaded path */
+        m_is_nisasyst_encrypted = async_resource_load_info->is_nisasyst_encrypted;
+
+        /* Set crc32b check */
+        m_is_check_crc32b = async_resource_load_info->is_check_crc32b;
+        m_expected_crc32b = async_resource_load_info->expected_crc32b;
+
         /* Set heap type */
         m_heap_type = async_resource_load_info->resource_heap_type;
 
@@ -56,12 +56,16 @@ namespace awn::res {
         const Result format_result = this->FormatPath(std::addressof(formatted_path), path);
         RESULT_RETURN_UNLESS(format_result == ResultSuccess, format_result);
 
+        /* Read only handles are opened for overlapped io so many reads may be in flight */
+        const u32 overlapped_flag = (write_rights == 0) ? FILE_FLAG_OVERLAPPED : 0;
+
         /* Open file */
-        out_file_handle->handle = ::CreateFile(formatted_path.GetString(), access_rights, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        out_file_handle->handle = ::CreateFile(formatted_path.GetString(), access_rights, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | overlapped_flag, nullptr);
         if (out_file_handle->handle == INVALID_HANDLE_VALUE) {
             return ConvertWin32ErrorToResult();
         }
-        out_file_handle->open_mode = static_cast<u32>(open_mode);
+        out_file_handle->file_device = this;
+        out_file_handle->open_mode   = static_cast<u32>(open_mode);
 
         /* Get file size */
         RESULT_RETURN_UNLESS(::GetFileSizeEx(out_file_handle->handle, reinterpret_cast<LARGE_INTEGER*>(std::addressof(out_file_handle->file_size))) == true, ResultFileSizeRetrievalFailed);
@@ -95,38 +99,171 @@ namespace awn::res {
         /* Integrity checks */
         RESULT_RETURN_UNLESS(file_handle != nullptr,                                                             ResultNullFileHandle);
         RESULT_RETURN_UNLESS(file_handle->handle != nullptr && file_handle->handle != INVALID_HANDLE_VALUE,      ResultInvalidFileHandle);
-        RESULT_RETURN_UNLESS(file_handle->file_device != this,                                                   ResultInvalidFileHandle);
+        RESULT_RETURN_UNLESS(file_handle->file_device == this,                                                   ResultInvalidFileHandle);
         RESULT_RETURN_UNLESS((static_cast<u32>(file_handle->open_mode) & static_cast<u32>(OpenMode::Read)) != 0, ResultInvalidOpenMode);
         RESULT_RETURN_UNLESS(file_offset < file_handle->file_size,                                               ResultInvalidFileOffset);
 
-        /* Set file location */
-        LARGE_INTEGER offset = {
-            .QuadPart = static_cast<s64>(file_offset),
+        /* Setup a positional read request */
+        AsyncReadRequest read_request = {};
+        read_request.SetDefaults();
+        ON_SCOPE_EXIT {
+            read_request.Finalize();
         };
-        u32 set_result = ::SetFilePointerEx(file_handle->handle, offset, nullptr, FILE_BEGIN);
-        if (set_result == 0) {
-            return ConvertWin32ErrorToResult();
-        }
 
         /* Read File */
-        u32       read_clamp = (0xffff'ffff < read_size) ? 0xffff'ffff : static_cast<u32>(read_size);
-        u32       size_read  = 0;
-        size_t    read_iter  = 0;
+        size_t read_iter = 0;
         ON_SCOPE_EXIT {
             if (out_read_size != nullptr) {
                 *out_read_size = read_iter;
             }
         };
         do {
-            const bool read_result = ::ReadFile(file_handle->handle, read_buffer, read_clamp, reinterpret_cast<long unsigned int*>(std::addressof(size_read)), nullptr);
-            read_iter += size_read;
-            if (read_result == false) {
+            const size_t size_left = read_size - read_iter;
+            read_request.read_buffer = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(read_buffer) + read_iter);
+            read_request.file_handle = file_handle;
+            read_request.read_size   = (0xffff'ffff < size_left) ? 0xffff'ffff : size_left;
+            read_request.file_offset = file_offset + read_iter;
+
+            const Result submit_result = this->SubmitReadFileAsyncImpl(std::addressof(read_request));
+            RESULT_RETURN_UNLESS(submit_result == ResultSuccess, submit_result);
+            const Result wait_result = this->CompleteReadFileAsyncImpl(std::addressof(read_request), true);
+            RESULT_RETURN_UNLESS(wait_result == ResultSuccess, wait_result);
+
+            read_iter += read_request.out_read_size;
+        } while (read_iter != read_size && read_request.out_read_size == read_request.read_size);
+
+        RESULT_RETURN_SUCCESS;
+    }
+
+    Result SystemFileDevice::SubmitReadFileAsyncImpl(AsyncReadRequest *read_request) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(read_request != nullptr,                                                            ResultNullAsyncReadRequest);
+        FileHandle *file_handle = read_request->file_handle;
+        RESULT_RETURN_UNLESS(file_handle != nullptr,                                                             ResultNullFileHandle);
+        RESULT_RETURN_UNLESS(file_handle->handle != nullptr && file_handle->handle != INVALID_HANDLE_VALUE,      ResultInvalidFileHandle);
+        RESULT_RETURN_UNLESS(file_handle->file_device == this,                                                   ResultInvalidFileHandle);
+        RESULT_RETURN_UNLESS((static_cast<u32>(file_handle->open_mode) & static_cast<u32>(OpenMode::Read)) != 0, ResultInvalidOpenMode);
+        RESULT_RETURN_UNLESS(read_request->file_offset < file_handle->file_size,                                 ResultInvalidFileOffset);
+        RESULT_RETURN_UNLESS(read_request->read_size <= 0xffff'ffff,                                             ResultInvalidSize);
+        RESULT_RETURN_UNLESS(read_request->is_pending == false,                                                  ResultAsyncReadPending);
+
+        /* Create the completion event on first use */
+        if (read_request->overlapped.hEvent == nullptr) {
+            read_request->overlapped.hEvent = ::CreateEvent(nullptr, true, false, nullptr);
+            if (read_request->overlapped.hEvent == nullptr) {
                 return ConvertWin32ErrorToResult();
             }
-            if ((read_size - read_iter) < read_clamp) {
-                read_clamp = (read_size - read_iter);
+        }
+
+        /* Set file location */
+        read_request->overlapped.Internal     = 0;
+        read_request->overlapped.InternalHigh = 0;
+        read_request->overlapped.Offset       = static_cast<u32>(read_request->file_offset);
+        read_request->overlapped.OffsetHigh   = static_cast<u32>(read_request->file_offset >> 0x20);
+        read_request->out_read_size           = 0;
+        read_request->out_result              = ResultSuccess;
+
+        /* Submit read */
+        const bool read_result = ::ReadFile(file_handle->handle, read_request->read_buffer, static_cast<u32>(read_request->read_size), nullptr, std::addressof(read_request->overlapped));
+        if (read_result == false) {
+            const u32 last_error = ::GetLastError();
+            if (last_error == ERROR_HANDLE_EOF) { RESULT_RETURN_SUCCESS; }
+            if (last_error != ERROR_IO_PENDING) {
+                read_request->out_result = ConvertWin32ErrorToResult();
+                return read_request->out_result;
             }
-        } while (read_iter != read_size && size_read == read_clamp);
+        }
+
+        /* Completion is resolved through the overlapped result even if the read finished synchronously */
+        read_request->is_pending = true;
+
+        RESULT_RETURN_SUCCESS;
+    }
+
+    Result SystemFileDevice::CompleteReadFileAsyncImpl(AsyncReadRequest *read_request, bool is_wait) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(read_request != nullptr, ResultNullAsyncReadRequest);
+
+        /* Nothing to do if the read has already completed */
+        if (read_request->is_pending == false) { return read_request->out_result; }
+
+        /* Query overlapped result */
+        long unsigned int size_read = 0;
+        const bool is_complete = ::GetOverlappedResult(read_request->file_handle->handle, std::addressof(read_request->overlapped), std::addressof(size_read), is_wait);
+        if (is_complete == false) {
+            const u32 last_error = ::GetLastError();
+            if (last_error == ERROR_IO_INCOMPLETE) { return ResultAsyncReadPending; }
+            read_request->out_result = (last_error == ERROR_HANDLE_EOF) ? ResultSuccess : ConvertWin32ErrorToResult();
+        }
+
+        /* Complete read */
+        read_request->out_read_size = size_read;
+        read_request->is_pending    = false;
+
+        return read_request->out_result;
+    }
+
+    Result SystemFileDevice::MapFileImpl(FileMapping *out_file_mapping, const char *path) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(out_file_mapping != nullptr, ResultNullFileHandle);
+        RESULT_RETURN_UNLESS(path != nullptr,             ResultNullPath);
+
+        /* Format path */
+        MaxPathString formatted_path;
+        const Result format_result = this->FormatPath(std::addressof(formatted_path), path);
+        RESULT_RETURN_UNLESS(format_result == ResultSuccess, format_result);
+
+        /* Open file, the mapping holds its own reference to the file so the handle is closed on exit */
+        HANDLE file_handle = ::CreateFile(formatted_path.GetString(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE) {
+            return ConvertWin32ErrorToResult();
+        }
+        ON_SCOPE_EXIT {
+            ::CloseHandle(file_handle);
+        };
+
+        /* Empty files can not be mapped */
+        size_t file_size = 0;
+        RESULT_RETURN_UNLESS(::GetFileSizeEx(file_handle, reinterpret_cast<LARGE_INTEGER*>(std::addressof(file_size))) == true, ResultFileSizeRetrievalFailed);
+        RESULT_RETURN_IF(file_size == 0, ResultFileMappingUnsupported);
+
+        /* Create a copy-on-write mapping, resources that relocate or patch their file in place get private pages and the file is never written */
+        HANDLE mapping_handle = ::CreateFileMapping(file_handle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        RESULT_RETURN_IF(mapping_handle == nullptr, ResultFailedToMapFile);
+        auto mapping_guard = SCOPE_GUARD {
+            ::CloseHandle(mapping_handle);
+        };
+
+        /* Map a view of the whole file */
+        void *mapped_address = ::MapViewOfFile(mapping_handle, FILE_MAP_COPY, 0, 0, 0);
+        RESULT_RETURN_IF(mapped_address == nullptr, ResultFailedToMapFile);
+        mapping_guard.Cancel();
+
+        /* Set output mapping */
+        out_file_mapping->mapping_handle = mapping_handle;
+        out_file_mapping->file_device    = this;
+        out_file_mapping->mapped_address = mapped_address;
+        out_file_mapping->mapped_size    = file_size;
+
+        RESULT_RETURN_SUCCESS;
+    }
+
+    Result SystemFileDevice::UnmapFileImpl(FileMapping *file_mapping) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(file_mapping != nullptr,                 ResultNullFileHandle);
+        RESULT_RETURN_UNLESS(file_mapping->file_device == this,       ResultInvalidFileHandle);
+        RESULT_RETURN_UNLESS(file_mapping->mapping_handle != nullptr, ResultInvalidFileHandle);
+
+        /* Unmap view and release mapping */
+        const bool unmap_result = ::UnmapViewOfFile(file_mapping->mapped_address);
+        const bool close_result = ::CloseHandle(file_mapping->mapping_handle);
+        if (unmap_result == false || close_result == false) {
+            return ConvertWin32ErrorToResult();
+        }
 
         RESULT_RETURN_SUCCESS;
     }
@@ -0,0 +1,236 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <awn.hpp>
+
+namespace awn::res {
+
+    void Yaz0Decompressor::Initialize(mem::Heap *heap, u32 read_depth) {
+
+        /* Integrity checks */
+        VP_ASSERT(1 < read_depth && read_depth <= cMaxReadDepth);
+        m_read_depth = read_depth;
+
+        /* Allocate read ring */
+        m_work_memory = ::operator new(cReadSize * read_depth, heap, 0x20);
+        VP_ASSERT(m_work_memory != nullptr);
+
+        return;
+    }
+
+    void Yaz0Decompressor::Finalize() {
+        if (m_work_memory != nullptr) {
+            ::operator delete(m_work_memory);
+            m_work_memory = nullptr;
+        }
+    }
+
+    Result Yaz0Decompressor::LoadDecompressFile(size_t *out_size, s32 *out_alignment, const char *path, FileLoadContext *file_load_context, FileDeviceBase *file_device) {
+
+        /* Integrity checks */
+        RESULT_RETURN_IF(file_load_context->file_buffer != nullptr && file_load_context->file_size == 0, ResultInvalidFileBufferSize);
+        RESULT_RETURN_IF(file_load_context->read_div != 0,                                               ResultInvalidReadDivAlignment);
+
+        /* Declare a file handle closed on exit */
+        FileHandle handle = {};
+        ON_SCOPE_EXIT {
+            RESULT_ABORT_UNLESS(handle.Close());
+        };
+
+        /* Open file handle */
+        if (file_device == nullptr) {
+
+            /* Lookup file device */
+            MaxDriveString drive;
+            vp::util::GetDrive(std::addressof(drive), path);
+            RESULT_RETURN_UNLESS(0 < drive.GetLength(), ResultNullFileDevice);
+
+            file_device = FileDeviceManager::GetInstance()->GetFileDeviceByDrive(drive.GetString());
+            RESULT_RETURN_UNLESS(file_device != nullptr, ResultNullFileDevice);
+
+            /* Open file */
+            MaxPathString path_no_drive;
+            vp::util::GetPathWithoutDrive(std::addressof(path_no_drive), path);
+
+            const Result open_result = file_device->OpenFile(std::addressof(handle), path_no_drive.GetString(), OpenMode::Read);
+            RESULT_RETURN_UNLESS(open_result == ResultSuccess, open_result);
+
+        } else {
+            /* Open file */
+            const Result open_result = file_device->OpenFile(std::addressof(handle), path, OpenMode::Read);
+            RESULT_RETURN_UNLESS(open_result == ResultSuccess, open_result);
+        }
+
+        /* Get file size */
+        size_t       file_size   = 0;
+        const Result size_result = file_device->GetFileSize(std::addressof(file_size), std::addressof(handle));
+        RESULT_RETURN_UNLESS(size_result == ResultSuccess, size_result);
+        RESULT_RETURN_UNLESS(vp::codec::cYaz0HeaderSize <= file_size, ResultInvalidYaz0Stream);
+
+        /* Setup ring of read requests, waiting on any reads left in flight on exit */
+        const u32        read_depth = m_read_depth;
+        const u32        read_count = static_cast<u32>((file_size + cReadSize - 1) / cReadSize);
+        AsyncReadRequest read_request_array[cMaxReadDepth];
+        for (u32 i = 0; i < read_depth; ++i) {
+            read_request_array[i].SetDefaults();
+        }
+        ON_SCOPE_EXIT {
+            for (u32 i = 0; i < read_depth; ++i) {
+                if (read_request_array[i].is_pending == true) {
+                    file_device->WaitReadFileAsync(std::addressof(read_request_array[i]));
+                }
+                read_request_array[i].Finalize();
+            }
+        };
+
+        /* Submit reads into every free ring buffer */
+        u32  submit_count = 0;
+        auto submit_reads = [&](u32 complete_count) -> Result {
+            while (submit_count < read_count && (submit_count - complete_count) < read_depth) {
+
+                const size_t      submit_offset = static_cast<size_t>(submit_count) * cReadSize;
+                const size_t      size_left     = file_size - submit_offset;
+                const u32         ring_index    = submit_count % read_depth;
+                AsyncReadRequest *read_request  = std::addressof(read_request_array[ring_index]);
+                read_request->read_buffer       = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(m_work_memory) + cReadSize * ring_index);
+                read_request->file_handle       = std::addressof(handle);
+                read_request->read_size         = (cReadSize < size_left) ? cReadSize : size_left;
+                read_request->file_offset       = submit_offset;
+
+                const Result submit_result = file_device->SubmitReadFileAsync(read_request);
+                RESULT_RETURN_UNLESS(submit_result == ResultSuccess, submit_result);
+
+                ++submit_count;
+            }
+            RESULT_RETURN_SUCCESS;
+        };
+
+        /* Complete the first read for the header */
+        const Result first_submit_result = submit_reads(0);
+        RESULT_RETURN_UNLESS(first_submit_result == ResultSuccess, first_submit_result);
+
+        AsyncReadRequest *first_request     = std::addressof(read_request_array[0]);
+        const Result      first_wait_result = file_device->WaitReadFileAsync(first_request);
+        RESULT_RETURN_UNLESS(first_wait_result == ResultSuccess,                       first_wait_result);
+        RESULT_RETURN_UNLESS(first_request->out_read_size == first_request->read_size, ResultIncompleteRead);
+
+        /* Setup decryption of nisasyst files, decrypting each read in place as it completes */
+        vp::codec::NisasystStreamContext  decrypt_context_storage = {};
+        vp::codec::NisasystStreamContext *decrypt_context         = nullptr;
+        size_t                            first_size              = first_request->out_read_size;
+        if (file_load_context->nisasyst_path != nullptr) {
+            RESULT_RETURN_UNLESS(sizeof(vp::codec::cNisasystMagic) <= file_size,                                                        ResultInvalidNisasystFile);
+            RESULT_RETURN_UNLESS(1 < read_count || vp::codec::IsNisasystEncrypted(m_work_memory, static_cast<u32>(first_size)) == true, ResultInvalidNisasystFile);
+
+            decrypt_context = std::addressof(decrypt_context_storage);
+            vp::codec::InitializeNisasystStreamContext(decrypt_context, file_size, file_load_context->nisasyst_path);
+            first_size = vp::codec::StreamDecryptNisasyst(m_work_memory, first_size, decrypt_context);
+            RESULT_RETURN_UNLESS(vp::codec::cYaz0HeaderSize <= first_size, ResultInvalidYaz0Stream);
+        }
+
+        /* Get decompressed size */
+        size_t       decomp_size        = 0;
+        const Result decomp_size_result = vp::codec::GetDecompressedSizeYaz0(std::addressof(decomp_size), m_work_memory, first_size);
+        RESULT_RETURN_UNLESS(decomp_size_result == ResultSuccess, decomp_size_result);
+
+        /* Align alignment, respecting the alignment recorded in the header */
+        const vp::res::ResSzs *szs              = reinterpret_cast<const vp::res::ResSzs*>(m_work_memory);
+        const s32              szs_alignment    = static_cast<s32>(szs->GetAlignment());
+        s32                    output_alignment = (0x20 < file_load_context->file_alignment) ? file_load_context->file_alignment : FileDeviceBase::cMinimumFileAlignment;
+        if (output_alignment < szs_alignment && (szs_alignment & (szs_alignment - 1)) == 0) {
+            output_alignment = szs_alignment;
+        }
+
+        /* Check whether the otuput memory needs to be allocated */
+        if (file_load_context->file_buffer == nullptr) {
+
+            /* Allocate file memory */
+            file_load_context->file_buffer = ::operator new(decomp_size, file_load_context->file_heap, output_alignment);
+            RESULT_RETURN_IF(file_load_context->file_buffer == nullptr, ResultFailedToAllocateFileMemory);
+
+            /* Set output file sizes */
+            file_load_context->file_size                    = decomp_size;
+            file_load_context->file_alignment               = output_alignment;
+            file_load_context->out_is_file_memory_allocated = true;
+        } else {
+            RESULT_RETURN_UNLESS(decomp_size <= file_load_context->file_size, ResultOutputBufferTooSmall);
+        }
+
+        /* Handle file allocation error */
+        auto error_after_alloc_guard = SCOPE_GUARD {
+            if (file_load_context->out_is_file_memory_allocated == true) {
+                ::operator delete(file_load_context->file_buffer);
+                file_load_context->file_buffer = nullptr;
+            }
+        };
+
+        /* Single load */
+        if (read_count == 1) {
+            const Result decomp_result = vp::codec::DecompressYaz0(nullptr, file_load_context->file_buffer, decomp_size, m_work_memory, first_size);
+            RESULT_RETURN_UNLESS(decomp_result == ResultSuccess, decomp_result);
+        } else {
+
+            /* Setup stream context */
+            vp::codec::Yaz0StreamContext stream_context = {
+                .state       = vp::codec::Yaz0StreamContext::State::Begin,
+                .output      = file_load_context->file_buffer,
+                .output_size = decomp_size,
+            };
+
+            /* Decode each read in order while the reads ahead stay in flight */
+            for (u32 complete_count = 0; complete_count < read_count; ++complete_count) {
+
+                /* Complete the oldest read */
+                AsyncReadRequest *read_request = std::addressof(read_request_array[complete_count % read_depth]);
+                size_t            read_size    = first_size;
+                if (complete_count != 0) {
+                    const Result wait_result = file_device->WaitReadFileAsync(read_request);
+                    RESULT_RETURN_UNLESS(wait_result == ResultSuccess,                           wait_result);
+                    RESULT_RETURN_UNLESS(read_request->out_read_size == read_request->read_size, ResultIncompleteRead);
+
+                    /* Decrypt in place */
+                    read_size = read_request->out_read_size;
+                    if (decrypt_context != nullptr) {
+                        read_size = vp::codec::StreamDecryptNisasyst(read_request->read_buffer, read_size, decrypt_context);
+                    }
+                }
+
+                /* Stream decompress */
+                const size_t expected = vp::codec::StreamDecompressYaz0(read_request->read_buffer, read_size, std::addressof(stream_context));
+                RESULT_RETURN_IF(expected == vp::codec::Yaz0StreamContext::cInvalidStreamState, ResultStreamDecompressionError);
+                if (stream_context.state == vp::codec::Yaz0StreamContext::State::Finished) { break; }
+
+                /* Refill the ring buffer just released */
+                const Result submit_result = submit_reads(complete_count + 1);
+                RESULT_RETURN_UNLESS(submit_result == ResultSuccess, submit_result);
+            }
+            RESULT_RETURN_UNLESS(stream_context.state == vp::codec::Yaz0StreamContext::State::Finished, ResultStreamDecompressionError);
+        }
+
+        /* Check crc32b */
+        RESULT_RETURN_UNLESS(file_load_context->is_check_crc32b == false || vp::util::HashDataCrc32b(file_load_context->file_buffer, decomp_size) == file_load_context->expected_crc32b, ResultCrc32bMismatch);
+
+        error_after_alloc_guard.Cancel();
+
+        if (out_size != nullptr) {
+            *out_size = decomp_size;
+        }
+        if (out_alignment != nullptr) {
+            *out_alignment = output_alignment;
+        }
+
+        RESULT_RETURN_SUCCESS;
+    }
+}
@@ -17,50 +17,144 @@
 
 namespace awn::res {
 
-    ZstdDecompressor::DecompressorThread::DecompressorThread(mem::Heap *heap) : ServiceThread("ZstdDecompressorThread", heap, sys::ThreadRunMode::WaitForMessage, 0x7fff'ffff'ffff'ffff, 0x20, 0x4000, sys::cPriorityNormal), m_current_stream_context(), m_decompress_finish_event(), m_stream_finish_event() {
-        m_decompress_finish_event.Initialize(sys::SignalState::Signaled, sys::ResetMode::Auto);
-        m_stream_finish_event.Initialize(sys::SignalState::Cleared, sys::ResetMode::Manual);
+    namespace {
+
+        struct GrowableOutput {
+            ZSTD_outBuffer  out_buffer;
+            mem::Heap      *heap;
+            s32             alignment;
+            bool            is_growable;
+
+            Result Grow() {
+
+                /* Integrity checks */
+                RESULT_RETURN_UNLESS(is_growable == true, ResultOutputBufferTooSmall);
+
+                /* Double output */
+                const size_t new_size   = out_buffer.size << 1;
+                void        *new_buffer = ::operator new(new_size, heap, alignment);
+                RESULT_RETURN_IF(new_buffer == nullptr, ResultFailedToAllocateFileMemory);
+
+                /* Move output */
+                ::memcpy(new_buffer, out_buffer.dst, out_buffer.pos);
+                ::operator delete(out_buffer.dst);
+                out_buffer.dst  = new_buffer;
+                out_buffer.size = new_size;
+
+                RESULT_RETURN_SUCCESS;
+            }
+        };
+
+        Result StreamDecompressGrowable(size_t *out_hint, ZSTD_DStream *zstd_dstream, GrowableOutput *output, void *stream, size_t stream_size) {
+
+            /* Decompress all input, growing the output when full */
+            ZSTD_inBuffer in_buffer = { .src = stream, .size = stream_size, .pos = 0 };
+            size_t        hint      = *out_hint;
+            while (in_buffer.pos < in_buffer.size || (output->out_buffer.pos == output->out_buffer.size && hint != 0)) {
+                if (output->out_buffer.pos == output->out_buffer.size) {
+                    const Result grow_result = output->Grow();
+                    RESULT_RETURN_UNLESS(grow_result == ResultSuccess, grow_result);
+                }
+                hint = ::ZSTD_decompressStream(zstd_dstream, std::addressof(output->out_buffer), std::addressof(in_buffer));
+                RESULT_RETURN_IF(::ZSTD_isError(hint) == true, ResultZstdDecompressionFailed);
+            }
+            *out_hint = hint;
+
+            RESULT_RETURN_SUCCESS;
+        }
+
+        Result CheckOutputCrc32b(const FileLoadContext *file_load_context, void *output, size_t output_size, const u32 *streamed_crc32b) {
+
+            /* Skip unless requested */
+            if (file_load_context->is_check_crc32b == false) { RESULT_RETURN_SUCCESS; }
+
+            /* Prefer the crc32b accumulated while streaming */
+            const u32 crc32b = (streamed_crc32b != nullptr) ? *streamed_crc32b : vp::util::HashDataCrc32b(output, output_size);
+            #if defined(VP_DEBUG)
+                VP_ASSERT(streamed_crc32b == nullptr || crc32b == vp::util::HashDataCrc32b(output, output_size));
+            #endif
+            RESULT_RETURN_UNLESS(crc32b == file_load_context->expected_crc32b, ResultCrc32bMismatch);
+
+            RESULT_RETURN_SUCCESS;
+        }
+    }
+
+    ZstdDecompressor::DecompressorThread::DecompressorThread(mem::Heap *heap, ZstdDecompressor *parent_decompressor, u32 read_depth) : ServiceThread("ZstdDecompressorThread", heap, sys::ThreadRunMode::WaitForMessage, 0x7fff'ffff'ffff'ffff, 0x20, 0x4000, sys::cPriorityNormal), m_stream_count(), m_read_depth(read_depth), m_is_error(), m_stream_memory(), m_current_stream_context(), m_current_decrypt_context(), m_current_crc32b(), m_frame_decode_context(), m_parent_decompressor(parent_decompressor), m_stream_finish_event() {
+        m_stream_finish_event.Initialize(sys::SignalState::Cleared, sys::ResetMode::Auto);
     }
     ZstdDecompressor::DecompressorThread::~DecompressorThread() {
-        m_decompress_finish_event.Finalize();
         m_stream_finish_event.Finalize();
     }
 
     void ZstdDecompressor::DecompressorThread::ThreadMain(size_t stream_size) {
 
+        /* Help decode independent frames of another decompressor */
+        if (stream_size == cDecodeFramesMessage) {
+            VP_ASSERT(m_frame_decode_context != nullptr);
+            m_parent_decompressor->DecompressFrames(m_frame_decode_context);
+            vp::util::InterlockedStoreRelease(std::addressof(m_stream_count), m_stream_count + 1);
+            m_stream_finish_event.Signal();
+            return;
+        }
+
         /* Integrity checks */
         VP_ASSERT(m_current_stream_context != nullptr);
 
-        /* Flip output */
-        void *zstd_stream = ((m_stream_count & 1) == 0) ? m_stream_memory : reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(m_stream_memory) + cReadSize);
+        /* Select ring buffer of the next stream in order */
+        void *zstd_stream = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(m_stream_memory) + cReadSize * (m_stream_count % m_read_depth));
 
-        /* Stream decompress zstd*/
-        size_t expected = vp::codec::StreamDecompressZstd(zstd_stream, stream_size, m_current_stream_context);
+        /* Stream decompress zstd, draining any streams queued after completion or error */
+        if (m_current_stream_context->state != vp::codec::ZstdStreamContext::State::Finished && m_current_stream_context->state != vp::codec::ZstdStreamContext::State::Error) {
 
-        /* Increment stream count */
-        ++m_stream_count;
+            /* Decrypt in cache sized stages ahead of decompression for nisasyst files */
+            size_t expected = 0;
+            if (m_current_decrypt_context != nullptr) {
+                expected = vp::codec::StreamDecryptDecompressNisasystZstd(zstd_stream, stream_size, m_current_decrypt_context, m_current_stream_context, m_current_crc32b);
+            } else {
+                const size_t output_offset = m_current_stream_context->output_used;
+                expected = vp::codec::StreamDecompressZstd(zstd_stream, stream_size, m_current_stream_context);
 
-        /* Update error state */
-        m_is_error = (expected == vp::codec::ZstdStreamContext::cInvalidStreamState);
+                /* Accumulate crc32b over the output just produced */
+                if (m_current_crc32b != nullptr && expected != vp::codec::ZstdStreamContext::cInvalidStreamState && output_offset < m_current_stream_context->output_used) {
+                    *m_current_crc32b = vp::util::HashDataCrc32bWithContext(~*m_current_crc32b, reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(m_current_stream_context->output) + output_offset), m_current_stream_context->output_used - output_offset);
+                }
+            }
 
-        /* Signal events */
-        if (m_current_stream_context->state == vp::codec::ZstdStreamContext::State::Finished || m_current_stream_context->state == vp::codec::ZstdStreamContext::State::Error) {
-            m_decompress_finish_event.Signal();
+            /* Update error state */
+            if (expected == vp::codec::ZstdStreamContext::cInvalidStreamState) {
+                vp::util::InterlockedStoreRelease(std::addressof(m_is_error), 1u);
+            }
         }
+
+        /* Release the ring buffer back to the reader */
+        vp::util::InterlockedStoreRelease(std::addressof(m_stream_count), m_stream_count + 1);
         m_stream_finish_event.Signal();
 
         return;
     }
 
-    void ZstdDecompressor::Initialize(mem::Heap *heap) {
+    void ZstdDecompressor::DecompressorThread::WaitForStreamCount(u32 stream_count) {
+        while (this->GetStreamCount() != stream_count) {
+            m_stream_finish_event.Wait();
+        }
+        return;
+    }
+
+    void ZstdDecompressor::Initialize(mem::Heap *heap, u32 read_depth, DecompressorManager *decompressor_manager) {
+
+        /* Integrity checks */
+        VP_ASSERT(1 < read_depth && read_depth <= cMaxReadDepth);
+        m_read_depth           = read_depth;
+        m_heap                 = heap;
+        m_decompressor_manager = decompressor_manager;
 
         /* Allocate decomp system memory */
         const size_t dctx_size  = ::ZSTD_estimateDCtxSize();
-        m_work_memory           = reinterpret_cast<ZSTD_DCtx*>(::operator new(cReadSize * 2 + cLeftoverSize + dctx_size, heap, 0x20));
+        m_work_memory           = reinterpret_cast<ZSTD_DCtx*>(::operator new(cReadSize * read_depth + cLeftoverSize + dctx_size, heap, 0x20));
         VP_ASSERT(m_work_memory != nullptr);
 
         /* Create thread */
-        m_decompressor_thread = new (heap, alignof(DecompressorThread)) DecompressorThread(heap);
+        m_decompressor_thread = new (heap, alignof(DecompressorThread)) DecompressorThread(heap, this, read_depth);
         m_decompressor_thread->StartThread();
 
         /* Clear ZsDic */
@@ -140,16 +234,90 @@ namespace awn::res {
         const Result read_result = file_device->ReadFile(stream, std::addressof(file_offset), std::addressof(handle), cReadSize, file_offset);
         RESULT_RETURN_UNLESS(read_result == ResultSuccess, read_result);                
 
+        /* Setup decryption of nisasyst files */
+        vp::codec::NisasystStreamContext  decrypt_context_storage = {};
+        vp::codec::NisasystStreamContext *decrypt_context         = nullptr;
+        alignas(vp::util::v2sll) u8       header_array[0x20]      = {};
+        void                             *header_stream           = stream;
+        size_t                            header_size             = file_offset;
+        if (file_load_context->nisasyst_path != nullptr) {
+            RESULT_RETURN_UNLESS(file_offset < file_size || vp::codec::IsNisasystEncrypted(stream, static_cast<u32>(file_offset)) == true, ResultInvalidNisasystFile);
+
+            decrypt_context = std::addressof(decrypt_context_storage);
+            vp::codec::InitializeNisasystStreamContext(decrypt_context, file_size, file_load_context->nisasyst_path);
+
+            if (file_offset < cReadSize) {
+
+                /* Decrypt the whole file in place, nothing is left to decrypt downstream */
+                file_offset     = vp::codec::StreamDecryptNisasyst(stream, file_offset, decrypt_context);
+                header_size     = file_offset;
+                decrypt_context = nullptr;
+            } else {
+
+                /* Decrypt a copy of the frame header, the stream is decrypted while decompressing */
+                vp::codec::NisasystStreamContext header_context = decrypt_context_storage;
+                ::memcpy(header_array, stream, sizeof(header_array));
+                header_stream = header_array;
+                header_size   = vp::codec::StreamDecryptNisasyst(header_array, sizeof(header_array), std::addressof(header_context));
+            }
+        }
+
         /* Get frame header */
         ZSTD_frameHeader frame_header = {};
-        const size_t frame_header_result = ::ZSTD_getFrameHeader_advanced(std::addressof(frame_header), stream, file_offset, ZSTD_f_zstd1);
+        const size_t frame_header_result = ::ZSTD_getFrameHeader_advanced(std::addressof(frame_header), header_stream, header_size, ZSTD_f_zstd1);
         RESULT_RETURN_IF(::ZSTD_isError(frame_header_result) == true, ResultZstdError);
 
-        /* Get decompressed size */
-        const size_t decomp_size = frame_header.frameContentSize;
-        RESULT_RETURN_IF(decomp_size == ZSTD_CONTENTSIZE_UNKNOWN || decomp_size == 0, ResultInvalidZstdFrameContentSize);
+        /* Decode seekable files across the decompressor pool, the seek table of an encrypted file is not readable in place */
+        if (cReadSize < file_size && decrypt_context == nullptr) {
+            bool         is_seekable     = false;
+            const Result seekable_result = this->LoadDecompressSeekable(std::addressof(is_seekable), file_load_context, file_device, std::addressof(handle), file_size, output_alignment);
+            if (is_seekable == true) {
+                RESULT_RETURN_UNLESS(seekable_result == ResultSuccess, seekable_result);
+
+                /* Check crc32b */
+                const Result crc32b_result = CheckOutputCrc32b(file_load_context, file_load_context->file_buffer, file_load_context->file_size, nullptr);
+                if (crc32b_result != ResultSuccess && file_load_context->out_is_file_memory_allocated == true) {
+                    ::operator delete(file_load_context->file_buffer);
+                    file_load_context->file_buffer = nullptr;
+                }
+                RESULT_RETURN_UNLESS(crc32b_result == ResultSuccess, crc32b_result);
+
+                if (out_size != nullptr) {
+                    *out_size = file_load_context->file_size;
+                }
+                if (out_alignment != nullptr) {
+                    *out_alignment = output_alignment;
+                }
+
+                RESULT_RETURN_SUCCESS;
+            }
+            RESULT_RETURN_UNLESS(seekable_result == ResultSuccess, seekable_result);
+        }
+
+        /* Get decompressed size, summing every frame if the whole file was read */
+        size_t decomp_size = frame_header.frameContentSize;
+        if (file_offset < cReadSize) {
+            decomp_size = ::ZSTD_findDecompressedSize(stream, file_offset);
+            RESULT_RETURN_IF(decomp_size == ZSTD_CONTENTSIZE_ERROR, ResultZstdError);
+        }
+
+        /* Stream into a growable output if the content size is not known */
+        if (decomp_size == ZSTD_CONTENTSIZE_UNKNOWN) {
+            const Result growable_result = this->LoadDecompressGrowable(file_load_context, file_device, std::addressof(handle), file_size, file_offset, 0, output_alignment, std::addressof(frame_header), decrypt_context);
+            RESULT_RETURN_UNLESS(growable_result == ResultSuccess, growable_result);
+
+            if (out_size != nullptr) {
+                *out_size = file_load_context->file_size;
+            }
+            if (out_alignment != nullptr) {
+                *out_alignment = output_alignment;
+            }
+
+            RESULT_RETURN_SUCCESS;
+        }
+        RESULT_RETURN_IF(decomp_size == 0, ResultInvalidZstdFrameContentSize);
 
-        /* Check whether the otuput memory needs to be allocated */
+        /* Check whether the output memory needs to be allocated */
         if (file_load_context->file_buffer == nullptr) {
 
             /* Allocate file memory */
@@ -161,7 +329,7 @@ namespace awn::res {
             file_load_context->file_alignment               = output_alignment;
             file_load_context->out_is_file_memory_allocated = true;
         } else {
-            RESULT_RETURN_UNLESS(decomp_size < file_load_context->file_size, ResultOutputBufferTooSmall);
+            RESULT_RETURN_UNLESS(decomp_size <= file_load_context->file_size, ResultOutputBufferTooSmall);
         }
 
         /* Handle file allocation error */
@@ -173,8 +341,7 @@ namespace awn::res {
         };
 
         /* Try lookup zsdic */
-        const u32   index      = m_dic_map.TryGetIndexByKey(frame_header.dictID);
-        ZSTD_DDict *dictionary = (index != DictionaryMap::cInvalidEntryIndex) ? m_dic_array[index] : nullptr;
+        ZSTD_DDict *dictionary = this->TryGetZsDic(frame_header.dictID);
 
         /* Initialize decompression context */
         void         *work_memory = m_work_memory;
@@ -189,6 +356,10 @@ namespace awn::res {
             RESULT_RETURN_UNLESS(vp::codec::DecompressZstdWithContext(std::addressof(size_decomped), dctx, file_load_context->file_buffer, decomp_size, stream, file_offset, dictionary) == ResultSuccess, ResultZstdDecompressionFailed);
             RESULT_RETURN_UNLESS(size_decomped == decomp_size, ResultZstdDecompressionFailed);
 
+            /* Check crc32b */
+            const Result crc32b_result = CheckOutputCrc32b(file_load_context, file_load_context->file_buffer, decomp_size, nullptr);
+            RESULT_RETURN_UNLESS(crc32b_result == ResultSuccess, crc32b_result);
+
             error_after_alloc_guard.Cancel();
 
             if (out_size != nullptr) {
@@ -212,50 +383,116 @@ namespace awn::res {
             .zstd_ddict      = dictionary,
         };
 
-        /* Make sure the thread has completed any past file operations */
-        m_decompressor_thread->m_decompress_finish_event.Wait();
+        /* Reset thread stream state, the thread is idle between loads */
+        m_decompressor_thread->m_stream_count           = 0;
+        m_decompressor_thread->m_is_error               = 0;
+        u32 streamed_crc32b = 0;
+        m_decompressor_thread->m_stream_memory           = stream;
+        m_decompressor_thread->m_current_stream_context  = std::addressof(stream_context);
+        m_decompressor_thread->m_current_decrypt_context = decrypt_context;
+        m_decompressor_thread->m_current_crc32b          = (file_load_context->is_check_crc32b == true) ? std::addressof(streamed_crc32b) : nullptr;
+
+        /* Setup ring of read requests */
+        const u32        read_depth = m_read_depth;
+        const u32        read_count = static_cast<u32>((file_size + cReadSize - 1) / cReadSize);
+        AsyncReadRequest read_request_array[cMaxReadDepth];
+        for (u32 i = 0; i < read_depth; ++i) {
+            read_request_array[i].SetDefaults();
+        }
+
+        /* Queue the first read for decompression */
+        u32 send_count   = 1;
+        u32 submit_count = 1;
+        m_decompressor_thread->SendMessage(file_offset);
 
-        /* Set thread stream context */
-        m_decompressor_thread->m_stream_memory          = stream;
-        m_decompressor_thread->m_current_stream_context = std::addressof(stream_context);
+        /* Wait on outstanding reads and all queued streams on exit */
         ON_SCOPE_EXIT {
-            m_decompressor_thread->m_current_stream_context = nullptr;
+            for (u32 i = 0; i < read_depth; ++i) {
+                if (read_request_array[i].is_pending == true) {
+                    file_device->WaitReadFileAsync(std::addressof(read_request_array[i]));
+                }
+                read_request_array[i].Finalize();
+            }
+            m_decompressor_thread->WaitForStreamCount(send_count);
+            m_decompressor_thread->m_current_stream_context  = nullptr;
+            m_decompressor_thread->m_current_decrypt_context = nullptr;
+            m_decompressor_thread->m_current_crc32b          = nullptr;
         };
 
-        /* Streaming decompression */
-        bool   temp_select   = true;
-        size_t size_read     = cReadSize;
-        do {
-            
-            /* Signal decompressor */
-            m_decompressor_thread->m_stream_finish_event.Clear();
-            m_decompressor_thread->SendMessage(size_read);
+        /* Pipelined streaming decompression, the reader runs up to the read depth ahead of the decompressor */
+        while (send_count < read_count) {
+
+            /* Submit reads into every ring buffer released by the decompressor */
+            while (submit_count < read_count && (submit_count - m_decompressor_thread->GetStreamCount()) < read_depth) {
+
+                const size_t      submit_offset = static_cast<size_t>(submit_count) * cReadSize;
+                const size_t      size_left     = file_size - submit_offset;
+                const u32         ring_index    = submit_count % read_depth;
+                AsyncReadRequest *read_request  = std::addressof(read_request_array[ring_index]);
+                read_request->read_buffer       = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(stream) + cReadSize * ring_index);
+                read_request->file_handle       = std::addressof(handle);
+                read_request->read_size         = (cReadSize < size_left) ? cReadSize : size_left;
+                read_request->file_offset       = submit_offset;
+
+                const Result submit_result = file_device->SubmitReadFileAsync(read_request);
+                RESULT_RETURN_UNLESS(submit_result == ResultSuccess, submit_result);
+
+                ++submit_count;
+            }
+
+            /* Wait for the decompressor to release a ring buffer if every read has been queued */
+            if (send_count == submit_count) {
+                m_decompressor_thread->m_stream_finish_event.Wait();
+                RESULT_RETURN_IF(vp::util::InterlockedLoadAcquire(std::addressof(m_decompressor_thread->m_is_error)) != 0, ResultStreamDecompressionError);
+                continue;
+            }
+
+            /* Complete the oldest read */
+            AsyncReadRequest *read_request = std::addressof(read_request_array[send_count % read_depth]);
+            const Result wait_result = file_device->WaitReadFileAsync(read_request);
+            RESULT_RETURN_UNLESS(wait_result == ResultSuccess,                           wait_result);
+            RESULT_RETURN_UNLESS(read_request->out_read_size == read_request->read_size, ResultIncompleteRead);
 
-            /* Select output buffer */
-            void *select_stream  = (temp_select == true) ? reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(stream) + cReadSize) : stream;
-            temp_select  ^= 1;
+            /* Queue for decompression */
+            m_decompressor_thread->SendMessage(read_request->out_read_size);
+            ++send_count;
+        }
+
+        /* Wait for decompression to drain */
+        m_decompressor_thread->WaitForStreamCount(send_count);
+        RESULT_RETURN_IF(vp::util::InterlockedLoadAcquire(std::addressof(m_decompressor_thread->m_is_error)) != 0, ResultStreamDecompressionError);
 
-            /* Stream next block */
-            size_read = 0;
-            const Result read_result = file_device->ReadFile(select_stream, std::addressof(size_read), std::addressof(handle), cReadSize, file_offset);
-            file_offset += size_read;
+        /* A frame finishing before the end of the file means more frames follow, restart into a growable output */
+        if (stream_context.state == vp::codec::ZstdStreamContext::State::Finished) {
+            if (file_load_context->out_is_file_memory_allocated == true) {
+                ::operator delete(file_load_context->file_buffer);
+                file_load_context->file_buffer                  = nullptr;
+                file_load_context->out_is_file_memory_allocated = false;
+            }
+            error_after_alloc_guard.Cancel();
 
-            /* Wait for decompression */
-            m_decompressor_thread->m_stream_finish_event.Wait();
+            /* Restart decryption from the beginning of the file */
+            if (decrypt_context != nullptr) {
+                vp::codec::InitializeNisasystStreamContext(decrypt_context, file_size, file_load_context->nisasyst_path);
+            }
 
-            /* Ensure errors did not occur */
-            RESULT_RETURN_UNLESS(read_result == ResultSuccess, read_result);
-            RESULT_RETURN_IF(m_decompressor_thread->m_is_error == true, ResultStreamDecompressionError);
+            const Result growable_result = this->LoadDecompressGrowable(file_load_context, file_device, std::addressof(handle), file_size, 0, decomp_size << 1, output_alignment, std::addressof(frame_header), decrypt_context);
+            RESULT_RETURN_UNLESS(growable_result == ResultSuccess, growable_result);
 
-        } while (file_offset < file_size);
+            if (out_size != nullptr) {
+                *out_size = file_load_context->file_size;
+            }
+            if (out_alignment != nullptr) {
+                *out_alignment = output_alignment;
+            }
 
-        /* Final decomp */
-        if (0 < stream_context.expected_left) {
-            m_decompressor_thread->m_stream_finish_event.Clear();
-            m_decompressor_thread->SendMessage(size_read);
-            m_decompressor_thread->m_stream_finish_event.Wait();
-            RESULT_RETURN_IF(vp::codec::ZstdStreamContext::cInvalidStreamState == stream_context.expected_left, ResultStreamDecompressionError);
+            RESULT_RETURN_SUCCESS;
         }
+        RESULT_RETURN_UNLESS(stream_context.expected_left == 0, ResultStreamDecompressionError);
+
+        /* Check crc32b accumulated by the decompressor thread */
+        const Result crc32b_result = CheckOutputCrc32b(file_load_context, file_load_context->file_buffer, decomp_size, std::addressof(streamed_crc32b));
+        RESULT_RETURN_UNLESS(crc32b_result == ResultSuccess, crc32b_result);
 
         error_after_alloc_guard.Cancel();
 
@@ -269,6 +506,322 @@ namespace awn::res {
         RESULT_RETURN_SUCCESS;
     }
 
+    Result ZstdDecompressor::LoadDecompressSeekable(bool *out_is_seekable, FileLoadContext *file_load_context, FileDeviceBase *file_device, FileHandle *file_handle, size_t file_size, s32 output_alignment) {
+
+        /* Not seekable unless a valid seek table is found */
+        *out_is_seekable = false;
+        if (file_size < vp::codec::cZstdSkippableHeaderSize + vp::codec::cZstdSeekTableFooterSize) { RESULT_RETURN_SUCCESS; }
+
+        /* Read seek table footer */
+        u8           footer[vp::codec::cZstdSeekTableFooterSize] = {};
+        size_t       footer_read = 0;
+        const Result footer_result = file_device->ReadFile(footer, std::addressof(footer_read), file_handle, sizeof(footer), file_size - sizeof(footer));
+        RESULT_RETURN_UNLESS(footer_result == ResultSuccess, footer_result);
+        RESULT_RETURN_UNLESS(footer_read == sizeof(footer),  ResultIncompleteRead);
+
+        /* Get seek table size, falling back to serial decompression for tables larger than the ring */
+        size_t       seek_table_size = 0;
+        u32          frame_count     = 0;
+        const Result table_result    = vp::codec::GetZstdSeekTableSize(std::addressof(seek_table_size), std::addressof(frame_count), footer, sizeof(footer));
+        if (table_result != ResultSuccess || frame_count == 0 || file_size < seek_table_size || cReadSize * m_read_depth < seek_table_size) { RESULT_RETURN_SUCCESS; }
+
+        /* Read seek table into its own buffer, the ring still holds the first read for a serial fallback */
+        u8 *seek_table = new (m_heap, alignof(u32)) u8[seek_table_size];
+        RESULT_RETURN_IF(seek_table == nullptr, ResultMemoryAllocationFailure);
+        ON_SCOPE_EXIT {
+            delete [] seek_table;
+        };
+        size_t       table_read  = 0;
+        const Result read_result = file_device->ReadFile(seek_table, std::addressof(table_read), file_handle, seek_table_size, file_size - seek_table_size);
+        RESULT_RETURN_UNLESS(read_result == ResultSuccess,   read_result);
+        RESULT_RETURN_UNLESS(table_read == seek_table_size, ResultIncompleteRead);
+
+        /* Parse frame table */
+        vp::codec::ZstdFrameEntry *frame_array = new (m_heap, alignof(vp::codec::ZstdFrameEntry)) vp::codec::ZstdFrameEntry[frame_count];
+        RESULT_RETURN_IF(frame_array == nullptr, ResultMemoryAllocationFailure);
+        ON_SCOPE_EXIT {
+            delete [] frame_array;
+        };
+        size_t       decomp_size  = 0;
+        const Result parse_result = vp::codec::ParseZstdSeekTable(frame_array, frame_count, std::addressof(decomp_size), seek_table, seek_table_size);
+        if (parse_result != ResultSuccess) { RESULT_RETURN_SUCCESS; }
+
+        /* Frames must cover the file up to the seek table */
+        const vp::codec::ZstdFrameEntry *last_frame = std::addressof(frame_array[frame_count - 1]);
+        if (last_frame->compressed_offset + last_frame->compressed_size + seek_table_size != file_size || decomp_size == 0) { RESULT_RETURN_SUCCESS; }
+        *out_is_seekable = true;
+
+        /* Check whether the output memory needs to be allocated */
+        if (file_load_context->file_buffer == nullptr) {
+
+            /* Allocate file memory */
+            file_load_context->file_buffer = ::operator new(decomp_size, file_load_context->file_heap, output_alignment);
+            RESULT_RETURN_IF(file_load_context->file_buffer == nullptr, ResultFailedToAllocateFileMemory);
+
+            /* Set output file sizes */
+            file_load_context->file_size                    = decomp_size;
+            file_load_context->file_alignment               = output_alignment;
+            file_load_context->out_is_file_memory_allocated = true;
+        } else {
+            RESULT_RETURN_UNLESS(decomp_size <= file_load_context->file_size, ResultOutputBufferTooSmall);
+        }
+
+        /* Handle file allocation error */
+        auto error_after_alloc_guard = SCOPE_GUARD {
+            if (file_load_context->out_is_file_memory_allocated == true) {
+                ::operator delete(file_load_context->file_buffer);
+                file_load_context->file_buffer = nullptr;
+            }
+        };
+
+        /* Setup shared frame context */
+        FrameDecodeContext frame_decode_context = {
+            .file_device = file_device,
+            .file_handle = file_handle,
+            .output      = file_load_context->file_buffer,
+            .frame_array = frame_array,
+            .frame_count = frame_count,
+            .next_frame  = 0,
+            .is_error    = 0,
+        };
+
+        /* Borrow idle decompressors from the pool to decode frames in parallel */
+        u32 helper_handle_array[cMaxFrameHelpers] = {};
+        u32 helper_count                          = 0;
+        if (m_decompressor_manager != nullptr) {
+            const u32 max_helpers = (frame_count - 1 < cMaxFrameHelpers) ? frame_count - 1 : cMaxFrameHelpers;
+            for (; helper_count < max_helpers; ++helper_count) {
+
+                /* Try to acquire an idle decompressor */
+                const u32 helper_handle = m_decompressor_manager->TryAllocateDecompressorHandle();
+                if (helper_handle == DecompressorManager::HandleAllocator::cInvalidHandle) { break; }
+                helper_handle_array[helper_count] = helper_handle;
+
+                /* Dispatch frame decode */
+                DecompressorThread *helper_thread     = m_decompressor_manager->GetZstdDecompressor(helper_handle)->m_decompressor_thread;
+                helper_thread->m_stream_count         = 0;
+                helper_thread->m_frame_decode_context = std::addressof(frame_decode_context);
+                helper_thread->SendMessage(cDecodeFramesMessage);
+            }
+        }
+
+        /* Decode frames on this thread */
+        const Result decode_result = this->DecompressFrames(std::addressof(frame_decode_context));
+
+        /* Wait for helpers and return them to the pool */
+        for (u32 i = 0; i < helper_count; ++i) {
+            DecompressorThread *helper_thread = m_decompressor_manager->GetZstdDecompressor(helper_handle_array[i])->m_decompressor_thread;
+            helper_thread->WaitForStreamCount(1);
+            helper_thread->m_frame_decode_context = nullptr;
+            m_decompressor_manager->FreeDecompressorHandle(helper_handle_array[i]);
+        }
+
+        /* Check errors */
+        RESULT_RETURN_UNLESS(decode_result == ResultSuccess,  decode_result);
+        RESULT_RETURN_IF(frame_decode_context.is_error != 0, ResultStreamDecompressionError);
+
+        error_after_alloc_guard.Cancel();
+
+        RESULT_RETURN_SUCCESS;
+    }
+
+    Result ZstdDecompressor::LoadDecompressGrowable(FileLoadContext *file_load_context, FileDeviceBase *file_device, FileHandle *file_handle, size_t file_size, size_t preloaded_size, size_t capacity_hint, s32 output_alignment, const ZSTD_frameHeader *frame_header, vp::codec::NisasystStreamContext *decrypt_context) {
+
+        /* Allocate a stream decompression context sized for the first frame's window */
+        const size_t  dstream_size   = ::ZSTD_estimateDStreamSize(frame_header->windowSize);
+        void         *dstream_memory = ::operator new(dstream_size, m_heap, 0x20);
+        RESULT_RETURN_IF(dstream_memory == nullptr, ResultMemoryAllocationFailure);
+        ON_SCOPE_EXIT {
+            ::operator delete(dstream_memory);
+        };
+        ZSTD_DStream *dstream = ::ZSTD_initStaticDStream(dstream_memory, dstream_size);
+        RESULT_RETURN_IF(dstream == nullptr, ResultZstdError);
+
+        /* Reference zsdic */
+        ZSTD_DDict *dictionary = this->TryGetZsDic(frame_header->dictID);
+        if (dictionary != nullptr) {
+            RESULT_RETURN_IF(::ZSTD_isError(::ZSTD_DCtx_refDDict(dstream, dictionary)) == true, ResultZstdError);
+        }
+
+        /* Setup output, growing only memory that is allocated here */
+        GrowableOutput output = {
+            .out_buffer  = { .dst = file_load_context->file_buffer, .size = file_load_context->file_size, .pos = 0 },
+            .heap        = file_load_context->file_heap,
+            .alignment   = output_alignment,
+            .is_growable = (file_load_context->file_buffer == nullptr),
+        };
+        if (output.is_growable == true) {
+            const size_t min_capacity = (cReadSize < (file_size << 2)) ? (file_size << 2) : cReadSize;
+            output.out_buffer.size    = (min_capacity < capacity_hint) ? capacity_hint : min_capacity;
+            output.out_buffer.dst     = ::operator new(output.out_buffer.size, output.heap, output_alignment);
+            RESULT_RETURN_IF(output.out_buffer.dst == nullptr, ResultFailedToAllocateFileMemory);
+        }
+        auto error_after_alloc_guard = SCOPE_GUARD {
+            if (output.is_growable == true) {
+                ::operator delete(output.out_buffer.dst);
+            }
+        };
+
+        /* Setup ring of read requests, waiting on any reads left in flight on exit */
+        const u32        read_depth = m_read_depth;
+        const u32        read_count = static_cast<u32>((file_size + cReadSize - 1) / cReadSize);
+        const size_t     dctx_size  = ::ZSTD_estimateDCtxSize();
+        void            *stream     = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(m_work_memory) + dctx_size + cLeftoverSize);
+        AsyncReadRequest read_request_array[cMaxReadDepth];
+        for (u32 i = 0; i < read_depth; ++i) {
+            read_request_array[i].SetDefaults();
+        }
+        ON_SCOPE_EXIT {
+            for (u32 i = 0; i < read_depth; ++i) {
+                if (read_request_array[i].is_pending == true) {
+                    file_device->WaitReadFileAsync(std::addressof(read_request_array[i]));
+                }
+                read_request_array[i].Finalize();
+            }
+        };
+
+        /* Decompress the preloaded first read */
+        size_t hint           = 1;
+        u32    complete_count = 0;
+        if (preloaded_size != 0) {
+            const size_t plain_size    = (decrypt_context != nullptr) ? vp::codec::StreamDecryptNisasyst(stream, preloaded_size, decrypt_context) : preloaded_size;
+            const Result decomp_result = StreamDecompressGrowable(std::addressof(hint), dstream, std::addressof(output), stream, plain_size);
+            RESULT_RETURN_UNLESS(decomp_result == ResultSuccess, decomp_result);
+            complete_count = 1;
+        }
+
+        /* Decompress as reads complete, keeping the ring of reads in flight */
+        u32 submit_count = complete_count;
+        while (complete_count < read_count) {
+
+            /* Fill the read ring */
+            while (submit_count < read_count && (submit_count - complete_count) < read_depth) {
+
+                const size_t      submit_offset = static_cast<size_t>(submit_count) * cReadSize;
+                const size_t      size_left     = file_size - submit_offset;
+                const u32         ring_index    = submit_count % read_depth;
+                AsyncReadRequest *read_request  = std::addressof(read_request_array[ring_index]);
+                read_request->read_buffer       = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(stream) + cReadSize * ring_index);
+                read_request->file_handle       = file_handle;
+                read_request->read_size         = (cReadSize < size_left) ? cReadSize : size_left;
+                read_request->file_offset       = submit_offset;
+
+                const Result submit_result = file_device->SubmitReadFileAsync(read_request);
+                RESULT_RETURN_UNLESS(submit_result == ResultSuccess, submit_result);
+
+                ++submit_count;
+            }
+
+            /* Complete oldest read */
+            AsyncReadRequest *read_request = std::addressof(read_request_array[complete_count % read_depth]);
+            const Result wait_result = file_device->WaitReadFileAsync(read_request);
+            RESULT_RETURN_UNLESS(wait_result == ResultSuccess,                           wait_result);
+            RESULT_RETURN_UNLESS(read_request->out_read_size == read_request->read_size, ResultIncompleteRead);
+
+            /* Decrypt and decompress */
+            const size_t plain_size    = (decrypt_context != nullptr) ? vp::codec::StreamDecryptNisasyst(read_request->read_buffer, read_request->out_read_size, decrypt_context) : read_request->out_read_size;
+            const Result decomp_result = StreamDecompressGrowable(std::addressof(hint), dstream, std::addressof(output), read_request->read_buffer, plain_size);
+            RESULT_RETURN_UNLESS(decomp_result == ResultSuccess, decomp_result);
+
+            ++complete_count;
+        }
+
+        /* The last frame must be complete */
+        RESULT_RETURN_UNLESS(hint == 0, ResultStreamDecompressionError);
+
+        /* Check crc32b */
+        const Result crc32b_result = CheckOutputCrc32b(file_load_context, output.out_buffer.dst, output.out_buffer.pos, nullptr);
+        RESULT_RETURN_UNLESS(crc32b_result == ResultSuccess, crc32b_result);
+
+        /* Set output */
+        error_after_alloc_guard.Cancel();
+        if (output.is_growable == true) {
+            file_load_context->file_buffer                  = output.out_buffer.dst;
+            file_load_context->file_size                    = output.out_buffer.pos;
+            file_load_context->file_alignment               = output_alignment;
+            file_load_context->out_is_file_memory_allocated = true;
+        }
+
+        RESULT_RETURN_SUCCESS;
+    }
+
+    Result ZstdDecompressor::DecompressFrames(FrameDecodeContext *frame_decode_context) {
+
+        /* Take frames until all are claimed or another thread fails */
+        for (;;) {
+            if (vp::util::InterlockedLoadAcquire(std::addressof(frame_decode_context->is_error)) != 0) { break; }
+
+            const u32 frame_index = vp::util::InterlockedFetchAdd(std::addressof(frame_decode_context->next_frame), 1u);
+            if (frame_decode_context->frame_count <= frame_index) { break; }
+
+            const Result result = this->DecompressFrame(frame_decode_context, std::addressof(frame_decode_context->frame_array[frame_index]));
+            if (result != ResultSuccess) {
+                vp::util::InterlockedStoreRelease(std::addressof(frame_decode_context->is_error), 1u);
+                return result;
+            }
+        }
+
+        RESULT_RETURN_SUCCESS;
+    }
+
+    Result ZstdDecompressor::DecompressFrame(FrameDecodeContext *frame_decode_context, const vp::codec::ZstdFrameEntry *frame_entry) {
+
+        /* Get work memory */
+        const size_t  dctx_size = ::ZSTD_estimateDCtxSize();
+        ZSTD_DCtx    *dctx      = ::ZSTD_initStaticDCtx(m_work_memory, dctx_size);
+        void         *stream    = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(m_work_memory) + dctx_size + cLeftoverSize);
+        const size_t  ring_size = cReadSize * m_read_depth;
+        void         *output    = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(frame_decode_context->output) + frame_entry->decompressed_offset);
+        VP_ASSERT(dctx != nullptr);
+
+        /* Read frame start */
+        size_t       read_size   = (frame_entry->compressed_size < ring_size) ? frame_entry->compressed_size : ring_size;
+        size_t       size_read   = 0;
+        const Result read_result = frame_decode_context->file_device->ReadFile(stream, std::addressof(size_read), frame_decode_context->file_handle, read_size, frame_entry->compressed_offset);
+        RESULT_RETURN_UNLESS(read_result == ResultSuccess, read_result);
+        RESULT_RETURN_UNLESS(size_read == read_size,       ResultIncompleteRead);
+
+        /* Try lookup zsdic */
+        ZSTD_DDict *dictionary = this->TryGetZsDic(::ZSTD_getDictID_fromFrame(stream, size_read));
+
+        /* Frames fitting the ring decompress in one pass */
+        if (frame_entry->compressed_size <= ring_size) {
+            size_t size_decomped = 0;
+            RESULT_RETURN_UNLESS(vp::codec::DecompressZstdWithContext(std::addressof(size_decomped), dctx, output, frame_entry->decompressed_size, stream, size_read, dictionary) == ResultSuccess, ResultZstdDecompressionFailed);
+            RESULT_RETURN_UNLESS(size_decomped == frame_entry->decompressed_size, ResultZstdDecompressionFailed);
+            RESULT_RETURN_SUCCESS;
+        }
+
+        /* Stream larger frames through the ring */
+        vp::codec::ZstdStreamContext stream_context = {
+            .state           = vp::codec::ZstdStreamContext::State::Begin,
+            .output          = output,
+            .output_size     = frame_entry->decompressed_size,
+            .leftover_stream = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(m_work_memory) + dctx_size),
+            .leftover_size   = cLeftoverSize,
+            .zstd_dctx       = dctx,
+            .zstd_ddict      = dictionary,
+        };
+        size_t frame_offset = size_read;
+        for (;;) {
+            const size_t expected = vp::codec::StreamDecompressZstd(stream, size_read, std::addressof(stream_context));
+            RESULT_RETURN_IF(expected == vp::codec::ZstdStreamContext::cInvalidStreamState, ResultStreamDecompressionError);
+            if (frame_offset == frame_entry->compressed_size) { break; }
+
+            /* Read next part of the frame */
+            const size_t size_left  = frame_entry->compressed_size - frame_offset;
+            read_size               = (size_left < ring_size) ? size_left : ring_size;
+            size_read               = 0;
+            const Result next_result = frame_decode_context->file_device->ReadFile(stream, std::addressof(size_read), frame_decode_context->file_handle, read_size, frame_entry->compressed_offset + frame_offset);
+            RESULT_RETURN_UNLESS(next_result == ResultSuccess, next_result);
+            RESULT_RETURN_UNLESS(size_read == read_size,       ResultIncompleteRead);
+            frame_offset += size_read;
+        }
+        RESULT_RETURN_UNLESS(stream_context.output_used == frame_entry->decompressed_size, ResultStreamDecompressionError);
+
+        RESULT_RETURN_SUCCESS;
+    }
+
     void ZstdDecompressor::RegisterZsDic(ZSTD_DDict *zstd_ddict) {
 
         /* Get dic id */
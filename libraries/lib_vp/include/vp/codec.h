@@ -16,5 +16,6 @@
 #pragma once
 
 #include <vp/codec/codec_aes128cbc.x86.hpp>
-#include <vp/codec/codec_nisasyst.hpp>
 #include <vp/codec/codec_zstd.h>
+#include <vp/codec/codec_nisasyst.hpp>
+#include <vp/codec/codec_yaz0.hpp>
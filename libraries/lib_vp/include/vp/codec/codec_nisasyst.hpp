@@ -29,4 +29,21 @@ namespace vp::codec {
     bool IsNisasystEncrypted(void *file, u32 file_size);
 
 	void DecryptNisasyst(void *in_out_file, u32 file_size, const char *file_path);
+
+    struct NisasystStreamContext {
+        Aes128Context   aes128_context;
+        vp::util::v2sll init_vector;
+        size_t          cipher_size;
+        size_t          cipher_used;
+    };
+
+    constexpr size_t cNisasystStreamStageSize = vp::util::c32KB;
+
+    void InitializeNisasystStreamContext(NisasystStreamContext *out_stream_context, size_t file_size, const char *file_path);
+
+    /* Decrypts a stream in place, every stream but the last must be aes block aligned. Returns the size of plain text excluding the trailing magic */
+    size_t StreamDecryptNisasyst(void *stream, size_t stream_size, NisasystStreamContext *stream_context);
+
+    /* Decrypts and decompresses a stream in cache sized stages, optionally accumulating a crc32b of the output starting from 0 */
+    size_t StreamDecryptDecompressNisasystZstd(void *stream, size_t stream_size, NisasystStreamContext *decrypt_context, ZstdStreamContext *stream_context, u32 *in_out_crc32b = nullptr);
 }
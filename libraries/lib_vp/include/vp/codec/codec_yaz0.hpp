@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::codec {
+
+    constexpr inline size_t cYaz0HeaderSize    = sizeof(vp::res::ResSzs);
+    constexpr inline size_t cYaz0WindowSize    = 0x1000;
+    constexpr inline size_t cYaz0MinMatchSize  = 3;
+    constexpr inline size_t cYaz0MaxMatchSize  = 0x111;
+
+    constexpr ALWAYS_INLINE size_t GetYaz0WorstCaseCompressedSize(size_t decompressed_size) {
+        return cYaz0HeaderSize + decompressed_size + ((decompressed_size + 7) >> 3);
+    }
+
+    Result GetDecompressedSizeYaz0(size_t *out_size, const void *yaz0_stream, size_t yaz0_stream_size);
+
+    Result DecompressYaz0(size_t *out_size, void *output, size_t output_size, const void *yaz0_stream, size_t yaz0_stream_size);
+
+    struct Yaz0StreamContext {
+        enum class State : u32 {
+            Begin,
+            Streaming,
+            Finished,
+            Error,
+        };
+        static constexpr size_t cInvalidStreamState = 0xffff'ffff'ffff'ffff;
+        static constexpr size_t cMaxPendingSize     = cYaz0HeaderSize;
+
+        State   state;
+        void   *output;
+        size_t  output_size;
+        size_t  output_used;
+        size_t  expected_left;
+        u32     group_header;
+        u32     group_bits_left;
+        u32     pending_size;
+        u8      pending_array[cMaxPendingSize];
+    };
+
+    size_t StreamDecompressYaz0(const void *stream, size_t stream_size, Yaz0StreamContext *stream_context);
+}
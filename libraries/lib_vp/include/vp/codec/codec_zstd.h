@@ -48,4 +48,21 @@ namespace vp::codec {
     };
 
     size_t StreamDecompressZstd(void *stream, size_t stream_size, ZstdStreamContext *stream_context);
+
+    constexpr inline u32    cZstdSeekableMagic           = 0x8f92'eab1;
+    constexpr inline u32    cZstdSeekTableSkippableMagic = 0x184d'2a5e;
+    constexpr inline size_t cZstdSkippableHeaderSize     = 8;
+    constexpr inline size_t cZstdSeekTableFooterSize     = 9;
+    constexpr inline u8     cZstdSeekTableChecksumFlag   = (1 << 7);
+    constexpr inline u8     cZstdSeekTableReservedMask   = 0x7c;
+
+    struct ZstdFrameEntry {
+        size_t compressed_offset;
+        size_t compressed_size;
+        size_t decompressed_offset;
+        size_t decompressed_size;
+    };
+
+    Result GetZstdSeekTableSize(size_t *out_seek_table_size, u32 *out_frame_count, const void *seek_table_footer, size_t footer_size);
+    Result ParseZstdSeekTable(ZstdFrameEntry *out_frame_array, u32 frame_count, size_t *out_decompressed_size, const void *seek_table, size_t seek_table_size);
 }
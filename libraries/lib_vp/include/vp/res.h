@@ -45,6 +45,7 @@
     #include <vp/res/res_bfresshape.hpp>
     #include <vp/res/res_bfresmodel.hpp>
     #include <vp/res/res_bfresskeletalanim.hpp>
+    #include <vp/res/res_bfresskeletalpose.hpp>
     #include <vp/res/res_bfresmaterialanim.hpp>
     #include <vp/res/res_bfresbonevisibilityanim.hpp>
     #include <vp/res/res_bfresshapeanim.hpp>
@@ -65,6 +66,8 @@
 #include <vp/res/res_byaml.hpp>
 #include <vp/res/res_byamlstringtableiterator.hpp>
 #include <vp/res/res_byamldictionaryiterator.hpp>
+#include <vp/res/res_byamlkeyindexcache.hpp>
+#include <vp/res/res_byamlschema.hpp>
 #include <vp/res/res_byamliterator.hpp>
 
 /* Reverse engineered Nintendo EPD resource size table format */
@@ -72,6 +72,167 @@ namespace vp::res {
         float frame_data_add;
         float frame_delta;
         u32   reserve3;
+
+        static constexpr float cFixedFrameScale = 1.0f / 32.0f;
+        static constexpr u32   cCursorStepCount = 2;
+
+        constexpr ALWAYS_INLINE float GetKeyFrame(u32 key_index) const {
+            switch (static_cast<BfresAnimCurveFrameDataType>(frame_data_type)) {
+                case BfresAnimCurveFrameDataType::Float: return frame_array_f32[key_index];
+                case BfresAnimCurveFrameDataType::F16:   return static_cast<float>(frame_array_s16[key_index]) * cFixedFrameScale;
+                case BfresAnimCurveFrameDataType::U8:    return static_cast<float>(frame_array_u8[key_index]);
+            }
+            return 0.0f;
+        }
+
+        constexpr ALWAYS_INLINE u32 GetCoefficientCount() const {
+            const BfresAnimCurveCurveType type = static_cast<BfresAnimCurveCurveType>(curve_type);
+            return (type == BfresAnimCurveCurveType::CubicFloat) ? 4 : (type == BfresAnimCurveCurveType::LinearFloat) ? 2 : 1;
+        }
+
+        constexpr ALWAYS_INLINE float GetCoefficient(u32 index) const {
+            switch (static_cast<BfresAnimCurveValueDataType>(value_data_type)) {
+                case BfresAnimCurveValueDataType::Float: return value_array_f32[index];
+                case BfresAnimCurveValueDataType::S16:   return static_cast<float>(value_array_s16[index]);
+                case BfresAnimCurveValueDataType::S8:    return static_cast<float>(value_array_s8[index]);
+            }
+            return 0.0f;
+        }
+
+        constexpr ALWAYS_INLINE s32 GetIntegerValue(u32 index) const {
+            switch (static_cast<BfresAnimCurveValueDataType>(value_data_type)) {
+                case BfresAnimCurveValueDataType::S32: return value_array_s32[index];
+                case BfresAnimCurveValueDataType::S16: return value_array_s16[index];
+                case BfresAnimCurveValueDataType::S8:  return value_array_s8[index];
+            }
+            return 0;
+        }
+
+        /* Quantized values are scaled and offset, relative repeat adds the start to end delta per cycle */
+        constexpr ALWAYS_INLINE float GetValueScale() const {
+            return (static_cast<BfresAnimCurveValueDataType>(value_data_type) == BfresAnimCurveValueDataType::Float) ? 1.0f : frame_data_scale;
+        }
+        constexpr ALWAYS_INLINE float GetValueAdd(s32 cycle) const {
+            const float add = (static_cast<BfresAnimCurveValueDataType>(value_data_type) == BfresAnimCurveValueDataType::Float) ? 0.0f : frame_data_add;
+            return add + static_cast<float>(cycle) * frame_delta;
+        }
+
+        /* Wraps a frame into the key range, outputs the number of cycles wrapped for relative repeat */
+        float WrapFrame(s32 *out_cycle, float frame) const {
+
+            *out_cycle = 0;
+            if (start_key <= frame && frame <= end_key) { return frame; }
+
+            /* Clamp */
+            const float                  length    = end_key - start_key;
+            const BfresAnimCurveWrapMode wrap_mode = static_cast<BfresAnimCurveWrapMode>((frame < start_key) ? pre_wrap_mode : post_wrap_mode);
+            if (wrap_mode == BfresAnimCurveWrapMode::Clamp || length <= 0.0f) { return (frame < start_key) ? start_key : end_key; }
+
+            /* Repeat */
+            const float relative = frame - start_key;
+            const float cycle    = ::floorf(relative / length);
+            float       local    = relative - cycle * length;
+            const s32   cycle_i  = static_cast<s32>(cycle);
+
+            /* Mirror odd cycles */
+            if (wrap_mode == BfresAnimCurveWrapMode::Mirror && (cycle_i & 1) != 0) { local = length - local; }
+
+            *out_cycle = (wrap_mode == BfresAnimCurveWrapMode::RelativeRepeat) ? cycle_i : 0;
+
+            return start_key + local;
+        }
+
+        /* Finds the key segment containing a wrapped frame, the cursor caches the last segment so sequential playback is usually a single compare */
+        u32 FindKeyIndex(float frame, u16 *in_out_cursor) const {
+
+            /* Single key curves have no segments */
+            if (frame_count <= 1) { *in_out_cursor = 0; return 0; }
+
+            /* Step forward from the cached segment */
+            const u32 max_segment = frame_count - 2;
+            u32       segment     = (*in_out_cursor < max_segment) ? *in_out_cursor : max_segment;
+            if (this->GetKeyFrame(segment) <= frame) {
+                for (u32 i = 0; i < cCursorStepCount; ++i) {
+                    if (segment == max_segment || frame < this->GetKeyFrame(segment + 1)) { *in_out_cursor = segment; return segment; }
+                    ++segment;
+                }
+            }
+
+            /* Binary search for the last key at or before frame */
+            u32 lower = 0;
+            u32 upper = max_segment;
+            while (lower < upper) {
+                const u32 middle = (lower + upper + 1) >> 1;
+                if (this->GetKeyFrame(middle) <= frame) {
+                    lower = middle;
+                } else {
+                    upper = middle - 1;
+                }
+            }
+            *in_out_cursor = lower;
+
+            return lower;
+        }
+
+        /* Finds the key at or before a wrapped frame for step and baked curves */
+        u32 FindStepKeyIndex(float frame, u16 *in_out_cursor) const {
+            const u32 segment = this->FindKeyIndex(frame, in_out_cursor);
+            return (1 < frame_count && this->GetKeyFrame(segment + 1) <= frame) ? segment + 1 : segment;
+        }
+
+        constexpr ALWAYS_INLINE float CalculateSegmentRatio(u32 segment, float frame) const {
+            if (frame_count <= 1) { return 0.0f; }
+            const float key0 = this->GetKeyFrame(segment);
+            const float key1 = this->GetKeyFrame(segment + 1);
+            return (key0 < key1) ? (frame - key0) / (key1 - key0) : 0.0f;
+        }
+
+        float EvaluateFloat(float frame, u16 *in_out_cursor) const {
+
+            s32         cycle   = 0;
+            const float wrapped = this->WrapFrame(std::addressof(cycle), frame);
+
+            /* Step through baked values */
+            const BfresAnimCurveCurveType type = static_cast<BfresAnimCurveCurveType>(curve_type);
+            if (type != BfresAnimCurveCurveType::CubicFloat && type != BfresAnimCurveCurveType::LinearFloat) {
+                return this->GetCoefficient(this->FindStepKeyIndex(wrapped, in_out_cursor)) * this->GetValueScale() + this->GetValueAdd(cycle);
+            }
+
+            /* Evaluate hermite polynomial */
+            const u32   segment = this->FindKeyIndex(wrapped, in_out_cursor);
+            const float t       = this->CalculateSegmentRatio(segment, wrapped);
+            const u32   base    = segment * this->GetCoefficientCount();
+            float value = this->GetCoefficient(base) + this->GetCoefficient(base + 1) * t;
+            if (type == BfresAnimCurveCurveType::CubicFloat) {
+                value = value + (this->GetCoefficient(base + 2) + this->GetCoefficient(base + 3) * t) * t * t;
+            }
+
+            return value * this->GetValueScale() + this->GetValueAdd(cycle);
+        }
+
+        s32 EvaluateInteger(float frame, u16 *in_out_cursor) const {
+
+            s32         cycle   = 0;
+            const float wrapped = this->WrapFrame(std::addressof(cycle), frame);
+
+            const s32 value = this->GetIntegerValue(this->FindStepKeyIndex(wrapped, in_out_cursor));
+            if (cycle == 0) { return value; }
+
+            return value + cycle * (this->GetIntegerValue(frame_count - 1) - this->GetIntegerValue(0));
+        }
+
+        bool EvaluateBoolean(float frame, u16 *in_out_cursor) const {
+
+            s32         cycle   = 0;
+            const float wrapped = this->WrapFrame(std::addressof(cycle), frame);
+
+            /* Boolean values are a packed bit array */
+            const u32 index = this->FindStepKeyIndex(wrapped, in_out_cursor);
+            return ((static_cast<u32>(value_array_s32[index >> 5]) >> (index & 0x1f)) & 1) != 0;
+        }
     };
     static_assert(sizeof(ResBfresAnimCurve) == 0x30);
+
+    /* Samples float curves at one frame into out_value_array. Hermite and linear segments are evaluated 8 at a time, key_cursor_array holds a cached segment per curve */
+    void SampleBfresAnimCurveFloatArray(float *out_value_array, const ResBfresAnimCurve *curve_array, u16 *key_cursor_array, u32 curve_count, float frame);
 }
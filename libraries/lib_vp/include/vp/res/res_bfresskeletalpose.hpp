@@ -0,0 +1,177 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::res {
+
+    /* Bone transform channels, curve result offsets are mapped to these through a table */
+    enum class BfresSkeletalPoseChannel : u32 {
+        TranslateX = 0,
+        TranslateY = 1,
+        TranslateZ = 2,
+        RotateX    = 3,
+        RotateY    = 4,
+        RotateZ    = 5,
+        RotateW    = 6,
+        ScaleX     = 7,
+        ScaleY     = 8,
+        ScaleZ     = 9,
+    };
+
+    /* Structure of arrays bone pose, each channel array is padded to a multiple of 8 bones. Rotations are always stored as quaternions */
+    class BfresSkeletalPose {
+        public:
+            static constexpr u32 cChannelCount = sizeof(ResBfresBoneAnimResultDefault) / sizeof(float);
+            static constexpr u32 cLaneCount    = sizeof(vp::util::v8f) / sizeof(float);
+        private:
+            float *m_channel_array[cChannelCount];
+            u32    m_bone_count;
+            u32    m_channel_stride;
+        public:
+            constexpr  BfresSkeletalPose() : m_channel_array(), m_bone_count(0), m_channel_stride(0) {/*...*/}
+            constexpr ~BfresSkeletalPose() {/*...*/}
+
+            static constexpr size_t GetWorkMemorySize(u32 bone_count) {
+                return sizeof(float) * cChannelCount * vp::util::AlignUp(bone_count, cLaneCount);
+            }
+
+            bool Initialize(void *work_memory, size_t work_memory_size, u32 bone_count) {
+
+                /* Integrity checks */
+                if (work_memory == nullptr || work_memory_size < GetWorkMemorySize(bone_count)) { return false; }
+
+                /* Carve channel arrays */
+                m_bone_count     = bone_count;
+                m_channel_stride = vp::util::AlignUp(bone_count, cLaneCount);
+                for (u32 i = 0; i < cChannelCount; ++i) {
+                    m_channel_array[i] = reinterpret_cast<float*>(work_memory) + m_channel_stride * i;
+                }
+                ::memset(work_memory, 0, GetWorkMemorySize(bone_count));
+
+                return true;
+            }
+
+            void Finalize() {
+                for (u32 i = 0; i < cChannelCount; ++i) {
+                    m_channel_array[i] = nullptr;
+                }
+                m_bone_count     = 0;
+                m_channel_stride = 0;
+            }
+
+            void SetBindPose(const ResBfresSkeleton *skeleton);
+
+            void Copy(const BfresSkeletalPose *pose) {
+                ::memcpy(m_channel_array[0], pose->m_channel_array[0], sizeof(float) * cChannelCount * m_channel_stride);
+            }
+
+            constexpr ALWAYS_INLINE float *GetChannel(BfresSkeletalPoseChannel channel) const { return m_channel_array[static_cast<u32>(channel)]; }
+            constexpr ALWAYS_INLINE float *GetChannel(u32 channel_index) const                { return m_channel_array[channel_index]; }
+
+            constexpr ALWAYS_INLINE u32 GetBoneCount() const     { return m_bone_count; }
+            constexpr ALWAYS_INLINE u32 GetChannelStride() const { return m_channel_stride; }
+
+            /* Builds bone local transforms, 8 bones at a time */
+            void CalculateLocalMatrices(vp::util::Matrix34f *out_local_matrix_array) const;
+
+            /* Builds world transforms in parent order from local transforms. out_world_matrix_array may alias local_matrix_array */
+            static void CalculateWorldMatrices(vp::util::Matrix34f *out_world_matrix_array, const vp::util::Matrix34f *local_matrix_array, const ResBfresSkeleton *skeleton, const vp::util::Matrix34f &root_matrix);
+    };
+
+    /* Weighted blend of N poses of the same skeleton, quaternions are aligned to the first layer's hemisphere and renormalized */
+    void BlendBfresSkeletalPoses(BfresSkeletalPose *out_pose, const BfresSkeletalPose *const *layer_pose_array, const float *weight_array, u32 layer_count);
+
+    /* Samples a skeletal anim into a pose, caching a key cursor and sampled value per curve */
+    class BfresSkeletalAnimPlayer {
+        private:
+            const ResBfresSkeletalAnim *m_skeletal_anim;
+            u16                        *m_key_cursor_array;
+            float                      *m_curve_value_array;
+            u32                         m_curve_count;
+        public:
+            constexpr  BfresSkeletalAnimPlayer() : m_skeletal_anim(nullptr), m_key_cursor_array(nullptr), m_curve_value_array(nullptr), m_curve_count(0) {/*...*/}
+            constexpr ~BfresSkeletalAnimPlayer() {/*...*/}
+
+            static constexpr size_t GetWorkMemorySize(const ResBfresSkeletalAnim *skeletal_anim) {
+                return (sizeof(float) + sizeof(u16)) * skeletal_anim->total_anim_curves;
+            }
+
+            bool Initialize(const ResBfresSkeletalAnim *skeletal_anim, void *work_memory, size_t work_memory_size) {
+
+                /* Integrity checks */
+                if (skeletal_anim == nullptr || (work_memory == nullptr && skeletal_anim->total_anim_curves != 0) || work_memory_size < GetWorkMemorySize(skeletal_anim)) { return false; }
+
+                /* Carve work memory */
+                m_skeletal_anim     = skeletal_anim;
+                m_curve_count       = skeletal_anim->total_anim_curves;
+                m_curve_value_array = reinterpret_cast<float*>(work_memory);
+                m_key_cursor_array  = reinterpret_cast<u16*>(m_curve_value_array + m_curve_count);
+                ::memset(m_key_cursor_array, 0, sizeof(u16) * m_curve_count);
+
+                return true;
+            }
+
+            void Finalize() {
+                m_skeletal_anim     = nullptr;
+                m_key_cursor_array  = nullptr;
+                m_curve_value_array = nullptr;
+                m_curve_count       = 0;
+            }
+
+            /* Samples the anim at frame over bind_pose. Bones without a bone anim keep their bind transform */
+            void Sample(BfresSkeletalPose *out_pose, const BfresSkeletalPose *bind_pose, float frame);
+    };
+
+    /* Runs sample, blend, and local to world for one skeleton. Register one per skeleton with a job system */
+    class BfresSkeletalPoseJob : public vp::util::Job {
+        private:
+            BfresSkeletalAnimPlayer  *m_anim_player_array;
+            BfresSkeletalPose        *m_layer_pose_array;
+            const BfresSkeletalPose **m_layer_pose_pointer_array;
+            const float              *m_weight_array;
+            const float              *m_frame_array;
+            u32                       m_layer_count;
+            const BfresSkeletalPose  *m_bind_pose;
+            BfresSkeletalPose        *m_out_pose;
+            const ResBfresSkeleton   *m_skeleton;
+            vp::util::Matrix34f       m_root_matrix;
+            vp::util::Matrix34f      *m_out_world_matrix_array;
+        public:
+            constexpr BfresSkeletalPoseJob() : Job("BfresSkeletalPoseJob"), m_anim_player_array(), m_layer_pose_array(), m_layer_pose_pointer_array(), m_weight_array(), m_frame_array(), m_layer_count(), m_bind_pose(), m_out_pose(), m_skeleton(), m_root_matrix(), m_out_world_matrix_array() {/*...*/}
+            constexpr ~BfresSkeletalPoseJob() {/*...*/}
+
+            /* layer_pose_pointer_array must hold layer_count entries, a single layer skips the blend */
+            constexpr void Initialize(BfresSkeletalAnimPlayer *anim_player_array, BfresSkeletalPose *layer_pose_array, const BfresSkeletalPose **layer_pose_pointer_array, const float *weight_array, const float *frame_array, u32 layer_count, const BfresSkeletalPose *bind_pose, BfresSkeletalPose *out_pose, const ResBfresSkeleton *skeleton, vp::util::Matrix34f *out_world_matrix_array) {
+                m_anim_player_array        = anim_player_array;
+                m_layer_pose_array         = layer_pose_array;
+                m_layer_pose_pointer_array = layer_pose_pointer_array;
+                m_weight_array             = weight_array;
+                m_frame_array              = frame_array;
+                m_layer_count              = layer_count;
+                m_bind_pose                = bind_pose;
+                m_out_pose                 = out_pose;
+                m_skeleton                 = skeleton;
+                m_root_matrix              = vp::util::IdentityMatrix34<float>;
+                m_out_world_matrix_array   = out_world_matrix_array;
+            }
+
+            constexpr void SetRootMatrix(const vp::util::Matrix34f &root_matrix) {
+                m_root_matrix = root_matrix;
+            }
+
+            virtual void Invoke() override;
+    };
+}
@@ -240,6 +240,12 @@ namespace vp::res {
         void SwapKeyTableEndian(u32 table_offset, ByamlBigDataCache *big_data_cache);
 
         void SwapByamlEndian(vp::imem::IHeap *heap);
+
+        /* Swaps a reverse endian byaml to native endian in place, the file memory must be writable */
+        void NormalizeEndian(vp::imem::IHeap *heap) {
+            if (this->IsReverseEndian() == false) { return; }
+            this->SwapByamlEndian(heap);
+        }
     };
     static_assert(sizeof(ResByaml) == 0x10);
 
@@ -30,6 +30,72 @@ namespace vp::res {
         }
     }
 
+    namespace impl {
+
+        constexpr inline u32 cByamlInvalidSearchIndex = 0xffff'ffff;
+
+        /* Containers up to this many entries are scanned linearly, larger ones are binary searched down to a window this size first */
+        constexpr inline u32 cByamlVectorSearchWindow = 32;
+
+        ALWAYS_INLINE u32 GetByamlCompareMask(vp::util::v8si compare) {
+#ifdef VP_TARGET_ARCHITECTURE_x86
+            return __builtin_ia32_movmskps256(std::bit_cast<vp::util::v8f>(compare));
+#else
+            const vp::util::v8si bits = compare & vp::util::v8si{ 0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80 };
+            return bits[0] | bits[1] | bits[2] | bits[3] | bits[4] | bits[5] | bits[6] | bits[7];
+#endif
+        }
+
+        /* Compares the leading u32 of 8 consecutive 8 byte entries, returns a bit per matching entry */
+        ALWAYS_INLINE u32 CompareByamlEntries8(const void *entry_array, u32 raw_key, u32 key_mask) {
+
+            /* Load 8 entries and gather the leading word of each */
+            vp::util::v8ui entries_low;
+            vp::util::v8ui entries_high;
+            ::memcpy(std::addressof(entries_low),  entry_array, sizeof(vp::util::v8ui));
+            ::memcpy(std::addressof(entries_high), reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(entry_array) + sizeof(vp::util::v8ui)), sizeof(vp::util::v8ui));
+            const vp::util::v8ui keys = __builtin_shuffle(entries_low, entries_high, vp::util::v8ui{ 0, 2, 4, 6, 8, 10, 12, 14 });
+
+            return GetByamlCompareMask((keys & key_mask) == raw_key);
+        }
+
+        /* Searches sorted 8 byte entries by their leading u32, key is native endian for ordering while raw_key is the file endian key for the vector compare */
+        template <typename GetKeyFunction>
+        ALWAYS_INLINE u32 SearchByamlEntries(const void *entry_array, u32 count, u32 key, u32 raw_key, u32 key_mask, GetKeyFunction get_key) {
+
+            /* Binary search down to the vector window */
+            u32 i    = 0;
+            u32 size = count;
+            while (cByamlVectorSearchWindow < size - i) {
+                const u32 index   = (i + size) >> 1;
+                const u32 cur_key = get_key(index);
+                if (cur_key == key) { return index; }
+                if (cur_key < key) {
+                    i = index + 1;
+                } else {
+                    size = index;
+                }
+            }
+
+            /* Scalar scan for containers smaller than a vector */
+            if (count < 8) {
+                for (; i < size; ++i) {
+                    if (get_key(i) == key) { return i; }
+                }
+                return cByamlInvalidSearchIndex;
+            }
+
+            /* Scan the window 8 entries at a time, clamping the last block to the container as keys are unique */
+            for (u32 base = i; base < size; base = base + 8) {
+                const u32 block_base = (base + 8 <= count) ? base : count - 8;
+                const u32 mask       = CompareByamlEntries8(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(entry_array) + sizeof(u64) * block_base), raw_key, key_mask);
+                if (mask != 0) { return block_base + __builtin_ctz(mask); }
+            }
+
+            return cByamlInvalidSearchIndex;
+        }
+    }
+
     class ByamlDictionaryIterator {
         private:
             const ResByamlContainer *m_byaml_container;
@@ -91,6 +157,19 @@ namespace vp::res {
 
                 return index;
             }
+            ALWAYS_INLINE u32 TryFindIndexByKeyIndex(u32 key_index, u32 is_reverse_endian) const {
+
+                /* Integrity checks */
+                if (m_byaml_container == nullptr) { return impl::cByamlInvalidSearchIndex; }
+
+                /* Search pairs by their 24 bit key index */
+                const ResByamlDictionaryPair *pair_array = reinterpret_cast<const ResByamlDictionaryPair*>(reinterpret_cast<uintptr_t>(m_byaml_container) + sizeof(ResByamlContainer));
+                const u32                     raw_key    = (is_reverse_endian == false) ? key_index : vp::util::SwapEndian24(key_index);
+                return impl::SearchByamlEntries(pair_array, this->GetCount(is_reverse_endian), key_index, raw_key, 0xff'ffff, [pair_array, is_reverse_endian](u32 index) -> u32 {
+                    return (is_reverse_endian == false) ? pair_array[index].key_index : vp::util::SwapEndian24(pair_array[index].key_index);
+                });
+            }
+
             constexpr ALWAYS_INLINE u32 GetCount(u32 is_reverse_endian) const {
                 return (is_reverse_endian == false) ? static_cast<u32>(m_byaml_container->count) : vp::util::SwapEndian24(static_cast<u32>(m_byaml_container->count));
             }
@@ -181,6 +260,20 @@ namespace vp::res {
                 return true;
             }
 
+            /* Only valid for u32 hash arrays */
+            ALWAYS_INLINE u32 TryFindIndexByHash(u32 hash, u32 is_reverse_endian) const {
+
+                /* Integrity checks */
+                if (m_byaml_container == nullptr || m_stride != sizeof(u32)) { return impl::cByamlInvalidSearchIndex; }
+
+                /* Search hash and value pairs by hash */
+                const u32 *entry_array = reinterpret_cast<const u32*>(reinterpret_cast<uintptr_t>(m_byaml_container) + sizeof(ResByamlContainer));
+                const u32  raw_hash    = (is_reverse_endian == false) ? hash : vp::util::SwapEndian(hash);
+                return impl::SearchByamlEntries(entry_array, this->GetCount(is_reverse_endian), hash, raw_hash, 0xffff'ffff, [entry_array, is_reverse_endian](u32 index) -> u32 {
+                    return (is_reverse_endian == false) ? entry_array[index * 2] : vp::util::SwapEndian(entry_array[index * 2]);
+                });
+            }
+
             ALWAYS_INLINE u8 GetDataType(u32 index, u32 is_reverse_endian) const {
                 const u32 data_count = this->GetCount(is_reverse_endian);
                 const u32 data_type_offset = (m_stride + sizeof(u32)) * data_count + index * sizeof(u8);
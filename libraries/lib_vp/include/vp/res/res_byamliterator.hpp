@@ -17,11 +17,20 @@
 
 namespace vp::res {
 
-    class ByamlIterator {
+    template <bool IsNativeEndianOnly>
+    class ByamlIteratorBase {
         private:
             const ResByaml *m_byaml;
             ByamlData       m_container_data;
         private:
+            constexpr ALWAYS_INLINE bool IsReverseEndian() const {
+                if constexpr (IsNativeEndianOnly == true) {
+                    return false;
+                } else {
+                    return m_byaml->IsReverseEndian();
+                }
+            }
+
             template <typename T>
             ALWAYS_INLINE bool TryGetValueByKeyImpl(T *out_value, const char *key) const {
 
@@ -86,9 +95,61 @@ namespace vp::res {
 
                 return true;
             }
+
+            ALWAYS_INLINE bool TryDecodeSchemaField(void *out_field, const ByamlSchemaField &field, ByamlData data) const {
+                switch (field.data_type) {
+                    case ByamlDataType::Bool:        return this->TryGetBoolByData(reinterpret_cast<bool*>(out_field), data);
+                    case ByamlDataType::S32:         return this->TryGetS32ByData(reinterpret_cast<s32*>(out_field), data);
+                    case ByamlDataType::F32:         return this->TryGetF32ByData(reinterpret_cast<float*>(out_field), data);
+                    case ByamlDataType::U32:         return this->TryGetU32ByData(reinterpret_cast<u32*>(out_field), data);
+                    case ByamlDataType::S64:         return this->TryGetS64ByData(reinterpret_cast<s64*>(out_field), data);
+                    case ByamlDataType::U64:         return this->TryGetU64ByData(reinterpret_cast<u64*>(out_field), data);
+                    case ByamlDataType::F64:         return this->TryGetF64ByData(reinterpret_cast<double*>(out_field), data);
+                    case ByamlDataType::StringIndex: return this->TryGetStringByData(reinterpret_cast<const char**>(out_field), data);
+                    default:
+                        break;
+                }
+                return false;
+            }
+
+            template <typename T, size_t FieldCount, typename GetFieldAddressFunction>
+            u32 DecodeBySchemaImpl(const ByamlSchemaBinding<T, FieldCount> &binding, GetFieldAddressFunction get_field_address) const {
+
+                /* Integrity checks */
+                if (m_byaml == nullptr || binding.byaml != m_byaml || (static_cast<ByamlDataType>(m_container_data.data_type) != ByamlDataType::Dictionary && static_cast<ByamlDataType>(m_container_data.data_type) != ByamlDataType::DictionaryWithRemap)) { return 0; }
+
+                /* Endianess check */
+                const u32 is_reverse_endian = this->IsReverseEndian();
+
+                /* Setup container */
+                const ResByamlContainer      *dic_container = reinterpret_cast<const ResByamlContainer*>(m_container_data.GetBigData(m_byaml));
+                const ResByamlDictionaryPair *pair_array    = reinterpret_cast<const ResByamlDictionaryPair*>(reinterpret_cast<uintptr_t>(dic_container) + sizeof(ResByamlContainer));
+                const u32                     pair_count    = ByamlDictionaryIterator(dic_container).GetCount(is_reverse_endian);
+
+                /* Merge walk the dictionary pairs and bound keys, both are in key index order */
+                const u32 bound_count  = binding.bound_count;
+                u32       decode_count = 0;
+                u32       bound_index  = 0;
+                for (u32 pair_index = 0; pair_index < pair_count && bound_index < bound_count; ++pair_index) {
+
+                    const u32 r_key_index = (is_reverse_endian == false) ? pair_array[pair_index].key_index : vp::util::SwapEndian24(pair_array[pair_index].key_index);
+                    while (bound_index < bound_count && binding.key_index_array[bound_index] < r_key_index) { ++bound_index; }
+                    if (bound_index == bound_count || binding.key_index_array[bound_index] != r_key_index) { continue; }
+
+                    /* Decode field */
+                    ByamlData data = {};
+                    data.SetPair(std::addressof(pair_array[pair_index]), is_reverse_endian);
+
+                    const u32 field_index = binding.field_index_array[bound_index];
+                    decode_count += this->TryDecodeSchemaField(get_field_address(field_index), binding.schema->GetField(field_index), data);
+                    ++bound_index;
+                }
+
+                return decode_count;
+            }
         public:
-            constexpr ByamlIterator() : m_byaml(nullptr), m_container_data{} {/*...*/}
-            ALWAYS_INLINE ByamlIterator(const unsigned char *byaml_file) : m_byaml(reinterpret_cast<const ResByaml*>(byaml_file)), m_container_data{} {
+            constexpr ByamlIteratorBase() : m_byaml(nullptr), m_container_data{} {/*...*/}
+            ALWAYS_INLINE ByamlIteratorBase(const unsigned char *byaml_file) : m_byaml(reinterpret_cast<const ResByaml*>(byaml_file)), m_container_data{} {
 
                 /* Verify valid byaml file */
                 if (m_byaml->IsValid() == false) {
@@ -96,11 +157,19 @@ namespace vp::res {
                     return;
                 }
 
+                /* Native endian iterators require a normalized byaml */
+                if constexpr (IsNativeEndianOnly == true) {
+                    if (m_byaml->IsReverseEndian() == true) {
+                        m_byaml = nullptr;
+                        return;
+                    }
+                }
+
                 /* Check for data container */
                 if (m_byaml->data_offset == 0) { return; }
 
                 /* Get data offset */
-                const bool is_reverse_endian = m_byaml->IsReverseEndian();
+                const bool is_reverse_endian = this->IsReverseEndian();
                 const u32 data_offset        = (is_reverse_endian == false) ? m_byaml->data_offset : vp::util::SwapEndian(m_byaml->data_offset);
 
                 /* Get data type */
@@ -115,7 +184,7 @@ namespace vp::res {
 
                 return;
             }
-            ALWAYS_INLINE ByamlIterator(const void *byaml_file) : m_byaml(reinterpret_cast<const ResByaml*>(byaml_file)), m_container_data{} {
+            ALWAYS_INLINE ByamlIteratorBase(const void *byaml_file) : m_byaml(reinterpret_cast<const ResByaml*>(byaml_file)), m_container_data{} {
 
                 /* Verify valid byaml file */
                 if (m_byaml->IsValid() == false) {
@@ -123,11 +192,19 @@ namespace vp::res {
                     return;
                 }
 
+                /* Native endian iterators require a normalized byaml */
+                if constexpr (IsNativeEndianOnly == true) {
+                    if (m_byaml->IsReverseEndian() == true) {
+                        m_byaml = nullptr;
+                        return;
+                    }
+                }
+
                 /* Check for data container */
                 if (m_byaml->data_offset == 0) { return; }
 
                 /* Get data offset */
-                const bool is_reverse_endian = m_byaml->IsReverseEndian();
+                const bool is_reverse_endian = this->IsReverseEndian();
                 const u32 data_offset        = (is_reverse_endian == false) ? m_byaml->data_offset : vp::util::SwapEndian(m_byaml->data_offset);
 
                 /* Get data type */
@@ -143,11 +220,11 @@ namespace vp::res {
                 return;
             }
 
-            constexpr ALWAYS_INLINE ByamlIterator(const ByamlIterator& rhs) : m_byaml(rhs.m_byaml), m_container_data(rhs.m_container_data) {/*...*/}
+            constexpr ALWAYS_INLINE ByamlIteratorBase(const ByamlIteratorBase& rhs) : m_byaml(rhs.m_byaml), m_container_data(rhs.m_container_data) {/*...*/}
 
-            constexpr ~ByamlIterator() {/*...*/}
+            constexpr ~ByamlIteratorBase() {/*...*/}
 
-            constexpr ALWAYS_INLINE ByamlIterator &operator=(const ByamlIterator &rhs) {
+            constexpr ALWAYS_INLINE ByamlIteratorBase &operator=(const ByamlIteratorBase &rhs) {
                 m_byaml          = rhs.m_byaml;
                 m_container_data = rhs.m_container_data;
                 return *this;
@@ -161,7 +238,7 @@ namespace vp::res {
             bool TryGetKeyByData(const char **out_key, ByamlData data) const {
 
                 /* Endianess check */
-                const u32 is_reverse_endian = m_byaml->IsReverseEndian();
+                const u32 is_reverse_endian = this->IsReverseEndian();
 
                 /* Check key index is valid */
                 if (data.IsKeyIndexValid() == false) { return false; }
@@ -189,7 +266,7 @@ namespace vp::res {
             bool TryGetKeyIndexByKey(u32 *out_key_index, const char *key) const {
 
                 /* Endianess check */
-                const u32 is_reverse_endian = m_byaml->IsReverseEndian();
+                const u32 is_reverse_endian = this->IsReverseEndian();
 
                 /* Get key index */
                 const u32 key_table_offset = (is_reverse_endian == false) ? m_byaml->key_table_offset : vp::util::SwapEndian(m_byaml->key_table_offset);
@@ -208,7 +285,7 @@ namespace vp::res {
                 if (m_byaml == nullptr || m_byaml->key_table_offset == 0 || (static_cast<ByamlDataType>(m_container_data.data_type) != ByamlDataType::Dictionary && static_cast<ByamlDataType>(m_container_data.data_type) != ByamlDataType::DictionaryWithRemap)) { return false; }
 
                 /* Endianess check */
-                const u32 is_reverse_endian = m_byaml->IsReverseEndian();
+                const u32 is_reverse_endian = this->IsReverseEndian();
 
                 /* Setup container and iterators */
                 const u32 r_key_table_offset = (is_reverse_endian == false) ? m_byaml->key_table_offset : vp::util::SwapEndian(m_byaml->key_table_offset);
@@ -260,7 +337,7 @@ namespace vp::res {
                 if (m_byaml == nullptr || m_byaml->key_table_offset == 0 || (static_cast<ByamlDataType>(m_container_data.data_type) != ByamlDataType::Dictionary && static_cast<ByamlDataType>(m_container_data.data_type) != ByamlDataType::DictionaryWithRemap)) { return false; }
 
                 /* Endianess check */
-                const u32 is_reverse_endian = m_byaml->IsReverseEndian();
+                const u32 is_reverse_endian = this->IsReverseEndian();
 
                 /* Setup container and iterators */
                 const u32 r_key_table_offset = (is_reverse_endian == false) ? m_byaml->key_table_offset : vp::util::SwapEndian(m_byaml->key_table_offset);
@@ -308,19 +385,87 @@ namespace vp::res {
                 return false;
             }
 
+            bool TryGetKeyHandle(ByamlKeyHandle *out_key_handle, const char *key) const {
+
+                /* Integrity checks */
+                if (m_byaml == nullptr || m_byaml->key_table_offset == 0) { return false; }
+
+                /* Resolve key index once, the handle stays valid for every container of this byaml */
+                u32 key_index = ByamlData::cInvalidKeyIndex;
+                const bool result = this->TryGetKeyIndexByKey(std::addressof(key_index), key);
+
+                out_key_handle->byaml     = m_byaml;
+                out_key_handle->key_index = (result == true) ? key_index : ByamlData::cInvalidKeyIndex;
+
+                return result;
+            }
+
+            bool TryGetByamlDataByKeyHandle(ByamlData *out_byaml_data, const ByamlKeyHandle &key_handle) const {
+
+                /* Integrity checks */
+                if (m_byaml == nullptr || key_handle.IsValid(m_byaml) == false || (static_cast<ByamlDataType>(m_container_data.data_type) != ByamlDataType::Dictionary && static_cast<ByamlDataType>(m_container_data.data_type) != ByamlDataType::DictionaryWithRemap)) { return false; }
+
+                /* Endianess check */
+                const u32 is_reverse_endian = this->IsReverseEndian();
+
+                /* Setup container iterator */
+                const ResByamlContainer      *dic_container = reinterpret_cast<const ResByamlContainer*>(m_container_data.GetBigData(m_byaml));
+                const ByamlDictionaryIterator dic_iter(dic_container);
+
+                /* Search by key index as dictionary pairs follow the sorted key table order */
+                const u32 index = dic_iter.TryFindIndexByKeyIndex(key_handle.key_index, is_reverse_endian);
+                if (index == impl::cByamlInvalidSearchIndex) {
+                    *out_byaml_data = ByamlData{ .key_index = ByamlData::cInvalidKeyIndex };
+                    return false;
+                }
+
+                out_byaml_data->SetPair(dic_iter.GetDictionaryPairByIndex(index, is_reverse_endian), is_reverse_endian);
+
+                return true;
+            }
+
+            bool TryGetByamlDataByHashedKey(ByamlData *out_byaml_data, const ByamlKeyIndexCache &key_index_cache, const ByamlHashedKey &key) const {
+
+                /* Resolve key handle through the cache */
+                ByamlKeyHandle key_handle = {};
+                const bool result = key_index_cache.TryGetKeyHandle(std::addressof(key_handle), key);
+                if (result == false) { return false; }
+
+                return this->TryGetByamlDataByKeyHandle(out_byaml_data, key_handle);
+            }
+
             bool TryGetByamlDataByHash(ByamlData *out_byaml_data, u32 hash) const {
 
                 /* Integrity checks */
                 if (m_byaml == nullptr || m_byaml->key_table_offset == 0 || (static_cast<ByamlDataType>(m_container_data.data_type & 0xe0) != ByamlDataType::HashArrayU32_1)) { return false; }
 
                 /* Endianess check */
-                const u32 is_reverse_endian = m_byaml->IsReverseEndian();
+                const u32 is_reverse_endian = this->IsReverseEndian();
 
                 /* Setup container and iterators */
                 const u32 stride = (m_container_data.data_type & 0xf) * sizeof(u32) + sizeof(ResByamlContainer);
                 const ResByamlContainer      *hash_container = reinterpret_cast<const ResByamlContainer*>(m_container_data.GetBigData(m_byaml));
                 const ByamlHashArrayIterator  hash_array_iter(hash_container, stride);
 
+                /* Vector assisted search for u32 hashes */
+                if (stride == sizeof(u32)) {
+
+                    const u32 count = hash_array_iter.GetCount(is_reverse_endian);
+                    const u32 index = hash_array_iter.TryFindIndexByHash(hash, is_reverse_endian);
+                    if (index == impl::cByamlInvalidSearchIndex) {
+                        *out_byaml_data = ByamlData{ .key_index = ByamlData::cInvalidKeyIndex };
+                        return false;
+                    }
+
+                    const u8                *data_type_array = reinterpret_cast<u8*>(reinterpret_cast<uintptr_t>(hash_container) + (stride + sizeof(u32)) * count);
+                    const ByamlHashAccessor  hash_accessor(hash_container, stride, index);
+                    out_byaml_data->data_type = data_type_array[index];
+                    out_byaml_data->key_index = index;
+                    out_byaml_data->u32_value = hash_accessor.GetValue(is_reverse_endian);
+
+                    return true;
+                }
+
                 /* Binary search pattern as the string table is always sorted */
                 u32 size = hash_array_iter.GetCount(is_reverse_endian);
                 u32 i = 0;
@@ -358,7 +503,7 @@ namespace vp::res {
                 if (m_byaml == nullptr || m_byaml->key_table_offset == 0 || (static_cast<ByamlDataType>(m_container_data.data_type & 0xe0) != ByamlDataType::HashArrayU32_1)) { return false; }
 
                 /* Endianess check */
-                const u32 is_reverse_endian = m_byaml->IsReverseEndian();
+                const u32 is_reverse_endian = this->IsReverseEndian();
 
                 /* Setup container and iterators */
                 const u32 stride = (m_container_data.data_type & 0xf) * sizeof(u32) + sizeof(ResByamlContainer);
@@ -399,7 +544,7 @@ namespace vp::res {
             bool TryGetByamlDataByIndex(ByamlData *out_byaml_data, u32 index) const {
 
                 /* Endianess check */
-                const u32 is_reverse_endian = m_byaml->IsReverseEndian();
+                const u32 is_reverse_endian = this->IsReverseEndian();
 
                 /* Find data using respective container iter */
                 u32         data_type = static_cast<u32>(m_container_data.data_type);
@@ -425,7 +570,7 @@ namespace vp::res {
 
             ALWAYS_INLINE u32 GetDataCount() const {
                 const ResByamlContainer *container = reinterpret_cast<const ResByamlContainer*>(m_container_data.GetBigData(m_byaml));
-                return (m_byaml->IsReverseEndian() == false) ? container->count : vp::util::SwapEndian24(container->count);
+                return (this->IsReverseEndian() == false) ? container->count : vp::util::SwapEndian24(container->count);
             }
 
             constexpr ALWAYS_INLINE u32 GetDataType() const {
@@ -558,7 +703,7 @@ namespace vp::res {
                 if (data_type != ByamlDataType::S64) { return false; }
 
                 const s64 *value = reinterpret_cast<s64*>(reinterpret_cast<uintptr_t>(m_byaml) + data.u32_value);
-                *out_longlong = (m_byaml->IsReverseEndian() == false) ? *value : vp::util::SwapEndian(*value);
+                *out_longlong = (this->IsReverseEndian() == false) ? *value : vp::util::SwapEndian(*value);
 
                 return true;
             }
@@ -609,7 +754,7 @@ namespace vp::res {
                 if (data_type != ByamlDataType::U64) { return false; }
 
                 const u64 *value = reinterpret_cast<u64*>(reinterpret_cast<uintptr_t>(m_byaml) + data.u32_value);
-                *out_ulonglong = (m_byaml->IsReverseEndian() == false) ? *value : vp::util::SwapEndian(*value);
+                *out_ulonglong = (this->IsReverseEndian() == false) ? *value : vp::util::SwapEndian(*value);
 
                 return true;
             }
@@ -660,7 +805,7 @@ namespace vp::res {
                 if (data_type != ByamlDataType::F64) { return false; }
 
                 const double *value = reinterpret_cast<double*>(reinterpret_cast<uintptr_t>(m_byaml) + data.u32_value);
-                *out_double = (m_byaml->IsReverseEndian() == false) ? *value : vp::util::SwapEndian(*value);
+                *out_double = (this->IsReverseEndian() == false) ? *value : vp::util::SwapEndian(*value);
 
                 return true;
             }
@@ -706,7 +851,7 @@ namespace vp::res {
                 const ByamlDataType data_type = static_cast<ByamlDataType>(data.data_type);
                 if (data_type == ByamlDataType::BinaryData) {
                     const u32 *size_data = reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(m_byaml) + data.u32_value);
-                    *out_size      = (m_byaml->IsReverseEndian() == false) ? *size_data : vp::util::SwapEndian(*size_data);
+                    *out_size      = (this->IsReverseEndian() == false) ? *size_data : vp::util::SwapEndian(*size_data);
                     *out_alignment = 0;
                     *out_binary    = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(size_data) + sizeof(u32));
                     return true;
@@ -714,8 +859,8 @@ namespace vp::res {
                 if (data_type == ByamlDataType::BinaryDataWithAlignment) {
                     const u32 *size_data      = reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(m_byaml) + data.u32_value);
                     const u32 *alignment_data = reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(size_data) + sizeof(u32));
-                    *out_size      = (m_byaml->IsReverseEndian() == false) ? *size_data : vp::util::SwapEndian(*size_data);
-                    *out_alignment = (m_byaml->IsReverseEndian() == false) ? *alignment_data : vp::util::SwapEndian(*alignment_data);
+                    *out_size      = (this->IsReverseEndian() == false) ? *size_data : vp::util::SwapEndian(*size_data);
+                    *out_alignment = (this->IsReverseEndian() == false) ? *alignment_data : vp::util::SwapEndian(*alignment_data);
                     *out_binary    = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(alignment_data) + sizeof(u32));
                     return true;
                 }
@@ -764,7 +909,7 @@ namespace vp::res {
                 const ByamlDataType data_type = static_cast<ByamlDataType>(data.data_type);
                 if (data_type != ByamlDataType::StringIndex) { return false; }
 
-                const u32 is_reverse_endian = m_byaml->IsReverseEndian();
+                const u32 is_reverse_endian = this->IsReverseEndian();
 
                 const u32 string_table_offset = (is_reverse_endian == false) ? m_byaml->string_table_offset : vp::util::SwapEndian(m_byaml->string_table_offset);
                 const ResByamlContainer *key_container = reinterpret_cast<const ResByamlContainer*>(reinterpret_cast<uintptr_t>(m_byaml) + string_table_offset);
@@ -783,7 +928,7 @@ namespace vp::res {
                 return true;
             }
 
-            bool TryGetIteratorByKey(ByamlIterator *out_iterator, const char *key) const {
+            bool TryGetIteratorByKey(ByamlIteratorBase *out_iterator, const char *key) const {
 
                 ByamlData data = {};
                 const bool result = this->TryGetByamlDataByKey(std::addressof(data), key);
@@ -792,7 +937,25 @@ namespace vp::res {
                 return this->TryGetIteratorByData(out_iterator, data);
             }
 
-            bool TryGetIteratorByIndex(ByamlIterator *out_iterator, u32 index) const {
+            bool TryGetIteratorByKeyHandle(ByamlIteratorBase *out_iterator, const ByamlKeyHandle &key_handle) const {
+
+                ByamlData data = {};
+                const bool result = this->TryGetByamlDataByKeyHandle(std::addressof(data), key_handle);
+                if (result == false) { return false; }
+
+                return this->TryGetIteratorByData(out_iterator, data);
+            }
+
+            bool TryGetIteratorByHashedKey(ByamlIteratorBase *out_iterator, const ByamlKeyIndexCache &key_index_cache, const ByamlHashedKey &key) const {
+
+                ByamlData data = {};
+                const bool result = this->TryGetByamlDataByHashedKey(std::addressof(data), key_index_cache, key);
+                if (result == false) { return false; }
+
+                return this->TryGetIteratorByData(out_iterator, data);
+            }
+
+            bool TryGetIteratorByIndex(ByamlIteratorBase *out_iterator, u32 index) const {
 
                 ByamlData data = {};
                 const bool result = this->TryGetByamlDataByIndex(std::addressof(data), index);
@@ -801,7 +964,7 @@ namespace vp::res {
                 return this->TryGetIteratorByData(out_iterator, data);
             }
 
-            bool TryGetIteratorByHash(ByamlIterator *out_iterator, u32 hash) const {
+            bool TryGetIteratorByHash(ByamlIteratorBase *out_iterator, u32 hash) const {
 
                 ByamlData data = {};
                 const bool result = this->TryGetByamlDataByHash(std::addressof(data), hash);
@@ -810,7 +973,7 @@ namespace vp::res {
                 return this->TryGetIteratorByData(out_iterator, data);
             }
 
-            bool TryGetIteratorByHash(ByamlIterator *out_iterator, u64 hash) const {
+            bool TryGetIteratorByHash(ByamlIteratorBase *out_iterator, u64 hash) const {
 
                 ByamlData data = {};
                 const bool result = this->TryGetByamlDataByHash(std::addressof(data), hash);
@@ -819,7 +982,7 @@ namespace vp::res {
                 return this->TryGetIteratorByData(out_iterator, data);
             }
 
-            bool TryGetIteratorByData(ByamlIterator *out_iterator, ByamlData data) const {
+            bool TryGetIteratorByData(ByamlIteratorBase *out_iterator, ByamlData data) const {
 
                 const ByamlDataType data_type = static_cast<ByamlDataType>(data.data_type);
                 const ByamlDataType arr_type  = static_cast<ByamlDataType>(data.data_type & 0xf7);
@@ -842,6 +1005,62 @@ namespace vp::res {
                 return false;
             }
 
+            template <typename T, size_t FieldCount>
+            bool TryBindSchema(ByamlSchemaBinding<T, FieldCount> *out_binding, const ByamlSchema<T, FieldCount> &schema) const {
+
+                /* Integrity checks */
+                if (m_byaml == nullptr || m_byaml->key_table_offset == 0) { return false; }
+
+                /* Resolve every key once per byaml, keys missing from the file are dropped so the bound keys stay in key index order */
+                out_binding->byaml       = m_byaml;
+                out_binding->schema      = std::addressof(schema);
+                out_binding->bound_count = 0;
+                for (u32 i = 0; i < FieldCount; ++i) {
+                    u32 key_index = ByamlData::cInvalidKeyIndex;
+                    if (this->TryGetKeyIndexByKey(std::addressof(key_index), schema.GetSortedField(i).key) == false) { continue; }
+
+                    const u32 bound_index = out_binding->bound_count;
+                    out_binding->key_index_array[bound_index]   = key_index;
+                    out_binding->field_index_array[bound_index] = schema.GetSortedFieldIndex(i);
+                    out_binding->bound_count                    = bound_index + 1;
+                }
+
+                return true;
+            }
+
+            /* Fills the fields of a struct from this dictionary in a single pass, returns the number of fields decoded */
+            template <typename T, size_t FieldCount>
+            u32 DecodeBySchema(T *out_struct, const ByamlSchemaBinding<T, FieldCount> &binding) const {
+                return this->DecodeBySchemaImpl(binding, [out_struct, &binding](u32 field_index) -> void* {
+                    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(out_struct) + binding.schema->GetField(field_index).offset);
+                });
+            }
+
+            /* Decodes an array of dictionaries into per field arrays, returns the number of elements decoded */
+            template <typename T, size_t FieldCount>
+            u32 DecodeArrayBySchema(ByamlSchemaSoaStorage<FieldCount> *out_storage, u32 max_element_count, const ByamlSchemaBinding<T, FieldCount> &binding) const {
+
+                /* Integrity checks */
+                out_storage->element_count = 0;
+                if (m_byaml == nullptr || binding.byaml != m_byaml || (static_cast<ByamlDataType>(m_container_data.data_type & 0xf7) != ByamlDataType::Array)) { return 0; }
+
+                /* Decode each element dictionary into its slot of every field array */
+                const u32 data_count    = this->GetDataCount();
+                const u32 element_count = (max_element_count < data_count) ? max_element_count : data_count;
+                for (u32 i = 0; i < element_count; ++i) {
+
+                    ByamlIteratorBase element_iterator;
+                    if (this->TryGetIteratorByIndex(std::addressof(element_iterator), i) == false) { break; }
+
+                    element_iterator.DecodeBySchemaImpl(binding, [out_storage, &binding, i](u32 field_index) -> void* {
+                        return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(out_storage->field_array[field_index]) + binding.schema->GetField(field_index).size * i);
+                    });
+                    out_storage->element_count = i + 1;
+                }
+
+                return out_storage->element_count;
+            }
+
             template <typename T>
                 requires (TGetByamlDataTypeValue<T>() != ByamlDataType::Null)
             ALWAYS_INLINE bool TryGetValueByKey(T *out_value, const char *key) const {
@@ -972,6 +1191,28 @@ namespace vp::res {
                 }
             }
 
+            template <typename T>
+                requires (TGetByamlDataTypeValue<T>() != ByamlDataType::Null)
+            ALWAYS_INLINE bool TryGetValueByKeyHandle(T *out_value, const ByamlKeyHandle &key_handle) const {
+
+                ByamlData data = {};
+                const bool result = this->TryGetByamlDataByKeyHandle(std::addressof(data), key_handle);
+                if (result == false) { return false; }
+
+                return this->TryGetValueByData(out_value, data);
+            }
+
+            template <typename T>
+                requires (TGetByamlDataTypeValue<T>() != ByamlDataType::Null)
+            ALWAYS_INLINE bool TryGetValueByHashedKey(T *out_value, const ByamlKeyIndexCache &key_index_cache, const ByamlHashedKey &key) const {
+
+                ByamlData data = {};
+                const bool result = this->TryGetByamlDataByHashedKey(std::addressof(data), key_index_cache, key);
+                if (result == false) { return false; }
+
+                return this->TryGetValueByData(out_value, data);
+            }
+
             template <typename T>
                 requires (TGetByamlDataTypeValue<T>() != ByamlDataType::Null)
             ALWAYS_INLINE bool TryGetValueByIterator(T *out_value) const {
@@ -1006,4 +1247,6 @@ namespace vp::res {
                 return this->TryGetBinaryDataByData(out_value, out_size, out_alignment, m_container_data);
             }
     };
+    using ByamlIterator       = ByamlIteratorBase<false>;
+    using NativeByamlIterator = ByamlIteratorBase<true>;
 }
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::res {
+
+    /* A key resolved to its key table index once per byaml file, dictionaries can then be searched by key index without string compares */
+    struct ByamlKeyHandle {
+        const ResByaml *byaml;
+        u32             key_index;
+
+        constexpr ALWAYS_INLINE bool IsValid(const ResByaml *target_byaml) const {
+            return (byaml == target_byaml) & (key_index != ByamlData::cInvalidKeyIndex);
+        }
+    };
+
+    /* A key literal hashed at compile time for lookups through a ByamlKeyIndexCache */
+    class ByamlHashedKey {
+        private:
+            const char *m_key;
+            u32         m_hash;
+        public:
+            consteval ByamlHashedKey(const char *key) : m_key(key), m_hash(vp::util::HashMurmur3(key)) {/*...*/}
+
+            constexpr ALWAYS_INLINE const char *GetKey()  const { return m_key; }
+            constexpr ALWAYS_INLINE u32         GetHash() const { return m_hash; }
+    };
+
+    class ByamlKeyIndexCache {
+        public:
+            struct Entry {
+                u32 hash;
+                u32 key_index;
+            };
+            static_assert(sizeof(Entry) == 0x8);
+        private:
+            const ResByaml           *m_byaml;
+            ByamlStringTableIterator  m_key_table_iterator;
+            u64                       m_key_pool_offset;
+            Entry                    *m_entry_array;
+            u32                       m_entry_mask;
+        private:
+            static constexpr ALWAYS_INLINE u32 GetEntryCount(u32 key_count) {
+
+                /* Keep the load factor at or under one half */
+                u32 entry_count = 1;
+                while (entry_count < (key_count << 1)) { entry_count = entry_count << 1; }
+
+                return entry_count;
+            }
+        public:
+            constexpr ByamlKeyIndexCache() : m_byaml(nullptr), m_key_table_iterator(), m_key_pool_offset(0), m_entry_array(nullptr), m_entry_mask(0) {/*...*/}
+            constexpr ~ByamlKeyIndexCache() {/*...*/}
+
+            static u32 GetKeyCount(const void *byaml_file) {
+
+                /* Integrity checks */
+                const ResByaml *byaml = reinterpret_cast<const ResByaml*>(byaml_file);
+                if (byaml == nullptr || byaml->IsValid() == false || byaml->key_table_offset == 0) { return 0; }
+
+                /* Get key table count */
+                const bool               is_reverse_endian = byaml->IsReverseEndian();
+                const u32                key_table_offset  = (is_reverse_endian == false) ? byaml->key_table_offset : vp::util::SwapEndian(byaml->key_table_offset);
+                const ResByamlContainer *key_container     = reinterpret_cast<const ResByamlContainer*>(reinterpret_cast<uintptr_t>(byaml) + key_table_offset);
+
+                return ByamlStringTableIterator(key_container).GetStringCount(is_reverse_endian);
+            }
+
+            static constexpr ALWAYS_INLINE size_t GetWorkMemorySize(u32 key_count) {
+                return sizeof(Entry) * GetEntryCount(key_count);
+            }
+
+            bool Initialize(const void *byaml_file, void *work_memory, size_t work_memory_size) {
+
+                /* Integrity checks */
+                const u32 key_count = GetKeyCount(byaml_file);
+                if (key_count == 0 || work_memory == nullptr || work_memory_size < GetWorkMemorySize(key_count)) { return false; }
+
+                /* Setup key table */
+                m_byaml = reinterpret_cast<const ResByaml*>(byaml_file);
+
+                const bool               is_reverse_endian = m_byaml->IsReverseEndian();
+                const u32                key_table_offset  = (is_reverse_endian == false) ? m_byaml->key_table_offset : vp::util::SwapEndian(m_byaml->key_table_offset);
+                const ResByamlContainer *key_container     = reinterpret_cast<const ResByamlContainer*>(reinterpret_cast<uintptr_t>(m_byaml) + key_table_offset);
+                m_key_table_iterator = ByamlStringTableIterator(key_container);
+
+                /* Handle key table relocation */
+                m_key_pool_offset = 0;
+                if (static_cast<ByamlDataType>(key_container->data_type) == ByamlDataType::RelocatedKeyTable) {
+                    const u32 *string_table_offset = reinterpret_cast<const u32*>(reinterpret_cast<uintptr_t>(key_container) +  sizeof(ResByamlContainer));
+                    const u32  offset_offset       = (is_reverse_endian == false) ? *string_table_offset : vp::util::SwapEndian(*string_table_offset);
+                    const u64 *key_pool_data       = reinterpret_cast<const u64*>(reinterpret_cast<uintptr_t>(key_container) + offset_offset);
+                    m_key_pool_offset              = (is_reverse_endian == false) ? *key_pool_data : vp::util::SwapEndian(*key_pool_data);
+                }
+
+                /* Clear table */
+                const u32 entry_count = GetEntryCount(key_count);
+                m_entry_array = reinterpret_cast<Entry*>(work_memory);
+                m_entry_mask  = entry_count - 1;
+                for (u32 i = 0; i < entry_count; ++i) {
+                    m_entry_array[i] = { .hash = 0, .key_index = ByamlData::cInvalidKeyIndex };
+                }
+
+                /* Insert every key by hash with linear probing */
+                for (u32 i = 0; i < key_count; ++i) {
+                    const u32 hash  = vp::util::HashMurmur3(m_key_table_iterator.GetStringByIndex(i, m_key_pool_offset, is_reverse_endian));
+                    u32       index = hash & m_entry_mask;
+                    while (m_entry_array[index].key_index != ByamlData::cInvalidKeyIndex) {
+                        index = (index + 1) & m_entry_mask;
+                    }
+                    m_entry_array[index] = { .hash = hash, .key_index = i };
+                }
+
+                return true;
+            }
+
+            void *Finalize() {
+                void *work_memory = m_entry_array;
+                m_byaml       = nullptr;
+                m_entry_array = nullptr;
+                m_entry_mask  = 0;
+                return work_memory;
+            }
+
+            /* Resolves a hashed key without a key table search, only a hash match is confirmed with a string compare */
+            bool TryGetKeyHandle(ByamlKeyHandle *out_key_handle, const ByamlHashedKey &key) const {
+
+                /* Integrity checks */
+                if (m_entry_array == nullptr) { return false; }
+
+                /* Probe for hash */
+                const u32 is_reverse_endian = m_byaml->IsReverseEndian();
+                u32 index = key.GetHash() & m_entry_mask;
+                while (m_entry_array[index].key_index != ByamlData::cInvalidKeyIndex) {
+
+                    if (m_entry_array[index].hash == key.GetHash()) {
+                        const u32   key_index = m_entry_array[index].key_index;
+                        const char *table_key = m_key_table_iterator.GetStringByIndex(key_index, m_key_pool_offset, is_reverse_endian);
+                        if (::strcmp(key.GetKey(), table_key) == 0) {
+                            out_key_handle->byaml     = m_byaml;
+                            out_key_handle->key_index = key_index;
+                            return true;
+                        }
+                    }
+
+                    index = (index + 1) & m_entry_mask;
+                }
+
+                return false;
+            }
+
+            constexpr ALWAYS_INLINE const ResByaml *GetByaml() const { return m_byaml; }
+    };
+}
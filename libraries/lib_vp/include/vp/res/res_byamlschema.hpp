@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::res {
+
+    struct ByamlSchemaField {
+        const char    *key;
+        ByamlDataType  data_type;
+        u32            offset;
+        u32            size;
+    };
+
+    /* Describes a struct member decoded from a dictionary key */
+    #define VP_BYAML_SCHEMA_FIELD(struct_type, member, key) \
+        vp::res::ByamlSchemaField{ key, vp::res::TGetByamlDataTypeValue<decltype(struct_type::member)>(), static_cast<u32>(offsetof(struct_type, member)), static_cast<u32>(sizeof(struct_type::member)) }
+
+    namespace impl {
+
+        /* Matches strcmp ordering so sorted fields line up with the sorted key table */
+        constexpr ALWAYS_INLINE s32 CompareByamlSchemaKey(const char *lhs, const char *rhs) {
+            while (*lhs != '\0' && *lhs == *rhs) {
+                lhs = lhs + 1;
+                rhs = rhs + 1;
+            }
+            return static_cast<s32>(static_cast<unsigned char>(*lhs)) - static_cast<s32>(static_cast<unsigned char>(*rhs));
+        }
+    }
+
+    template <typename T, size_t FieldCount>
+    class ByamlSchema {
+        public:
+            static constexpr size_t cFieldCount = FieldCount;
+        public:
+            using StructType = T;
+        private:
+            std::array<ByamlSchemaField, FieldCount> m_field_array;
+            std::array<u32, FieldCount>              m_sorted_field_index_array;
+        public:
+            consteval ByamlSchema(const ByamlSchemaField (&field_array)[FieldCount]) : m_field_array(), m_sorted_field_index_array() {
+
+                /* Copy fields in declaration order */
+                for (u32 i = 0; i < FieldCount; ++i) {
+                    m_field_array[i]              = field_array[i];
+                    m_sorted_field_index_array[i] = i;
+                }
+
+                /* Insertion sort field indices by key */
+                for (u32 i = 1; i < FieldCount; ++i) {
+                    const u32 field_index = m_sorted_field_index_array[i];
+                    u32       j           = i;
+                    while (0 < j && 0 < impl::CompareByamlSchemaKey(m_field_array[m_sorted_field_index_array[j - 1]].key, m_field_array[field_index].key)) {
+                        m_sorted_field_index_array[j] = m_sorted_field_index_array[j - 1];
+                        --j;
+                    }
+                    m_sorted_field_index_array[j] = field_index;
+                }
+
+                /* Duplicate keys are invalid */
+                for (u32 i = 1; i < FieldCount; ++i) {
+                    if (impl::CompareByamlSchemaKey(m_field_array[m_sorted_field_index_array[i - 1]].key, m_field_array[m_sorted_field_index_array[i]].key) == 0) { vp::util::_consteval_fail(); }
+                }
+            }
+
+            constexpr ALWAYS_INLINE const ByamlSchemaField &GetField(u32 field_index)       const { return m_field_array[field_index]; }
+            constexpr ALWAYS_INLINE const ByamlSchemaField &GetSortedField(u32 sorted_index) const { return m_field_array[m_sorted_field_index_array[sorted_index]]; }
+            constexpr ALWAYS_INLINE u32                     GetSortedFieldIndex(u32 sorted_index) const { return m_sorted_field_index_array[sorted_index]; }
+    };
+
+    template <typename T, size_t FieldCount>
+    consteval ByamlSchema<T, FieldCount> MakeByamlSchema(const ByamlSchemaField (&field_array)[FieldCount]) {
+        return ByamlSchema<T, FieldCount>(field_array);
+    }
+
+    /* Schema keys present in a single byaml file resolved to key indices in sorted order, with the field each decodes to */
+    template <typename T, size_t FieldCount>
+    struct ByamlSchemaBinding {
+        const ResByaml                   *byaml;
+        const ByamlSchema<T, FieldCount> *schema;
+        u32                               bound_count;
+        u32                               key_index_array[FieldCount];
+        u32                               field_index_array[FieldCount];
+    };
+
+    /* Structure of arrays output for batch decodes, each array is indexed by element and laid out by field size */
+    template <size_t FieldCount>
+    struct ByamlSchemaSoaStorage {
+        void *field_array[FieldCount];
+        u32   element_count;
+    };
+}
@@ -99,4 +99,68 @@ namespace vp::res {
         }
     };
     static_assert(sizeof(ResNintendoWareDictionary) == 0x18);
+
+    /* Open addressing hash side table over a relocated dictionary, keyed on the murmur3 hash of each key */
+    class ResNintendoWareDictionaryHashTable {
+        public:
+            static constexpr u32 cInvalidEntryIndex = ResNintendoWareDictionary::cInvalidEntryIndex;
+            static constexpr u32 cMinimumSlotCount  = 4;
+        public:
+            struct HashSlot {
+                u32 key_hash;
+                u32 entry_index;
+            };
+            static_assert(sizeof(HashSlot) == 0x8);
+        private:
+            const ResNintendoWareDictionary *m_dictionary;
+            HashSlot                        *m_slot_array;
+            u32                              m_slot_mask;
+        public:
+            constexpr ResNintendoWareDictionaryHashTable() : m_dictionary(nullptr), m_slot_array(nullptr), m_slot_mask(0) {/*...*/}
+            constexpr ~ResNintendoWareDictionaryHashTable() {/*...*/}
+
+            static constexpr u32 CalculateSlotCount(u32 node_count) {
+                const u32 slot_count = std::bit_ceil(node_count * 2);
+                return (slot_count < cMinimumSlotCount) ? cMinimumSlotCount : slot_count;
+            }
+
+            static constexpr size_t GetWorkMemorySize(const ResNintendoWareDictionary *dictionary) {
+                const u32 node_count = (0 < dictionary->node_count) ? dictionary->node_count : 0;
+                return CalculateSlotCount(node_count) * sizeof(HashSlot);
+            }
+
+            void Initialize(const ResNintendoWareDictionary *dictionary, void *work_memory, size_t work_memory_size);
+
+            void Finalize() {
+                m_dictionary = nullptr;
+                m_slot_array = nullptr;
+                m_slot_mask  = 0;
+            }
+
+            /* Key hash may be precomputed with util::HashMurmur3 to resolve names ahead of time */
+            u32 TryGetEntryIndexByKey(const char *key, u32 key_hash) const {
+
+                /* Probe until the key or an empty slot is found */
+                u32 slot_index = key_hash & m_slot_mask;
+                for (;;) {
+                    const HashSlot *slot = std::addressof(m_slot_array[slot_index]);
+                    if (slot->entry_index == cInvalidEntryIndex) { return cInvalidEntryIndex; }
+
+                    /* Compare key */
+                    if (slot->key_hash == key_hash) {
+                        const char *entry_key    = m_dictionary->GetKeyByEntryIndex(slot->entry_index);
+                        const u16   entry_length = *reinterpret_cast<const u16*>(entry_key);
+                        if (::strncmp(entry_key + 2, key, entry_length) == 0 && key[entry_length] == '\0') { return slot->entry_index; }
+                    }
+
+                    slot_index = (slot_index + 1) & m_slot_mask;
+                }
+            }
+            u32 TryGetEntryIndexByKey(const char *key) const {
+                if (key == nullptr) { key = ""; }
+                return this->TryGetEntryIndexByKey(key, util::HashMurmur3(key));
+            }
+
+            constexpr const ResNintendoWareDictionary *GetDictionary() const { return m_dictionary; }
+    };
 }
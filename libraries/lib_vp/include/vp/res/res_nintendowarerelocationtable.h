@@ -70,7 +70,72 @@ namespace vp::res {
             return reinterpret_cast<const ResSection*>(reinterpret_cast<uintptr_t>(this) + sizeof(ResNintendoWareRelocationTable) + section_index * sizeof(ResSection)); 
         }
 
+        ALWAYS_INLINE u32 GetSectionCount() const { return section_count; }
+
+        s32 FindSectionIndex(const void *address);
+
+        /* Relocates a single section or range of sections without touching the file relocation guard */
+        void RelocateSection(u32 section_index);
+        void RelocateSectionRange(u32 base_section_index, u32 section_count);
+
         void Relocate();
         void Unrelocate();
 	};
+
+    /* Relocates a range of sections as a job, file relocation guard must be set by the user once every job has completed */
+    class ResNintendoWareRelocationJob : public util::Job {
+        private:
+            ResNintendoWareRelocationTable *m_relocation_table;
+            u32                             m_base_section_index;
+            u32                             m_section_count;
+        public:
+            constexpr ResNintendoWareRelocationJob() : Job("ResNintendoWareRelocationJob"), m_relocation_table(nullptr), m_base_section_index(0), m_section_count(0) {/*...*/}
+            constexpr ~ResNintendoWareRelocationJob() {/*...*/}
+
+            constexpr void Initialize(ResNintendoWareRelocationTable *relocation_table, u32 base_section_index, u32 section_count) {
+                m_relocation_table   = relocation_table;
+                m_base_section_index = base_section_index;
+                m_section_count      = section_count;
+            }
+
+            virtual void Invoke() override {
+                m_relocation_table->RelocateSectionRange(m_base_section_index, m_section_count);
+            }
+    };
+
+    /* Defers relocation of each section until first access, safe to use across threads */
+    class ResNintendoWareLazyRelocator {
+        public:
+            enum SectionState : u32 {
+                SectionState_Unrelocated = 0,
+                SectionState_Relocating  = 1,
+                SectionState_Relocated   = 2,
+            };
+        private:
+            ResNintendoWareRelocationTable *m_relocation_table;
+            u32                            *m_section_state_array;
+            u32                             m_relocated_section_count;
+        public:
+            constexpr ResNintendoWareLazyRelocator() : m_relocation_table(nullptr), m_section_state_array(nullptr), m_relocated_section_count(0) {/*...*/}
+            constexpr ~ResNintendoWareLazyRelocator() {/*...*/}
+
+            static constexpr size_t GetWorkMemorySize(const ResNintendoWareRelocationTable *relocation_table) {
+                return relocation_table->section_count * sizeof(u32);
+            }
+
+            void Initialize(ResNintendoWareRelocationTable *relocation_table, void *work_memory, size_t work_memory_size);
+
+            void Finalize() {
+                m_relocation_table        = nullptr;
+                m_section_state_array     = nullptr;
+                m_relocated_section_count = 0;
+            }
+
+            void RelocateSection(u32 section_index);
+            void RelocateAddress(const void *address);
+
+            bool IsSectionRelocated(u32 section_index) const {
+                return util::InterlockedLoadAcquire(std::addressof(m_section_state_array[section_index])) == SectionState_Relocated;
+            }
+    };
 }
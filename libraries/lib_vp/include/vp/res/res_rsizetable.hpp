@@ -23,6 +23,12 @@ namespace vp::res {
     };
     static_assert(sizeof(ResRsizetableCrc32) == 0x8);
 
+    struct ResRsizetablePerfectHashCollision {
+        u32 string_offset;
+        u32 resource_size;
+    };
+    static_assert(sizeof(ResRsizetablePerfectHashCollision) == 0x8);
+
 	struct ResRsizetableOld {
 		u32                magic;
         u32                resource_size_crc32_count;
@@ -56,8 +62,63 @@ namespace vp::res {
         }
 	};
     static_assert(sizeof(ResRsizetable) == 0x16);
+
+    /* Minimal perfect hash layout, crc32 keys are bucketed then displaced into a slot by a per bucket pilot */
+    struct ResRsizetablePerfectHash {
+		u32                magic0;
+        u16                magic1;
+        u32                version;
+        u32                hash_seed;
+        u32                entry_count;
+        u32                bucket_count;
+        u32                collision_count;
+        u32                string_pool_size;
+        u16                reserve0;
+        u32                pilot_array[];
+
+        static constexpr inline u32 cTargetVersion = 2;
+
+        ALWAYS_INLINE u16 *GetFingerprintArray() {
+            return reinterpret_cast<u16*>(reinterpret_cast<uintptr_t>(this) + sizeof(ResRsizetablePerfectHash) + bucket_count * sizeof(u32));
+        }
+        ALWAYS_INLINE u32 *GetSizeArray() {
+            return reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(this->GetFingerprintArray()) + util::AlignUp(entry_count * sizeof(u16), alignof(u32)));
+        }
+        ALWAYS_INLINE ResRsizetablePerfectHashCollision *GetCollisionArray() {
+            return (collision_count != 0) ? reinterpret_cast<ResRsizetablePerfectHashCollision*>(this->GetSizeArray() + entry_count) : nullptr;
+        }
+        ALWAYS_INLINE const char *GetStringPool() {
+            return reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(this->GetSizeArray() + entry_count) + collision_count * sizeof(ResRsizetablePerfectHashCollision));
+        }
+
+        static constexpr size_t CalculateSize(u32 entry_count, u32 bucket_count, u32 collision_count, u32 string_pool_size) {
+            return sizeof(ResRsizetablePerfectHash) + bucket_count * sizeof(u32) + util::AlignUp(entry_count * sizeof(u16), alignof(u32)) + entry_count * sizeof(u32) + collision_count * sizeof(ResRsizetablePerfectHashCollision) + string_pool_size;
+        }
+    };
+    static_assert(sizeof(ResRsizetablePerfectHash) == 0x20);
     #pragma pack()
 
+    /* Perfect hash functions shared by the builder and extractor */
+    constexpr inline u32 cRsizetablePilotDirectSlot = 0x8000'0000;
+    constexpr inline u32 cRsizetableCollisionSize   = 0xffff'fffe;
+
+    constexpr ALWAYS_INLINE u64 MixRsizetableHash(u32 path_crc32, u32 seed) {
+        u64 state = ((static_cast<u64>(seed) << 32) | path_crc32) * 0x9e37'79b9'7f4a'7c15;
+        state = (state ^ (state >> 32)) * 0xd6e8'feb8'6659'fd93;
+        return state ^ (state >> 32);
+    }
+    constexpr ALWAYS_INLINE u32 CalculateRsizetableBucket(u64 key_hash, u32 bucket_count) {
+        return static_cast<u32>((static_cast<u64>(static_cast<u32>(key_hash)) * bucket_count) >> 32);
+    }
+    constexpr ALWAYS_INLINE u16 CalculateRsizetableFingerprint(u64 key_hash) {
+        return static_cast<u16>(key_hash >> 48);
+    }
+    constexpr ALWAYS_INLINE u32 CalculateRsizetableSlot(u32 path_crc32, u32 seed, u32 pilot, u32 entry_count) {
+        if ((pilot & cRsizetablePilotDirectSlot) != 0) { return pilot & ~cRsizetablePilotDirectSlot; }
+        const u64 slot_hash = MixRsizetableHash(path_crc32, seed + 1 + pilot);
+        return static_cast<u32>(((slot_hash >> 32) * entry_count) >> 32);
+    }
+
     class ResourceSizeTableExtractor {
         public:
             static constexpr inline u32 cInvalidSize      = 0xffff'ffff;
@@ -69,8 +130,14 @@ namespace vp::res {
             u32                 m_resource_size_collision_count;
             u32                 m_max_path;
             void               *m_head;
+            u32                *m_pilot_array;
+            u16                *m_fingerprint_array;
+            u32                *m_size_array;
+            const char         *m_string_pool;
+            u32                 m_bucket_count;
+            u32                 m_hash_seed;
         public:
-            constexpr ALWAYS_INLINE ResourceSizeTableExtractor() : m_resource_size_crc32_array(nullptr), m_resource_size_collision_array(nullptr), m_resource_size_crc32_count(0), m_resource_size_collision_count(0), m_max_path(0), m_head() {/*...*/}
+            constexpr ALWAYS_INLINE ResourceSizeTableExtractor() : m_resource_size_crc32_array(nullptr), m_resource_size_collision_array(nullptr), m_resource_size_crc32_count(0), m_resource_size_collision_count(0), m_max_path(0), m_head(), m_pilot_array(nullptr), m_fingerprint_array(nullptr), m_size_array(nullptr), m_string_pool(nullptr), m_bucket_count(0), m_hash_seed(0) {/*...*/}
             constexpr ~ResourceSizeTableExtractor() {/*...*/}
 
             bool Initialize(void *file, u32 file_size, u32 max_path_length = 0xffff'ffff) {
@@ -80,7 +147,21 @@ namespace vp::res {
 
                 /* Find header type */
                 const u32 magic = *reinterpret_cast<u32*>(file);
-                if (magic == ResRsizetable::cMagic0 && *(reinterpret_cast<u16*>(file) + 2) == ResRsizetable::cMagic1){
+                if (magic == ResRsizetable::cMagic0 && *(reinterpret_cast<u16*>(file) + 2) == ResRsizetable::cMagic1 && reinterpret_cast<ResRsizetable*>(file)->version == ResRsizetablePerfectHash::cTargetVersion) {
+
+                    /* Parse perfect hash table */
+                    ResRsizetablePerfectHash *table = reinterpret_cast<ResRsizetablePerfectHash*>(file);
+                    if (file_size < sizeof(ResRsizetablePerfectHash) || file_size < ResRsizetablePerfectHash::CalculateSize(table->entry_count, table->bucket_count, table->collision_count, table->string_pool_size)) { return false; }
+                    m_pilot_array                   = table->pilot_array;
+                    m_fingerprint_array             = table->GetFingerprintArray();
+                    m_size_array                    = table->GetSizeArray();
+                    m_string_pool                   = table->GetStringPool();
+                    m_bucket_count                  = table->bucket_count;
+                    m_hash_seed                     = table->hash_seed;
+                    m_resource_size_collision_array = table->GetCollisionArray();
+                    m_resource_size_crc32_count     = table->entry_count;
+                    m_resource_size_collision_count = table->collision_count;
+                } else if (magic == ResRsizetable::cMagic0 && *(reinterpret_cast<u16*>(file) + 2) == ResRsizetable::cMagic1){
 
                     /* Parse table */
                     ResRsizetable *table = reinterpret_cast<ResRsizetable*>(file);
@@ -117,12 +198,24 @@ namespace vp::res {
                 m_resource_size_crc32_count     = 0;
                 m_resource_size_collision_count = 0;
                 m_max_path                      = 0;
+                m_pilot_array                   = nullptr;
+                m_fingerprint_array             = nullptr;
+                m_size_array                    = nullptr;
+                m_string_pool                   = nullptr;
+                m_bucket_count                  = 0;
+                m_hash_seed                     = 0;
             }
 
+            constexpr bool IsPerfectHash() const { return m_pilot_array != nullptr; }
+
             u32 TryGetResourceSize(const char *path) {
 
                 /* Try to get size by crc32 */
                 const u32 hash = vp::util::HashCrc32b(path);
+                if (this->IsPerfectHash() == true) {
+                    const u32 size = this->TryGetResourceSizeByPerfectHash(hash);
+                    return (size == cRsizetableCollisionSize) ? this->TryGetResourceSizeByPathCollision(path) : size;
+                }
                 const u32 size = this->TryGetResourceSizeByCrc32(hash);
 
                 /* Complete if the size was found */
@@ -137,6 +230,24 @@ namespace vp::res {
                 /* Integrity checks for collision table */
                 if (m_resource_size_collision_array == nullptr || m_resource_size_collision_count == 0) { return cInvalidSize; }
 
+                /* Perfect hash collisions are sorted path offsets into the string pool */
+                if (this->IsPerfectHash() == true) {
+                    const ResRsizetablePerfectHashCollision *path_collision_array = reinterpret_cast<const ResRsizetablePerfectHashCollision*>(m_resource_size_collision_array);
+                    u32 low_iter  = 0;
+                    u32 high_iter = m_resource_size_collision_count;
+                    while (low_iter < high_iter) {
+                        const u32 index  = (low_iter + high_iter) >> 1;
+                        const s32 result = ::strcmp(path, m_string_pool + path_collision_array[index].string_offset);
+                        if (result == 0) { return path_collision_array[index].resource_size; }
+                        if (0 < result) {
+                            low_iter = index + 1;
+                        } else {
+                            high_iter = index;
+                        }
+                    }
+                    return cInvalidSize;
+                }
+
                 /* Get collision array */
                 const size_t collision_size  = sizeof(u32) + m_max_path;
                 uintptr_t    collision_array = reinterpret_cast<uintptr_t>(m_resource_size_collision_array);
@@ -163,8 +274,28 @@ namespace vp::res {
 
                 return cInvalidSize;
             }
+            constexpr u32 TryGetResourceSizeByPerfectHash(u32 hash_crc32) {
+
+                /* Integrity checks for perfect hash table */
+                if (m_pilot_array == nullptr || m_resource_size_crc32_count == 0) { return cInvalidSize; }
+
+                /* Single probe, non-members are rejected by the fingerprint with a false positive rate of 2^-16 */
+                const u64 key_hash = MixRsizetableHash(hash_crc32, m_hash_seed);
+                const u32 bucket   = CalculateRsizetableBucket(key_hash, m_bucket_count);
+                const u32 slot     = CalculateRsizetableSlot(hash_crc32, m_hash_seed, m_pilot_array[bucket], m_resource_size_crc32_count);
+                if (slot >= m_resource_size_crc32_count || m_fingerprint_array[slot] != CalculateRsizetableFingerprint(key_hash)) { return cInvalidSize; }
+
+                return m_size_array[slot];
+            }
+
             constexpr u32 TryGetResourceSizeByCrc32(u32 hash_crc32) {
 
+                /* Perfect hash tables do not resolve crc32 collisions */
+                if (m_pilot_array != nullptr) {
+                    const u32 size = this->TryGetResourceSizeByPerfectHash(hash_crc32);
+                    return (size == cRsizetableCollisionSize) ? cInvalidSize : size;
+                }
+
                 /* Integrity checks for hash table */
                 if (m_resource_size_crc32_array == nullptr || m_resource_size_crc32_count == 0) { return cInvalidSize; }
 
@@ -117,6 +117,10 @@ namespace vp::res {
 
         void SwapEndian() {
 
+            /* Get file count before the swap */
+            ResSarcSfat *sfat       = this->GetSfat();
+            const u32    file_count = (this->IsReverseEndian() == false) ? sfat->file_count : vp::util::SwapEndian(sfat->file_count);
+
             /* Swap header */
             magic               = vp::util::SwapEndian(magic);
             header_size         = vp::util::SwapEndian(header_size);
@@ -126,42 +130,147 @@ namespace vp::res {
             version             = vp::util::SwapEndian(version);
 
             /* Swap sfat */
-            ResSarcSfat *sfat = this->GetSfat();
-
             sfat->magic        = vp::util::SwapEndian(sfat->magic);
             sfat->header_size  = vp::util::SwapEndian(sfat->header_size);
             sfat->file_count   = vp::util::SwapEndian(sfat->file_count);
             sfat->hash_seed    = vp::util::SwapEndian(sfat->hash_seed);
 
-            for (u32 i = 0; i < sfat->file_count; ++i) {
-                sfat->entry_array[i].file_name_hash          = vp::util::SwapEndian(sfat->entry_array[i].file_name_hash);
-                sfat->entry_array[i].name_data               = vp::util::SwapEndian(sfat->entry_array[i].name_data);
-                sfat->entry_array[i].file_array_start_offset = vp::util::SwapEndian(sfat->entry_array[i].file_array_start_offset);
-                sfat->entry_array[i].file_array_end_offset   = vp::util::SwapEndian(sfat->entry_array[i].file_array_end_offset);
-            }
+            /* Sfat entries are all u32 members, so swap them as one u32 array */
+            vp::util::SwapEndianArray(reinterpret_cast<u32*>(sfat->entry_array), file_count * (sizeof(ResSarcSfatEntry) / sizeof(u32)));
 
             /* Swap sfnt */
-            ResSarcSfnt *sfnt = reinterpret_cast<ResSarcSfnt*>(reinterpret_cast<uintptr_t>(this) + sizeof(ResSarc) + sizeof(ResSarcSfat) + sizeof(ResSarcSfatEntry) * sfat->file_count);
-            
-            sfnt->magic        = vp::util::SwapEndian(sfat->magic);
-            sfnt->header_size  = vp::util::SwapEndian(sfat->header_size);
+            ResSarcSfnt *sfnt = reinterpret_cast<ResSarcSfnt*>(reinterpret_cast<uintptr_t>(this) + sizeof(ResSarc) + sizeof(ResSarcSfat) + sizeof(ResSarcSfatEntry) * file_count);
+
+            sfnt->magic        = vp::util::SwapEndian(sfnt->magic);
+            sfnt->header_size  = vp::util::SwapEndian(sfnt->header_size);
 
             return;
         }
+
+        /* Swaps a reverse endian archive to native endian in place, the file memory must be writable */
+        void NormalizeEndian() {
+            if (this->IsReverseEndian() == false) { return; }
+            this->SwapEndian();
+        }
     };
     static_assert(sizeof(ResSarc) == 0x14);
 
-    class SarcExtractor {
+    template <bool IsNativeEndianOnly>
+    class SarcExtractorBase {
+        public:
+            static constexpr u32 cInvalidEntryIndex       = 0xFFFF'FFFF;
+            static constexpr u32 cLookupIndexMinFileCount = 0x40;
         public:
-            static constexpr u32 cInvalidEntryIndex = 0xFFFF'FFFF;
+            struct LookupEntry {
+                u32 file_name_hash;
+                u32 entry_index;
+            };
+            static_assert(sizeof(LookupEntry) == 0x8);
         private:
             ResSarc          *m_sarc;
             ResSarcSfat      *m_sfat;
             void             *m_file_region;
             char             *m_path_table;
+            LookupEntry      *m_lookup_array;
+            u32               m_lookup_count;
+            u32               m_hash_seed;
+        private:
+            constexpr u32 BuildLookupIndex(u32 sorted_index, u32 lookup_index) {
+
+                /* In order traversal of the implicit tree places sorted hashes in eytzinger order */
+                if (m_lookup_count < lookup_index) { return sorted_index; }
+
+                sorted_index = this->BuildLookupIndex(sorted_index, lookup_index << 1);
+
+                const bool is_reverse_endian = this->IsReverseEndian();
+                const u32  file_name_hash    = m_sfat->entry_array[sorted_index].file_name_hash;
+                m_lookup_array[lookup_index].file_name_hash = (is_reverse_endian == false) ? file_name_hash : vp::util::SwapEndian(file_name_hash);
+                m_lookup_array[lookup_index].entry_index    = sorted_index;
+
+                return this->BuildLookupIndex(sorted_index + 1, (lookup_index << 1) + 1);
+            }
+
+            u32 TryGetEntryIndexByLookupIndex(const char *path) const {
+
+                /* Calculate file path hash */
+                const char *path_iter = path;
+                u32         hash      = 0;
+                while (*path_iter != '\0') {
+                    hash      = hash * m_hash_seed + static_cast<int>(*path_iter);
+                    path_iter = path_iter + 1;
+                }
+
+                /* Branchless eytzinger lower bound, prefetching the descendants four levels down */
+                const LookupEntry *lookup_array = m_lookup_array;
+                const u32          lookup_count = m_lookup_count;
+                u32 lookup_index = 1;
+                while (lookup_index <= lookup_count) {
+                    __builtin_prefetch(lookup_array + (lookup_index << 4));
+                    lookup_index = (lookup_index << 1) + (lookup_array[lookup_index].file_name_hash < hash);
+                }
+                lookup_index = lookup_index >> __builtin_ffs(~lookup_index);
+                if (lookup_index == 0 || lookup_array[lookup_index].file_name_hash != hash) { return cInvalidEntryIndex; }
+
+                /* The lower bound is the first entry of any collisions */
+                u32 entry_index = lookup_array[lookup_index].entry_index;
+                if (entry_index + 1 == lookup_count || this->GetFileNameHash(entry_index + 1) != hash) { return entry_index; }
+
+                /* Linear search collisions */
+                while (entry_index < lookup_count && this->GetFileNameHash(entry_index) == hash) {
+                    const char *file_path = this->TryGetPathByEntryIndex(entry_index);
+                    if (file_path == nullptr)           { return cInvalidEntryIndex; }
+                    if (::strcmp(path, file_path) == 0) { return entry_index; }
+                    ++entry_index;
+                }
+
+                return cInvalidEntryIndex;
+            }
+
+            constexpr ALWAYS_INLINE bool IsReverseEndian() const {
+                if constexpr (IsNativeEndianOnly == true) {
+                    return false;
+                } else {
+                    return m_sarc->IsReverseEndian();
+                }
+            }
+
+            constexpr ALWAYS_INLINE u32 GetFileNameHash(u32 entry_index) const {
+                const u32 file_name_hash = m_sfat->entry_array[entry_index].file_name_hash;
+                return (this->IsReverseEndian() == false) ? file_name_hash : vp::util::SwapEndian(file_name_hash);
+            }
         public:
-            constexpr  SarcExtractor() : m_sarc(nullptr), m_sfat(nullptr), m_file_region(nullptr), m_path_table(nullptr) {/*...*/}
-            constexpr ~SarcExtractor() {/*...*/}
+            constexpr  SarcExtractorBase() : m_sarc(nullptr), m_sfat(nullptr), m_file_region(nullptr), m_path_table(nullptr), m_lookup_array(nullptr), m_lookup_count(0), m_hash_seed(0) {/*...*/}
+            constexpr ~SarcExtractorBase() {/*...*/}
+
+            static constexpr ALWAYS_INLINE size_t GetLookupIndexSize(u32 file_count) {
+                return sizeof(LookupEntry) * (file_count + 1);
+            }
+
+            /* Builds an optional native endian side index for lookups by path, the memory must outlive the extractor */
+            bool InitializeLookupIndex(void *index_memory, size_t index_memory_size) {
+
+                /* Integrity checks */
+                if (m_sarc == nullptr || index_memory == nullptr) { return false; }
+
+                const u32 file_count = this->GetFileCount();
+                if (file_count == 0 || index_memory_size < GetLookupIndexSize(file_count)) { return false; }
+
+                /* Build index */
+                m_lookup_array = reinterpret_cast<LookupEntry*>(index_memory);
+                m_lookup_count = file_count;
+                m_hash_seed    = (this->IsReverseEndian() == false) ? m_sfat->hash_seed : vp::util::SwapEndian(m_sfat->hash_seed);
+                m_lookup_array[0] = {};
+                this->BuildLookupIndex(0, 1);
+
+                return true;
+            }
+
+            void *FinalizeLookupIndex() {
+                void *index_memory = m_lookup_array;
+                m_lookup_array = nullptr;
+                m_lookup_count = 0;
+                return index_memory;
+            }
 
             bool Initialize(void *sarc_file) {
 
@@ -169,13 +278,20 @@ namespace vp::res {
                 if (sarc_file == nullptr) { return false; }
 
                 /* Cast sarc */
-                m_sarc = reinterpret_cast<ResSarc*>(sarc_file);
+                m_sarc         = reinterpret_cast<ResSarc*>(sarc_file);
+                m_lookup_array = nullptr;
+                m_lookup_count = 0;
 
                 /* Validate sarc */
                 if (m_sarc->IsValid() == false) { return false; }
 
+                /* Native endian extractors require a normalized archive */
+                if constexpr (IsNativeEndianOnly == true) {
+                    if (m_sarc->IsReverseEndian() == true) { return false; }
+                }
+
                 /* Endianess check */
-                const bool is_reverse_endian = m_sarc->IsReverseEndian();
+                const bool is_reverse_endian = this->IsReverseEndian();
 
                 /* Get sfat */
                 m_sfat = reinterpret_cast<ResSarcSfat*>(reinterpret_cast<uintptr_t>(sarc_file) + sizeof(ResSarc));
@@ -204,7 +320,7 @@ namespace vp::res {
             constexpr const char *TryGetPathByEntryIndex(u32 entry_index) const {
 
                 /* Endianess check */
-                const bool is_reverse_endian = m_sarc->IsReverseEndian();
+                const bool is_reverse_endian = this->IsReverseEndian();
 
                 /* Integrity check file count */
                 const u32 file_count = (is_reverse_endian == false) ? m_sfat->file_count : vp::util::SwapEndian(m_sfat->file_count);
@@ -220,8 +336,11 @@ namespace vp::res {
 
             constexpr u32 TryGetEntryIndexByPath(const char *path) const {
 
+                /* Use the side index if built */
+                if (m_lookup_array != nullptr) { return this->TryGetEntryIndexByLookupIndex(path); }
+
                 /* Endianess check */
-                const bool is_reverse_endian = m_sarc->IsReverseEndian();
+                const bool is_reverse_endian = this->IsReverseEndian();
 
                 /* Error on null file count */
                 const u32 file_count = (is_reverse_endian == false) ? m_sfat->file_count : vp::util::SwapEndian(m_sfat->file_count);
@@ -294,7 +413,7 @@ namespace vp::res {
             void *TryGetFileByIndex(u32 *out_file_size, u32 entry_index) {
 
                 /* Endianess check */
-                const bool is_reverse_endian = m_sarc->IsReverseEndian();
+                const bool is_reverse_endian = this->IsReverseEndian();
 
                 /* Integrity check bounds */
                 const u32 file_count = (is_reverse_endian == false) ? m_sfat->file_count : vp::util::SwapEndian(m_sfat->file_count);
@@ -323,8 +442,10 @@ namespace vp::res {
             }
             
             constexpr ALWAYS_INLINE u32 GetFileCount() const {
-                const bool is_reverse_endian = m_sarc->IsReverseEndian();
+                const bool is_reverse_endian = this->IsReverseEndian();
                 return (is_reverse_endian == false) ? m_sfat->file_count : vp::util::SwapEndian(m_sfat->file_count); 
             }
     };
+    using SarcExtractor       = SarcExtractorBase<false>;
+    using NativeSarcExtractor = SarcExtractorBase<true>;
 }
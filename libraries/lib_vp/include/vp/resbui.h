@@ -18,12 +18,14 @@
 #include <vp/resbui/resbui_bufferlocation.hpp>
 #include <vp/resbui/resbui_rsizetablebuilder.hpp>
 #include <vp/resbui/resbui_sarcbuilder.hpp>
+#include <vp/resbui/resbui_szsbuilder.hpp>
 
 #include <vp/resbui/resbui_stringpoolstring.hpp>
 #include <vp/resbui/resbui_byamlstringpool.hpp>
 #include <vp/resbui/resbui_byamlnode.hpp>
 #include <vp/resbui/resbui_byamlbigdatanode.hpp>
 #include <vp/resbui/resbui_byamlbuilder.hpp>
+#include <vp/resbui/resbui_byamlstreamwriter.hpp>
 
 #ifdef VP_64_BIT
     #include <vp/resbui/resbui_nintendowarerelocationtablestream.hpp>
@@ -0,0 +1,567 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::resbui {
+
+    namespace impl {
+
+        class ByamlStreamBuffer {
+            public:
+                static constexpr size_t cMinimumCapacity = 0x1000;
+                static constexpr size_t cMaxCapacity     = 0xffff'ffff;
+            private:
+                void        *m_buffer;
+                u32          m_size;
+                u32          m_capacity;
+                imem::IHeap *m_heap;
+            public:
+                constexpr  ByamlStreamBuffer() : m_buffer(nullptr), m_size(0), m_capacity(0), m_heap(nullptr) {/*...*/}
+                constexpr ~ByamlStreamBuffer() {/*...*/}
+
+                constexpr void Initialize(imem::IHeap *heap) {
+                    m_heap = heap;
+                }
+
+                void Finalize() {
+                    if (m_buffer != nullptr) {
+                        ::operator delete(m_buffer);
+                    }
+                    m_buffer   = nullptr;
+                    m_size     = 0;
+                    m_capacity = 0;
+                }
+
+                bool TryReserve(size_t size) {
+
+                    /* Nothing to do if the capacity is large enough */
+                    if (size <= m_capacity) { return true; }
+                    if (cMaxCapacity < size) { return false; }
+
+                    /* Grow geometrically */
+                    size_t new_capacity = (m_capacity < cMinimumCapacity) ? cMinimumCapacity : m_capacity;
+                    while (new_capacity < size) { new_capacity = new_capacity << 1; }
+                    new_capacity = (cMaxCapacity < new_capacity) ? cMaxCapacity : new_capacity;
+
+                    /* Allocate and move the buffer */
+                    void *new_buffer = ::operator new(new_capacity, m_heap, alignof(u64));
+                    if (new_buffer == nullptr) { return false; }
+
+                    if (m_buffer != nullptr) {
+                        ::memcpy(new_buffer, m_buffer, m_size);
+                        ::operator delete(m_buffer);
+                    }
+                    m_buffer   = new_buffer;
+                    m_capacity = static_cast<u32>(new_capacity);
+
+                    return true;
+                }
+
+                /* Returns a pointer to size new bytes, valid until the next append */
+                void *TryAppend(size_t size) {
+                    if (this->TryReserve(m_size + size) == false) { return nullptr; }
+                    void *append = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(m_buffer) + m_size);
+                    m_size = static_cast<u32>(m_size + size);
+                    return append;
+                }
+
+                constexpr void Shrink(u32 size) {
+                    m_size = (size < m_size) ? size : m_size;
+                }
+
+                template <typename T>
+                constexpr ALWAYS_INLINE T *GetPointer(u32 offset) const {
+                    return reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(m_buffer) + offset);
+                }
+
+                constexpr ALWAYS_INLINE u32 GetSize() const { return m_size; }
+        };
+
+        class ByamlStreamStringTable {
+            public:
+                static constexpr u32 cInvalidIndex     = 0xffff'ffff;
+                static constexpr u32 cMinimumSlotCount = 0x100;
+            private:
+                struct Entry {
+                    u32 hash;
+                    u32 string_offset;
+                    u32 length;
+                };
+            private:
+                ByamlStreamBuffer  m_string_buffer;
+                ByamlStreamBuffer  m_entry_buffer;
+                u32               *m_slot_array;
+                u32                m_slot_mask;
+                u32                m_count;
+                imem::IHeap       *m_heap;
+            private:
+                bool TryGrowSlotArray() {
+
+                    /* Allocate a slot array of twice the size */
+                    const u32 new_slot_count = (m_slot_array == nullptr) ? cMinimumSlotCount : (m_slot_mask + 1) << 1;
+                    u32 *new_slot_array      = reinterpret_cast<u32*>(::operator new(sizeof(u32) * new_slot_count, m_heap, alignof(u32)));
+                    if (new_slot_array == nullptr) { return false; }
+                    ::memset(new_slot_array, 0xff, sizeof(u32) * new_slot_count);
+
+                    /* Reinsert every string by its cached hash */
+                    const u32    new_slot_mask = new_slot_count - 1;
+                    const Entry *entry_array   = m_entry_buffer.GetPointer<Entry>(0);
+                    for (u32 i = 0; i < m_count; ++i) {
+                        u32 slot = entry_array[i].hash & new_slot_mask;
+                        while (new_slot_array[slot] != cInvalidIndex) { slot = (slot + 1) & new_slot_mask; }
+                        new_slot_array[slot] = i;
+                    }
+
+                    if (m_slot_array != nullptr) {
+                        ::operator delete(m_slot_array);
+                    }
+                    m_slot_array = new_slot_array;
+                    m_slot_mask  = new_slot_mask;
+
+                    return true;
+                }
+            public:
+                constexpr  ByamlStreamStringTable() : m_string_buffer(), m_entry_buffer(), m_slot_array(nullptr), m_slot_mask(0), m_count(0), m_heap(nullptr) {/*...*/}
+                constexpr ~ByamlStreamStringTable() {/*...*/}
+
+                constexpr void Initialize(imem::IHeap *heap) {
+                    m_heap = heap;
+                    m_string_buffer.Initialize(heap);
+                    m_entry_buffer.Initialize(heap);
+                }
+
+                void Finalize() {
+                    if (m_slot_array != nullptr) {
+                        ::operator delete(m_slot_array);
+                    }
+                    m_slot_array = nullptr;
+                    m_slot_mask  = 0;
+                    m_count      = 0;
+                    m_string_buffer.Finalize();
+                    m_entry_buffer.Finalize();
+                }
+
+                Result TryAddString(u32 *out_index, const char *string) {
+
+                    /* Integrity checks */
+                    RESULT_RETURN_IF(string == nullptr, ResultNullArgument);
+
+                    /* Keep the load factor at or under a half */
+                    if (m_slot_array == nullptr || (m_slot_mask + 1) < (m_count + 1) * 2) {
+                        RESULT_RETURN_UNLESS(this->TryGrowSlotArray() == true, ResultFailedToAllocateMemory);
+                    }
+
+                    /* Probe for an existing copy of the string */
+                    const u32    hash        = vp::util::HashMurmur3(string);
+                    const Entry *entry_array = m_entry_buffer.GetPointer<Entry>(0);
+                    u32 slot = hash & m_slot_mask;
+                    while (m_slot_array[slot] != cInvalidIndex) {
+                        const Entry *entry = std::addressof(entry_array[m_slot_array[slot]]);
+                        if (entry->hash == hash && ::strcmp(m_string_buffer.GetPointer<const char>(entry->string_offset), string) == 0) {
+                            *out_index = m_slot_array[slot];
+                            RESULT_RETURN_SUCCESS;
+                        }
+                        slot = (slot + 1) & m_slot_mask;
+                    }
+
+                    /* Copy the new string */
+                    const size_t length        = ::strlen(string);
+                    const u32    string_offset = m_string_buffer.GetSize();
+                    char *string_copy = reinterpret_cast<char*>(m_string_buffer.TryAppend(length + 1));
+                    RESULT_RETURN_IF(string_copy == nullptr, ResultFailedToAllocateMemory);
+                    ::memcpy(string_copy, string, length + 1);
+
+                    /* Add an entry for the string */
+                    Entry *new_entry = reinterpret_cast<Entry*>(m_entry_buffer.TryAppend(sizeof(Entry)));
+                    RESULT_RETURN_IF(new_entry == nullptr, ResultFailedToAllocateMemory);
+                    new_entry->hash          = hash;
+                    new_entry->string_offset = string_offset;
+                    new_entry->length        = static_cast<u32>(length);
+
+                    m_slot_array[slot] = m_count;
+                    *out_index         = m_count;
+                    ++m_count;
+
+                    RESULT_RETURN_SUCCESS;
+                }
+
+                constexpr ALWAYS_INLINE const char *GetString(u32 index) const {
+                    return m_string_buffer.GetPointer<const char>(m_entry_buffer.GetPointer<Entry>(0)[index].string_offset);
+                }
+
+                constexpr ALWAYS_INLINE u32 GetCount() const { return m_count; }
+
+                constexpr size_t CalculateTableSize() const {
+                    if (m_count == 0) { return 0; }
+                    return vp::util::AlignUp(sizeof(vp::res::ResByamlContainer) + sizeof(u32) * (m_count + 1) + m_string_buffer.GetSize(), alignof(u32));
+                }
+
+                /* Writes the table with string order_array[i] at position i, or in insertion order if order_array is null */
+                void Serialize(void *output, const u32 *order_array) const {
+
+                    /* Nothing to serialize if no strings */
+                    if (m_count == 0) { return; }
+
+                    /* Calculate locations */
+                    vp::res::ResByamlContainer *header       = reinterpret_cast<vp::res::ResByamlContainer*>(output);
+                    u32                        *offset_array = reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(output) + sizeof(vp::res::ResByamlContainer));
+                    const Entry                *entry_array  = m_entry_buffer.GetPointer<Entry>(0);
+
+                    /* Set header */
+                    header->data_type = static_cast<u8>(vp::res::ByamlDataType::KeyTable);
+                    header->count     = m_count;
+
+                    /* Stream out offset and string arrays */
+                    u32 string_iter = sizeof(vp::res::ResByamlContainer) + sizeof(u32) * (m_count + 1);
+                    for (u32 i = 0; i < m_count; ++i) {
+                        const Entry *entry = std::addressof(entry_array[(order_array == nullptr) ? i : order_array[i]]);
+                        offset_array[i] = string_iter;
+                        ::memcpy(reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(output) + string_iter), m_string_buffer.GetPointer<const char>(entry->string_offset), entry->length + 1);
+                        string_iter = string_iter + entry->length + 1;
+                    }
+                    offset_array[m_count] = string_iter;
+
+                    /* Clear alignment padding */
+                    ::memset(reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(output) + string_iter), 0, this->CalculateTableSize() - string_iter);
+
+                    return;
+                }
+        };
+
+        constexpr ALWAYS_INLINE bool IsByamlStreamOffsetValue(u32 data_type) {
+            return vp::res::IsContainerType(static_cast<vp::res::ByamlDataType>(data_type)) | ((static_cast<u32>(vp::res::ByamlDataType::U32) < data_type) & (data_type < static_cast<u32>(vp::res::ByamlDataType::Null)));
+        }
+    }
+
+    /* Single pass byaml writer. Containers are emitted as they are closed with offsets backpatched on serialize, keys and strings are deduplicated by hash */
+    class ByamlStreamWriter {
+        private:
+            struct Entry {
+                u32 key_index;
+                u32 data_type;
+                u32 value;
+            };
+            struct Frame {
+                u32 data_type;
+                u32 key_index;
+                u32 entry_start;
+            };
+        private:
+            static constexpr u32 cInvalidIndex  = impl::ByamlStreamStringTable::cInvalidIndex;
+            static constexpr u32 cMaxEntryCount = 0xff'ffff;
+        private:
+            impl::ByamlStreamBuffer      m_data_buffer;
+            impl::ByamlStreamBuffer      m_entry_stack;
+            impl::ByamlStreamBuffer      m_frame_stack;
+            impl::ByamlStreamBuffer      m_relocation_buffer;
+            impl::ByamlStreamBuffer      m_dictionary_buffer;
+            impl::ByamlStreamStringTable m_key_table;
+            impl::ByamlStreamStringTable m_string_table;
+            imem::IHeap                 *m_heap;
+            u32                          m_root_offset;
+            u32                          m_root_data_type;
+        private:
+            constexpr ALWAYS_INLINE u32 GetFrameCount() const { return m_frame_stack.GetSize() / sizeof(Frame); }
+            constexpr ALWAYS_INLINE u32 GetEntryCount() const { return m_entry_stack.GetSize() / sizeof(Entry); }
+
+            Result TryResolveKey(u32 *out_key_index, const char *key) {
+
+                /* The root and array elements take no key */
+                *out_key_index = cInvalidIndex;
+                const u32 frame_count = this->GetFrameCount();
+                if (frame_count == 0 || m_frame_stack.GetPointer<Frame>(0)[frame_count - 1].data_type == static_cast<u32>(vp::res::ByamlDataType::Array)) {
+                    RESULT_RETURN_IF(key != nullptr, ResultInvalidContainerState);
+                    RESULT_RETURN_SUCCESS;
+                }
+
+                /* Dictionary elements require one */
+                RESULT_RETURN_IF(key == nullptr, ResultInvalidContainerState);
+
+                return m_key_table.TryAddString(out_key_index, key);
+            }
+
+            Result PushEntry(u32 key_index, vp::res::ByamlDataType data_type, u32 value) {
+
+                Entry *entry = reinterpret_cast<Entry*>(m_entry_stack.TryAppend(sizeof(Entry)));
+                RESULT_RETURN_IF(entry == nullptr, ResultFailedToAllocateMemory);
+
+                entry->key_index = key_index;
+                entry->data_type = static_cast<u32>(data_type);
+                entry->value     = value;
+
+                RESULT_RETURN_SUCCESS;
+            }
+
+            Result PushRelocation(u32 data_offset) {
+                u32 *relocation = reinterpret_cast<u32*>(m_relocation_buffer.TryAppend(sizeof(u32)));
+                RESULT_RETURN_IF(relocation == nullptr, ResultFailedToAllocateMemory);
+                *relocation = data_offset;
+                RESULT_RETURN_SUCCESS;
+            }
+
+            Result BeginContainer(vp::res::ByamlDataType data_type, const char *key) {
+
+                /* Integrity checks */
+                RESULT_RETURN_IF(m_root_data_type != static_cast<u32>(vp::res::ByamlDataType::Null), ResultInvalidContainerState);
+
+                /* Resolve key */
+                u32 key_index = cInvalidIndex;
+                const Result key_result = this->TryResolveKey(std::addressof(key_index), key);
+                RESULT_RETURN_UNLESS(key_result == ResultSuccess, key_result);
+
+                /* Push frame */
+                Frame *frame = reinterpret_cast<Frame*>(m_frame_stack.TryAppend(sizeof(Frame)));
+                RESULT_RETURN_IF(frame == nullptr, ResultFailedToAllocateMemory);
+
+                frame->data_type   = static_cast<u32>(data_type);
+                frame->key_index   = key_index;
+                frame->entry_start = this->GetEntryCount();
+
+                RESULT_RETURN_SUCCESS;
+            }
+        public:
+            constexpr  ByamlStreamWriter() : m_data_buffer(), m_entry_stack(), m_frame_stack(), m_relocation_buffer(), m_dictionary_buffer(), m_key_table(), m_string_table(), m_heap(nullptr), m_root_offset(0), m_root_data_type(static_cast<u32>(vp::res::ByamlDataType::Null)) {/*...*/}
+            constexpr ~ByamlStreamWriter() {/*...*/}
+
+            void Initialize(imem::IHeap *heap) {
+                m_heap = heap;
+                m_data_buffer.Initialize(heap);
+                m_entry_stack.Initialize(heap);
+                m_frame_stack.Initialize(heap);
+                m_relocation_buffer.Initialize(heap);
+                m_dictionary_buffer.Initialize(heap);
+                m_key_table.Initialize(heap);
+                m_string_table.Initialize(heap);
+            }
+
+            void Finalize() {
+                m_data_buffer.Finalize();
+                m_entry_stack.Finalize();
+                m_frame_stack.Finalize();
+                m_relocation_buffer.Finalize();
+                m_dictionary_buffer.Finalize();
+                m_key_table.Finalize();
+                m_string_table.Finalize();
+                m_root_offset    = 0;
+                m_root_data_type = static_cast<u32>(vp::res::ByamlDataType::Null);
+            }
+
+            ALWAYS_INLINE Result BeginArray()                      { return this->BeginContainer(vp::res::ByamlDataType::Array, nullptr); }
+            ALWAYS_INLINE Result BeginArray(const char *key)       { return this->BeginContainer(vp::res::ByamlDataType::Array, key); }
+            ALWAYS_INLINE Result BeginDictionary()                 { return this->BeginContainer(vp::res::ByamlDataType::Dictionary, nullptr); }
+            ALWAYS_INLINE Result BeginDictionary(const char *key)  { return this->BeginContainer(vp::res::ByamlDataType::Dictionary, key); }
+
+            Result EndContainer() {
+
+                /* Integrity checks */
+                const u32 frame_count = this->GetFrameCount();
+                RESULT_RETURN_IF(frame_count == 0, ResultInvalidContainerState);
+
+                const Frame frame       = m_frame_stack.GetPointer<Frame>(0)[frame_count - 1];
+                const u32   entry_count = this->GetEntryCount() - frame.entry_start;
+                Entry      *entry_array = m_entry_stack.GetPointer<Entry>(sizeof(Entry) * frame.entry_start);
+                RESULT_RETURN_IF(cMaxEntryCount < entry_count, ResultEntryExhaustion);
+
+                /* Emit the container */
+                const u32 container_offset = m_data_buffer.GetSize();
+                if (frame.data_type == static_cast<u32>(vp::res::ByamlDataType::Array)) {
+
+                    /* Array layout is a header, a type byte per element padded to 4 bytes, and a value per element */
+                    const u32 type_size = vp::util::AlignUp(entry_count, alignof(u32));
+                    void *container = m_data_buffer.TryAppend(sizeof(vp::res::ResByamlContainer) + type_size + sizeof(u32) * entry_count);
+                    RESULT_RETURN_IF(container == nullptr, ResultFailedToAllocateMemory);
+
+                    vp::res::ResByamlContainer *header      = reinterpret_cast<vp::res::ResByamlContainer*>(container);
+                    u8                         *type_array  = reinterpret_cast<u8*>(reinterpret_cast<uintptr_t>(container) + sizeof(vp::res::ResByamlContainer));
+                    u32                        *value_array = reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(type_array) + type_size);
+                    header->data_type = frame.data_type;
+                    header->count     = entry_count;
+                    ::memset(type_array + entry_count, 0, type_size - entry_count);
+
+                    for (u32 i = 0; i < entry_count; ++i) {
+                        type_array[i]  = static_cast<u8>(entry_array[i].data_type);
+                        value_array[i] = entry_array[i].value;
+                        if (impl::IsByamlStreamOffsetValue(entry_array[i].data_type) == false) { continue; }
+
+                        const Result relocation_result = this->PushRelocation(container_offset + sizeof(vp::res::ResByamlContainer) + type_size + sizeof(u32) * i);
+                        RESULT_RETURN_UNLESS(relocation_result == ResultSuccess, relocation_result);
+                    }
+                } else {
+
+                    /* Sort by key to reject duplicate keys, pairs are sorted into key table order on serialize */
+                    std::sort(entry_array, entry_array + entry_count, [](const Entry &lhs, const Entry &rhs) { return lhs.key_index < rhs.key_index; });
+                    for (u32 i = 1; i < entry_count; ++i) {
+                        RESULT_RETURN_IF(entry_array[i - 1].key_index == entry_array[i].key_index, ResultDuplicateKey);
+                    }
+
+                    void *container = m_data_buffer.TryAppend(sizeof(vp::res::ResByamlContainer) + sizeof(vp::res::ResByamlDictionaryPair) * entry_count);
+                    RESULT_RETURN_IF(container == nullptr, ResultFailedToAllocateMemory);
+
+                    vp::res::ResByamlContainer      *header     = reinterpret_cast<vp::res::ResByamlContainer*>(container);
+                    vp::res::ResByamlDictionaryPair *pair_array = reinterpret_cast<vp::res::ResByamlDictionaryPair*>(reinterpret_cast<uintptr_t>(container) + sizeof(vp::res::ResByamlContainer));
+                    header->data_type = frame.data_type;
+                    header->count     = entry_count;
+
+                    for (u32 i = 0; i < entry_count; ++i) {
+                        pair_array[i].key_index = entry_array[i].key_index;
+                        pair_array[i].data_type = entry_array[i].data_type;
+                        pair_array[i].u32_value = entry_array[i].value;
+                        if (impl::IsByamlStreamOffsetValue(entry_array[i].data_type) == false) { continue; }
+
+                        const Result relocation_result = this->PushRelocation(container_offset + sizeof(vp::res::ResByamlContainer) + sizeof(vp::res::ResByamlDictionaryPair) * i + sizeof(u32));
+                        RESULT_RETURN_UNLESS(relocation_result == ResultSuccess, relocation_result);
+                    }
+
+                    /* Record dictionary for key remapping */
+                    u32 *dictionary_offset = reinterpret_cast<u32*>(m_dictionary_buffer.TryAppend(sizeof(u32)));
+                    RESULT_RETURN_IF(dictionary_offset == nullptr, ResultFailedToAllocateMemory);
+                    *dictionary_offset = container_offset;
+                }
+
+                /* Pop the frame and its entries */
+                m_entry_stack.Shrink(sizeof(Entry) * frame.entry_start);
+                m_frame_stack.Shrink(sizeof(Frame) * (frame_count - 1));
+
+                /* Set root if closing the root */
+                if (frame_count == 1) {
+                    m_root_offset    = container_offset;
+                    m_root_data_type = frame.data_type;
+                    RESULT_RETURN_SUCCESS;
+                }
+
+                return this->PushEntry(frame.key_index, static_cast<vp::res::ByamlDataType>(frame.data_type), container_offset);
+            }
+
+            template <typename T>
+                requires (vp::res::TGetByamlDataTypeValue<T>() != vp::res::ByamlDataType::Null)
+            Result AddValue(const char *key, T value) {
+
+                /* Integrity checks */
+                RESULT_RETURN_IF(this->GetFrameCount() == 0, ResultInvalidContainerState);
+
+                /* Resolve key */
+                u32 key_index = cInvalidIndex;
+                const Result key_result = this->TryResolveKey(std::addressof(key_index), key);
+                RESULT_RETURN_UNLESS(key_result == ResultSuccess, key_result);
+
+                /* Encode value */
+                constexpr vp::res::ByamlDataType cDataType = vp::res::TGetByamlDataTypeValue<T>();
+                u32 raw_value = 0;
+                if constexpr (cDataType == vp::res::ByamlDataType::StringIndex) {
+                    const Result string_result = m_string_table.TryAddString(std::addressof(raw_value), value);
+                    RESULT_RETURN_UNLESS(string_result == ResultSuccess, string_result);
+                } else if constexpr (sizeof(T) == sizeof(u64)) {
+                    raw_value = m_data_buffer.GetSize();
+                    void *big_data = m_data_buffer.TryAppend(sizeof(T));
+                    RESULT_RETURN_IF(big_data == nullptr, ResultFailedToAllocateMemory);
+                    ::memcpy(big_data, std::addressof(value), sizeof(T));
+                } else if constexpr (cDataType == vp::res::ByamlDataType::Bool) {
+                    raw_value = value;
+                } else {
+                    raw_value = std::bit_cast<u32>(value);
+                }
+
+                return this->PushEntry(key_index, cDataType, raw_value);
+            }
+
+            template <typename T>
+                requires (vp::res::TGetByamlDataTypeValue<T>() != vp::res::ByamlDataType::Null)
+            ALWAYS_INLINE Result AddValue(T value) {
+                return this->AddValue(nullptr, value);
+            }
+
+            size_t CalculateFileSize() const {
+                return sizeof(vp::res::ResByaml) + m_key_table.CalculateTableSize() + m_string_table.CalculateTableSize() + m_data_buffer.GetSize();
+            }
+
+            Result Serialize(void *output, size_t output_size) {
+
+                /* Integrity checks */
+                RESULT_RETURN_IF(output == nullptr, ResultNullArgument);
+                RESULT_RETURN_IF(m_root_data_type == static_cast<u32>(vp::res::ByamlDataType::Null), ResultInvalidContainerState);
+
+                const size_t file_size = this->CalculateFileSize();
+                RESULT_RETURN_IF(output_size < file_size || impl::ByamlStreamBuffer::cMaxCapacity < file_size, ResultOutputExhaustion);
+
+                /* Sort keys and build a remap from insertion order to key table order */
+                const u32  key_count   = m_key_table.GetCount();
+                u32       *order_array = nullptr;
+                if (key_count != 0) {
+                    order_array = reinterpret_cast<u32*>(::operator new(sizeof(u32) * key_count * 2, m_heap, alignof(u32)));
+                    RESULT_RETURN_IF(order_array == nullptr, ResultFailedToAllocateMemory);
+                }
+                ON_SCOPE_EXIT {
+                    if (order_array != nullptr) {
+                        ::operator delete(order_array);
+                    }
+                };
+                u32 *remap_array = order_array + key_count;
+
+                for (u32 i = 0; i < key_count; ++i) { order_array[i] = i; }
+                std::sort(order_array, order_array + key_count, [this](u32 lhs, u32 rhs) { return ::strcmp(m_key_table.GetString(lhs), m_key_table.GetString(rhs)) < 0; });
+                for (u32 i = 0; i < key_count; ++i) { remap_array[order_array[i]] = i; }
+
+                /* Set header */
+                vp::res::ResByaml *head = reinterpret_cast<vp::res::ResByaml*>(output);
+                head->magic               = vp::res::ResByaml::cMagic;
+                head->version             = vp::res::ResByaml::cTargetVersion;
+                head->key_table_offset    = 0;
+                head->string_table_offset = 0;
+
+                /* Serialize key table and string pool */
+                u32 offset = sizeof(vp::res::ResByaml);
+                if (key_count != 0) {
+                    head->key_table_offset = offset;
+                    m_key_table.Serialize(reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(output) + offset), order_array);
+                    offset += static_cast<u32>(m_key_table.CalculateTableSize());
+                }
+                if (m_string_table.GetCount() != 0) {
+                    head->string_table_offset = offset;
+                    m_string_table.Serialize(reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(output) + offset), nullptr);
+                    offset += static_cast<u32>(m_string_table.CalculateTableSize());
+                }
+
+                /* Copy data and set root */
+                const u32 data_base = offset;
+                void     *data      = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(output) + data_base);
+                ::memcpy(data, m_data_buffer.GetPointer<void>(0), m_data_buffer.GetSize());
+                head->data_offset = data_base + m_root_offset;
+
+                /* Backpatch data relative offsets to file offsets */
+                const u32 *relocation_array = m_relocation_buffer.GetPointer<u32>(0);
+                const u32  relocation_count = m_relocation_buffer.GetSize() / sizeof(u32);
+                for (u32 i = 0; i < relocation_count; ++i) {
+                    *reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(data) + relocation_array[i]) += data_base;
+                }
+
+                /* Remap dictionary keys and sort pairs into key table order */
+                const u32 *dictionary_array = m_dictionary_buffer.GetPointer<u32>(0);
+                const u32  dictionary_count = m_dictionary_buffer.GetSize() / sizeof(u32);
+                for (u32 i = 0; i < dictionary_count; ++i) {
+
+                    vp::res::ResByamlContainer      *header     = reinterpret_cast<vp::res::ResByamlContainer*>(reinterpret_cast<uintptr_t>(data) + dictionary_array[i]);
+                    vp::res::ResByamlDictionaryPair *pair_array = reinterpret_cast<vp::res::ResByamlDictionaryPair*>(reinterpret_cast<uintptr_t>(header) + sizeof(vp::res::ResByamlContainer));
+                    const u32                        pair_count = header->count;
+                    for (u32 y = 0; y < pair_count; ++y) {
+                        pair_array[y].key_index = remap_array[pair_array[y].key_index];
+                    }
+                    std::sort(pair_array, pair_array + pair_count, [](const vp::res::ResByamlDictionaryPair &lhs, const vp::res::ResByamlDictionaryPair &rhs) { return lhs.key_index < rhs.key_index; });
+                }
+
+                RESULT_RETURN_SUCCESS;
+            }
+    };
+}
@@ -46,9 +46,26 @@ namespace vp::resbui {
         public:
             using EntryHashList      = vp::util::IntrusiveRedBlackTreeTraits<ResourceSizeNode, &ResourceSizeNode::hash_node>::Tree;
             using EntryCollisionList = vp::util::IntrusiveRedBlackTreeTraits<ResourceSizeNode, &ResourceSizeNode::collision_node>::Tree;
+        public:
+            static constexpr u32 cPerfectHashAverageBucketSize = 4;
+            static constexpr u32 cPerfectHashMaxBucketSize     = 32;
+            static constexpr u32 cPerfectHashMaxSeedCount      = 16;
+            static constexpr u32 cPerfectHashMaxPilot          = 0x100'0000;
+        private:
+            struct PerfectHashKey {
+                u32 path_crc32;
+                u32 resource_size;
+                u32 bucket;
+                u32 slot;
+            };
+            static_assert(sizeof(PerfectHashKey) == 0x10);
         public:
             EntryHashList      m_crc32_entry_list;
             EntryCollisionList m_collision_entry_list;
+        private:
+            u32  CountUniqueCollisionCrc32();
+            u32  CalculateCollisionStringPoolSize();
+            bool TryBuildPerfectHash(PerfectHashKey *key_array, u32 key_count, u32 *pilot_array, u32 bucket_count, u32 seed, void *work_memory);
         private:
             ResourceSizeNode *SearchEntry(const char *path) {
 
@@ -190,5 +207,20 @@ namespace vp::resbui {
             size_t CalculateSerializedSize(u32 max_path_length = 0x80) {
                 return sizeof(res::ResRsizetable) + sizeof(res::ResRsizetableCrc32) * m_crc32_entry_list.GetCount() + (sizeof(u32) + max_path_length) * m_collision_entry_list.GetCount();
             }
+
+            /* Minimal perfect hash layout, crc32 collisions are stored once as paths in a string pool */
+            static constexpr u32 CalculatePerfectHashBucketCount(u32 entry_count) {
+                const u32 bucket_count = (entry_count + cPerfectHashAverageBucketSize - 1) / cPerfectHashAverageBucketSize;
+                return (bucket_count == 0) ? 1 : bucket_count;
+            }
+
+            u32 GetPerfectHashEntryCount() {
+                return m_crc32_entry_list.GetCount() + this->CountUniqueCollisionCrc32();
+            }
+
+            size_t GetPerfectHashWorkMemorySize();
+            size_t CalculatePerfectHashSerializedSize();
+
+            bool SerializePerfectHash(void *file, size_t file_size, void *work_memory, size_t work_memory_size);
     };
 }
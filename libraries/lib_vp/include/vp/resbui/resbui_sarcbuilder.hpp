@@ -28,8 +28,15 @@ namespace vp::resbui {
             void                        *m_file;
             u32                          m_file_size;
             u32                          m_file_alignment;
+            u32                          m_path_hash;
+            u32                          m_content_hash;
+            SarcFileNode                *m_path_hash_next;
+            SarcFileNode                *m_content_hash_next;
+            SarcFileNode                *m_content_source;
+            u32                          m_file_region_offset;
+            u32                          m_file_region_padding;
         public:
-            constexpr  SarcFileNode() : m_builder_node(), m_file_path(nullptr), m_file(nullptr), m_file_size(0), m_file_alignment(alignof(u32)) {/*...*/}
+            constexpr  SarcFileNode() : m_builder_node(), m_file_path(nullptr), m_file(nullptr), m_file_size(0), m_file_alignment(alignof(u32)), m_path_hash(0), m_content_hash(0), m_path_hash_next(nullptr), m_content_hash_next(nullptr), m_content_source(nullptr), m_file_region_offset(0), m_file_region_padding(0) {/*...*/}
             constexpr ~SarcFileNode() {/*...*/}
 
             Result SetFile(const char *file_path, void *file, u32 file_size, u32 file_alignment) {
@@ -43,11 +50,17 @@ namespace vp::resbui {
 
                 RESULT_RETURN_SUCCESS;
             }
+
+            /* Returns the node whose payload this file shares, or this node if the payload is unique */
+            constexpr const SarcFileNode *GetContentSource() const {
+                return (m_content_source != nullptr) ? m_content_source : this;
+            }
     };
 
     struct SarcBuilderMemoryInfo {
         size_t         total_file_size;
         size_t         max_alignment;
+        u32            file_count;
         BufferLocation location_header;
         BufferLocation location_sfat;
         BufferLocation location_sfnt;
@@ -57,52 +70,131 @@ namespace vp::resbui {
     class SarcBuilder {
         public:
             static constexpr u32 cDefaultHashSeed = 0x65;
+            static constexpr u32 cMaxFileCount    = 0x3fff;
         private:
             using FileList = vp::util::IntrusiveListTraits<SarcFileNode, &SarcFileNode::m_builder_node>::List;
         public:
-            FileList m_file_list;
-            u32      m_hash_seed;
+            FileList       m_file_list;
+            u32            m_hash_seed;
+        private:
+            SarcFileNode **m_path_bucket_array;
+            SarcFileNode **m_content_bucket_array;
+            SarcFileNode **m_sorted_node_array;
+            u32            m_bucket_mask;
+            u32            m_max_file_count;
+            u32            m_file_count;
+            bool           m_is_deduplicate_content;
+        private:
+            static constexpr u32 GetBucketCount(u32 max_file_count) {
+                u32 bucket_count = 1;
+                while (bucket_count < max_file_count) { bucket_count = bucket_count << 1; }
+                return bucket_count;
+            }
         public:
-            constexpr  SarcBuilder() : m_file_list(), m_hash_seed(cDefaultHashSeed) {/*...*/}
+            constexpr  SarcBuilder() : m_file_list(), m_hash_seed(cDefaultHashSeed), m_path_bucket_array(nullptr), m_content_bucket_array(nullptr), m_sorted_node_array(nullptr), m_bucket_mask(0), m_max_file_count(0), m_file_count(0), m_is_deduplicate_content(false) {/*...*/}
             constexpr ~SarcBuilder() {/*...*/}
 
+            static constexpr size_t GetWorkMemorySize(u32 max_file_count) {
+                return sizeof(SarcFileNode*) * (GetBucketCount(max_file_count) * 2 + max_file_count);
+            }
+
+            Result Initialize(void *work_memory, size_t work_memory_size, u32 max_file_count, bool is_deduplicate_content = false) {
+
+                /* Integrity checks */
+                RESULT_RETURN_IF(work_memory == nullptr,                                ResultNullArgument);
+                RESULT_RETURN_IF(max_file_count == 0 || cMaxFileCount < max_file_count, ResultEntryExhaustion);
+                RESULT_RETURN_IF(work_memory_size < GetWorkMemorySize(max_file_count),  ResultInvalidWorkMemorySize);
+
+                /* Carve work memory */
+                const u32 bucket_count = GetBucketCount(max_file_count);
+                m_path_bucket_array    = reinterpret_cast<SarcFileNode**>(work_memory);
+                m_content_bucket_array = m_path_bucket_array + bucket_count;
+                m_sorted_node_array    = m_content_bucket_array + bucket_count;
+                ::memset(m_path_bucket_array, 0, sizeof(SarcFileNode*) * bucket_count * 2);
+
+                m_bucket_mask            = bucket_count - 1;
+                m_max_file_count         = max_file_count;
+                m_file_count             = 0;
+                m_is_deduplicate_content = is_deduplicate_content;
+
+                RESULT_RETURN_SUCCESS;
+            }
+
+            void Finalize() {
+                m_file_list.Clear();
+                m_path_bucket_array    = nullptr;
+                m_content_bucket_array = nullptr;
+                m_sorted_node_array    = nullptr;
+                m_bucket_mask          = 0;
+                m_max_file_count       = 0;
+                m_file_count           = 0;
+            }
+
             Result AddFile(SarcFileNode *file_node) {
 
                 /* Integrity checks */
                 RESULT_RETURN_IF(file_node == nullptr,                                                 ResultNullArgument);
                 RESULT_RETURN_IF(file_node->m_file_path == nullptr || *file_node->m_file_path == '\0', ResultInvalidPath);
+                RESULT_RETURN_IF(m_path_bucket_array == nullptr,                                       ResultInvalidWorkMemorySize);
+                RESULT_RETURN_IF(m_max_file_count <= m_file_count,                                     ResultEntryExhaustion);
+
+                /* Check for a duplicate path in the path hash set */
+                const u32      path_hash   = vp::res::CalculateSarcHash(m_hash_seed, file_node->m_file_path);
+                SarcFileNode **path_bucket = std::addressof(m_path_bucket_array[path_hash & m_bucket_mask]);
+                for (SarcFileNode *node = *path_bucket; node != nullptr; node = node->m_path_hash_next) {
+                    RESULT_RETURN_IF(node->m_path_hash == path_hash && ::strcmp(file_node->m_file_path, node->m_file_path) == 0, ResultDuplicatePath);
+                }
 
-                /* Sorted insertion */
-                const u32 path_hash = vp::res::CalculateSarcHash(m_hash_seed, file_node->m_file_path);
-                for (SarcFileNode &node : m_file_list) {
-                    RESULT_RETURN_IF(::strcmp(file_node->m_file_path, node.m_file_path) == 0, ResultDuplicatePath);
-                    if (path_hash > vp::res::CalculateSarcHash(m_hash_seed, node.m_file_path)) { continue; }
+                /* Share the payload of an identical file */
+                file_node->m_content_source    = nullptr;
+                file_node->m_content_hash_next = nullptr;
+                if (m_is_deduplicate_content == true) {
+
+                    const u32      content_hash   = vp::util::HashDataCrc32b(file_node->m_file, file_node->m_file_size);
+                    SarcFileNode **content_bucket = std::addressof(m_content_bucket_array[content_hash & m_bucket_mask]);
+                    for (SarcFileNode *node = *content_bucket; node != nullptr; node = node->m_content_hash_next) {
+                        if (node->m_content_hash != content_hash || node->m_file_size != file_node->m_file_size) { continue; }
+                        if (::memcmp(node->m_file, file_node->m_file, file_node->m_file_size) != 0)              { continue; }
+
+                        /* The shared payload must satisfy the alignment of every file referencing it */
+                        file_node->m_content_source = node;
+                        node->m_file_alignment      = (node->m_file_alignment < file_node->m_file_alignment) ? file_node->m_file_alignment : node->m_file_alignment;
+                        break;
+                    }
 
-                    node.m_builder_node.LinkPrev(std::addressof(file_node->m_builder_node));
-                    RESULT_RETURN_SUCCESS;
+                    file_node->m_content_hash = content_hash;
+                    if (file_node->m_content_source == nullptr) {
+                        file_node->m_content_hash_next = *content_bucket;
+                        *content_bucket                = file_node;
+                    }
                 }
 
-                /* Push to back if at the end */
+                /* Insert into path hash set, hash ordering is deferred to CalculateMemoryInfo */
+                file_node->m_path_hash      = path_hash;
+                file_node->m_path_hash_next = *path_bucket;
+                *path_bucket                = file_node;
                 m_file_list.PushBack(*file_node);
+                ++m_file_count;
 
                 RESULT_RETURN_SUCCESS;
             }
 
-            void Serialize(void *out_buffer, size_t buffer_size, SarcBuilderMemoryInfo *memory_info) {
+            /* Writes the header, file table, and path table. File payloads are written by SerializeFileRange */
+            void SerializeHeader(void *out_buffer, size_t buffer_size, SarcBuilderMemoryInfo *memory_info) {
 
                 /* Integrity checks */
                 VP_ASSERT(out_buffer != nullptr);
                 VP_ASSERT(memory_info != nullptr);
                 VP_ASSERT(memory_info->total_file_size <= buffer_size);
+                VP_ASSERT(memory_info->file_count == m_file_count);
 
-                /* Clear memory */
-                ::memset(out_buffer, 0, memory_info->total_file_size);
+                /* Clear memory up to the file region */
+                ::memset(out_buffer, 0, memory_info->location_file_region.offset);
 
                 /* Setup locations */
-                vp::res::ResSarc     *sarc        = reinterpret_cast<vp::res::ResSarc*>(reinterpret_cast<uintptr_t>(out_buffer) + memory_info->location_header.offset);
-                vp::res::ResSarcSfat *sfat        = reinterpret_cast<vp::res::ResSarcSfat*>(reinterpret_cast<uintptr_t>(out_buffer) + memory_info->location_sfat.offset);
-                vp::res::ResSarcSfnt *sfnt        = reinterpret_cast<vp::res::ResSarcSfnt*>(reinterpret_cast<uintptr_t>(out_buffer) + memory_info->location_sfnt.offset);
-                uintptr_t             file_region = reinterpret_cast<uintptr_t>(out_buffer) + memory_info->location_file_region.offset;
+                vp::res::ResSarc     *sarc = reinterpret_cast<vp::res::ResSarc*>(reinterpret_cast<uintptr_t>(out_buffer) + memory_info->location_header.offset);
+                vp::res::ResSarcSfat *sfat = reinterpret_cast<vp::res::ResSarcSfat*>(reinterpret_cast<uintptr_t>(out_buffer) + memory_info->location_sfat.offset);
+                vp::res::ResSarcSfnt *sfnt = reinterpret_cast<vp::res::ResSarcSfnt*>(reinterpret_cast<uintptr_t>(out_buffer) + memory_info->location_sfnt.offset);
 
                 /* Write header */
                 sarc->magic             = vp::res::ResSarc::cMagic;
@@ -116,85 +208,108 @@ namespace vp::resbui {
                 /* Write sfat header */
                 sfat->magic       = vp::res::ResSarcSfat::cMagic;
                 sfat->header_size = sizeof(vp::res::ResSarcSfat);
+                sfat->file_count  = m_file_count;
                 sfat->hash_seed   = m_hash_seed;
 
                 /* Write sfnt header */
                 sfnt->magic       = vp::res::ResSarcSfnt::cMagic;
                 sfnt->header_size = sizeof(vp::res::ResSarcSfnt);
 
-                /* Write file paths and file region */
-                u32        file_count      = 0;
+                /* Write file entries and paths */
                 u32        last_hash       = 0;
                 u32        collision_count = 1;
                 uintptr_t  sfnt_start      = reinterpret_cast<uintptr_t>(sfnt) + sizeof(vp::res::ResSarcSfnt);
                 void      *sfnt_iter       = reinterpret_cast<void*>(sfnt_start);
-                void      *file_iter       = reinterpret_cast<void*>(file_region);
-                for (SarcFileNode &node : m_file_list) {
+                for (u32 i = 0; i < m_file_count; ++i) {
 
-                    /* Handle collision */
-                    const u32 hash = vp::res::CalculateSarcHash(m_hash_seed, node.m_file_path);
+                    const SarcFileNode *node   = m_sorted_node_array[i];
+                    const SarcFileNode *source = node->GetContentSource();
 
-                    /* Check if the next element in the hash sorted list is the same hash */
-                    if (0 < file_count && hash == last_hash) {
+                    /* Check if the previous element in the hash sorted array is the same hash */
+                    if (0 < i && node->m_path_hash == last_hash) {
                         ++collision_count;
                         VP_ASSERT(collision_count < 0x100);
                     } else {
-                        last_hash       = hash;
+                        last_hash       = node->m_path_hash;
                         collision_count = 1;
                     }
 
                     /* Write sfat entry */
-                    sfat->entry_array[file_count].file_name_hash          = hash;
-                    sfat->entry_array[file_count].file_name_offset        = (reinterpret_cast<uintptr_t>(sfnt_iter) - sfnt_start) >> 2;
-                    sfat->entry_array[file_count].hash_collision_index    = collision_count;
+                    sfat->entry_array[i].file_name_hash          = node->m_path_hash;
+                    sfat->entry_array[i].file_name_offset        = (reinterpret_cast<uintptr_t>(sfnt_iter) - sfnt_start) >> 2;
+                    sfat->entry_array[i].hash_collision_index    = collision_count;
+                    sfat->entry_array[i].file_array_start_offset = source->m_file_region_offset;
+                    sfat->entry_array[i].file_array_end_offset   = source->m_file_region_offset + source->m_file_size;
 
                     /* Write sfnt path */
-                    const u32 string_size = ::strlen(node.m_file_path) + 1;
-                    ::memcpy(sfnt_iter, node.m_file_path, string_size);
+                    const u32 string_size = ::strlen(node->m_file_path) + 1;
+                    ::memcpy(sfnt_iter, node->m_file_path, string_size);
                     sfnt_iter = reinterpret_cast<void*>(vp::util::AlignUp(reinterpret_cast<uintptr_t>(sfnt_iter) + string_size, alignof(u32)));
+                }
 
-                    /* Write file */
-                    file_iter = reinterpret_cast<void*>(vp::util::AlignUp(reinterpret_cast<uintptr_t>(file_iter), node.m_file_alignment));
-                    sfat->entry_array[file_count].file_array_start_offset = reinterpret_cast<uintptr_t>(file_iter) - file_region;
+                return;
+            }
 
-                    ::memcpy(file_iter, node.m_file, node.m_file_size);
+            /* Copies the payloads of sorted files [file_index, file_index + file_count) to their precomputed offsets, ranges may be serialized concurrently */
+            void SerializeFileRange(void *out_buffer, const SarcBuilderMemoryInfo *memory_info, u32 file_index, u32 file_count) const {
 
-                    sfat->entry_array[file_count].file_array_end_offset = reinterpret_cast<uintptr_t>(file_iter) + node.m_file_size - file_region;
-                    file_iter = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(file_iter) + node.m_file_size);
+                const uintptr_t file_region = reinterpret_cast<uintptr_t>(out_buffer) + memory_info->location_file_region.offset;
+                const u32       file_end    = (m_file_count < file_index + file_count) ? m_file_count : file_index + file_count;
+                for (u32 i = file_index; i < file_end; ++i) {
 
-                    ++file_count;
-                }
+                    /* Payloads shared with another file are written once by their source */
+                    const SarcFileNode *node = m_sorted_node_array[i];
+                    if (node->m_content_source != nullptr) { continue; }
 
-                sfat->file_count  = file_count;
+                    void *file = reinterpret_cast<void*>(file_region + node->m_file_region_offset);
+                    ::memset(reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(file) - node->m_file_region_padding), 0, node->m_file_region_padding);
+                    ::memcpy(file, node->m_file, node->m_file_size);
+                }
 
                 return;
             }
 
+            void Serialize(void *out_buffer, size_t buffer_size, SarcBuilderMemoryInfo *memory_info) {
+                this->SerializeHeader(out_buffer, buffer_size, memory_info);
+                this->SerializeFileRange(out_buffer, memory_info, 0, m_file_count);
+            }
+
             void CalculateMemoryInfo(SarcBuilderMemoryInfo *out_memory_info) {
 
-                /* Calculate memory sizes */
-                u32    file_count       = 0;
+                /* Sort files by path hash */
+                u32 file_count = 0;
+                for (SarcFileNode &node : m_file_list) {
+                    m_sorted_node_array[file_count] = std::addressof(node);
+                    ++file_count;
+                }
+                std::sort(m_sorted_node_array, m_sorted_node_array + file_count, [](const SarcFileNode *lhs, const SarcFileNode *rhs) {
+                    if (lhs->m_path_hash != rhs->m_path_hash) { return lhs->m_path_hash < rhs->m_path_hash; }
+                    return ::strcmp(lhs->m_file_path, rhs->m_file_path) < 0;
+                });
+
+                /* Calculate path table size and lay out unique payloads */
                 u32    sfnt_size        = sizeof(vp::res::ResSarcSfnt);
                 u32    file_region_size = 0;
                 size_t max_align        = alignof(u32);
-                for (SarcFileNode &node : m_file_list) {
+                for (u32 i = 0; i < file_count; ++i) {
 
-                    /* Add string and file size */
-                    sfnt_size = vp::util::AlignUp(sfnt_size + ::strlen(node.m_file_path) + 1, alignof(u32));
+                    SarcFileNode *node = m_sorted_node_array[i];
 
-                    /* Add file size */
-                    if (file_region_size != 0) {
-                        file_region_size = vp::util::AlignUp(file_region_size, node.m_file_alignment);
-                    }
-                    file_region_size = file_region_size + node.m_file_size;
+                    /* Add string size */
+                    sfnt_size = vp::util::AlignUp(sfnt_size + ::strlen(node->m_file_path) + 1, alignof(u32));
 
                     /* Set max align */
-                    if (max_align < node.m_file_alignment) {
-                        max_align = node.m_file_alignment;
+                    if (max_align < node->m_file_alignment) {
+                        max_align = node->m_file_alignment;
                     }
 
-                    /* Increment count */
-                    ++file_count;
+                    /* Place file */
+                    if (node->m_content_source != nullptr) { continue; }
+
+                    const u32 file_offset       = vp::util::AlignUp(file_region_size, node->m_file_alignment);
+                    node->m_file_region_offset  = file_offset;
+                    node->m_file_region_padding = file_offset - file_region_size;
+                    file_region_size            = file_offset + node->m_file_size;
                 }
 
                 /* Calculate locations */
@@ -210,14 +325,39 @@ namespace vp::resbui {
                 out_memory_info->location_sfnt.size      = sfnt_size;
                 out_memory_info->location_sfnt.alignment = alignof(u32);
 
-                out_memory_info->location_file_region.offset    = vp::util::AlignUp(out_memory_info->location_sfnt.offset + sfnt_size, m_file_list.Front().m_file_alignment);
-                out_memory_info->location_file_region.size      = file_region_size - out_memory_info->location_file_region.offset;
-                out_memory_info->location_file_region.alignment = alignof(u32);
+                out_memory_info->location_file_region.offset    = vp::util::AlignUp(out_memory_info->location_sfnt.offset + sfnt_size, max_align);
+                out_memory_info->location_file_region.size      = file_region_size;
+                out_memory_info->location_file_region.alignment = max_align;
 
                 out_memory_info->total_file_size = out_memory_info->location_file_region.offset + out_memory_info->location_file_region.size;
                 out_memory_info->max_alignment   = max_align;
+                out_memory_info->file_count      = file_count;
 
                 return;
             }
     };
+
+    class SarcSerializeFileJob : public vp::util::Job {
+        private:
+            const SarcBuilder           *m_sarc_builder;
+            void                        *m_out_buffer;
+            const SarcBuilderMemoryInfo *m_memory_info;
+            u32                          m_file_index;
+            u32                          m_file_count;
+        public:
+            constexpr SarcSerializeFileJob() : Job("SarcSerializeFileJob"), m_sarc_builder(), m_out_buffer(), m_memory_info(), m_file_index(), m_file_count() {/*...*/}
+            constexpr ~SarcSerializeFileJob() {/*...*/}
+
+            constexpr void Initialize(const SarcBuilder *sarc_builder, void *out_buffer, const SarcBuilderMemoryInfo *memory_info, u32 file_index, u32 file_count) {
+                m_sarc_builder = sarc_builder;
+                m_out_buffer   = out_buffer;
+                m_memory_info  = memory_info;
+                m_file_index   = file_index;
+                m_file_count   = file_count;
+            }
+
+            virtual void Invoke() override {
+                m_sarc_builder->SerializeFileRange(m_out_buffer, m_memory_info, m_file_index, m_file_count);
+            }
+    };
 }
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::resbui {
+
+    class SzsBuilder {
+        public:
+            static constexpr u32    cHashBits        = 15;
+            static constexpr u32    cHashTableCount  = (1 << cHashBits);
+            static constexpr u32    cMaxChainDepth   = 0x40;
+            static constexpr u32    cWindowMask      = vp::codec::cYaz0WindowSize - 1;
+            static constexpr s32    cInvalidPosition = -1;
+        private:
+            static constexpr ALWAYS_INLINE u32 HashPosition(const u8 *position) {
+                const u32 value = (static_cast<u32>(position[0]) << 16) | (static_cast<u32>(position[1]) << 8) | position[2];
+                return (value * 0x9e37'79b1) >> (32 - cHashBits);
+            }
+
+            static ALWAYS_INLINE void InsertPosition(s32 *head_array, s32 *chain_array, const u8 *input, size_t input_size, size_t position) {
+                if (input_size < position + vp::codec::cYaz0MinMatchSize) { return; }
+                const u32 hash                      = HashPosition(input + position);
+                chain_array[position & cWindowMask] = head_array[hash];
+                head_array[hash]                    = static_cast<s32>(position);
+            }
+
+            static ALWAYS_INLINE size_t FindLongestMatch(size_t *out_distance, const s32 *head_array, const s32 *chain_array, const u8 *input, size_t input_size, size_t position) {
+
+                /* Find the longest match by walking the hash chain within the window */
+                const size_t size_left = input_size - position;
+                const size_t max_match = (vp::codec::cYaz0MaxMatchSize < size_left) ? vp::codec::cYaz0MaxMatchSize : size_left;
+                size_t       best_size = 0;
+                s32          candidate = head_array[HashPosition(input + position)];
+                for (u32 depth = 0; depth < cMaxChainDepth && candidate != cInvalidPosition; ++depth) {
+
+                    /* Stop once the candidate leaves the window */
+                    const size_t distance = position - static_cast<size_t>(candidate);
+                    if (vp::codec::cYaz0WindowSize < distance) { break; }
+
+                    /* Compare match */
+                    const u8 *match = input + candidate;
+                    size_t    size  = 0;
+                    while (size < max_match && match[size] == input[position + size]) { ++size; }
+                    if (best_size < size) {
+                        best_size     = size;
+                        *out_distance = distance;
+                        if (size == max_match) { break; }
+                    }
+
+                    /* Stale chain entries were overwritten by newer positions */
+                    const s32 next = chain_array[candidate & cWindowMask];
+                    if (candidate <= next) { break; }
+                    candidate = next;
+                }
+
+                return best_size;
+            }
+        public:
+            static constexpr size_t GetWorkMemorySize() {
+                return sizeof(s32) * (cHashTableCount + vp::codec::cYaz0WindowSize);
+            }
+
+            static Result Compress(size_t *out_size, void *output, size_t output_size, const void *input, size_t input_size, u32 alignment, void *work_memory, size_t work_memory_size) {
+
+                /* Integrity checks */
+                RESULT_RETURN_UNLESS(output != nullptr && input != nullptr && work_memory != nullptr, ResultNullArgument);
+                RESULT_RETURN_UNLESS(GetWorkMemorySize() <= work_memory_size,                         ResultInvalidWorkMemorySize);
+                RESULT_RETURN_UNLESS(vp::codec::cYaz0HeaderSize <= output_size,                       ResultOutputExhaustion);
+                RESULT_RETURN_UNLESS(0 < input_size && input_size <= 0xffff'ffff,                     ResultOutputExhaustion);
+
+                /* Write header */
+                res::ResSzs *szs       = reinterpret_cast<res::ResSzs*>(output);
+                szs->magic             = res::ResSzs::cMagic;
+                szs->decompressed_size = vp::util::SwapEndian(static_cast<u32>(input_size));
+                szs->alignment         = vp::util::SwapEndian(alignment);
+                szs->reserve1          = 0;
+
+                /* Clear hash chains */
+                s32 *head_array  = reinterpret_cast<s32*>(work_memory);
+                s32 *chain_array = head_array + cHashTableCount;
+                for (u32 i = 0; i < cHashTableCount; ++i) { head_array[i] = cInvalidPosition; }
+                for (u32 i = 0; i < vp::codec::cYaz0WindowSize; ++i) { chain_array[i] = cInvalidPosition; }
+
+                /* Greedy encode groups of eight operations */
+                const u8 *input_base  = reinterpret_cast<const u8*>(input);
+                u8       *output_base = reinterpret_cast<u8*>(output);
+                size_t    output_iter = vp::codec::cYaz0HeaderSize;
+                size_t    position    = 0;
+                while (position < input_size) {
+
+                    /* Reserve group header */
+                    RESULT_RETURN_UNLESS(output_iter < output_size, ResultOutputExhaustion);
+                    const size_t group_header_offset = output_iter;
+                    u32          group_header        = 0;
+                    ++output_iter;
+
+                    for (u32 i = 0; i < 8 && position < input_size; ++i) {
+
+                        /* Find match */
+                        size_t distance   = 0;
+                        size_t match_size = 0;
+                        if (vp::codec::cYaz0MinMatchSize <= input_size - position) {
+                            match_size = FindLongestMatch(std::addressof(distance), head_array, chain_array, input_base, input_size, position);
+                        }
+
+                        /* Literal */
+                        if (match_size < vp::codec::cYaz0MinMatchSize) {
+                            RESULT_RETURN_UNLESS(output_iter + 1 <= output_size, ResultOutputExhaustion);
+                            group_header              |= (0x80 >> i);
+                            output_base[output_iter]   = input_base[position];
+                            ++output_iter;
+                            InsertPosition(head_array, chain_array, input_base, input_size, position);
+                            ++position;
+                            continue;
+                        }
+
+                        /* Match */
+                        const u32 encoded_distance = static_cast<u32>(distance - 1);
+                        if (0x12 <= match_size) {
+                            RESULT_RETURN_UNLESS(output_iter + 3 <= output_size, ResultOutputExhaustion);
+                            output_base[output_iter + 0] = static_cast<u8>(encoded_distance >> 8);
+                            output_base[output_iter + 1] = static_cast<u8>(encoded_distance);
+                            output_base[output_iter + 2] = static_cast<u8>(match_size - 0x12);
+                            output_iter += 3;
+                        } else {
+                            RESULT_RETURN_UNLESS(output_iter + 2 <= output_size, ResultOutputExhaustion);
+                            output_base[output_iter + 0] = static_cast<u8>(((match_size - 2) << 4) | (encoded_distance >> 8));
+                            output_base[output_iter + 1] = static_cast<u8>(encoded_distance);
+                            output_iter += 2;
+                        }
+
+                        /* Insert matched positions */
+                        for (size_t j = 0; j < match_size; ++j) {
+                            InsertPosition(head_array, chain_array, input_base, input_size, position + j);
+                        }
+                        position += match_size;
+                    }
+
+                    output_base[group_header_offset] = static_cast<u8>(group_header);
+                }
+
+                if (out_size != nullptr) {
+                    *out_size = output_iter;
+                }
+
+                RESULT_RETURN_SUCCESS;
+            }
+    };
+}
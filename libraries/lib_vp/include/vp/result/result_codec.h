@@ -21,4 +21,6 @@ namespace vp::codec {
     DECLARE_RESULT(ZstdError,             1);
     DECLARE_RESULT(OutputBufferTooSmall,  2);
     DECLARE_RESULT(InvalidZstdDictionary, 3);
+    DECLARE_RESULT(InvalidZstdSeekTable,  4);
+    DECLARE_RESULT(InvalidYaz0Stream,     5);
 }
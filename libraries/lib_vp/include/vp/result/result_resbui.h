@@ -18,10 +18,15 @@
 namespace vp::resbui {
 
     DECLARE_RESULT_MODULE(5);
-    DECLARE_RESULT(SectionExhaustion, 1);
-    DECLARE_RESULT(EntryExhaustion,   2);
-    DECLARE_RESULT(NullArgument,      3);
-    DECLARE_RESULT(InvalidPath,       4);
-    DECLARE_RESULT(DuplicatePath,     5);
-    DECLARE_RESULT(AlreadyLinked,     6);
+    DECLARE_RESULT(SectionExhaustion,       1);
+    DECLARE_RESULT(EntryExhaustion,         2);
+    DECLARE_RESULT(NullArgument,            3);
+    DECLARE_RESULT(InvalidPath,             4);
+    DECLARE_RESULT(DuplicatePath,           5);
+    DECLARE_RESULT(AlreadyLinked,           6);
+    DECLARE_RESULT(OutputExhaustion,        7);
+    DECLARE_RESULT(InvalidWorkMemorySize,   8);
+    DECLARE_RESULT(FailedToAllocateMemory,  9);
+    DECLARE_RESULT(InvalidContainerState,  10);
+    DECLARE_RESULT(DuplicateKey,           11);
 }
@@ -76,6 +76,7 @@
 #include <vp/util/util_ifunction.hpp>
 
 #include <vp/util/math/util_vectortypes.hpp>
+#include <vp/util/util_endianarray.hpp>
 #ifdef VP_TARGET_ARCHITECTURE_x86
     #include <vp/util/math/util_int128.avx2.hpp>
     #include <vp/util/math/util_float128.avx2.hpp>
@@ -87,18 +88,27 @@
 #endif
 #include <vp/util/math/util_vector2.hpp>
 #include <vp/util/math/util_constants.hpp>
+#include <vp/util/math/util_sincos.hpp>
+#include <vp/util/math/util_sincoscalc.h>
 #include <vp/util/math/util_vector3.hpp>
 #include <vp/util/math/util_vector3calc.h>
+#include <vp/util/math/util_boundingbox3.hpp>
+#include <vp/util/math/util_boundingsphere3.hpp>
 #include <vp/util/math/util_vector4.hpp>
 #include <vp/util/math/util_matrix33.hpp>
 #include <vp/util/math/util_matrix34.hpp>
 #include <vp/util/math/util_matrix34calc.h>
 #include <vp/util/math/util_matrix44.hpp>
+#include <vp/util/math/util_transformcalc.h>
+#include <vp/util/math/util_quaternion.hpp>
+#include <vp/util/math/util_quaternioncalc.h>
 #include <vp/util/math/util_clamp.hpp>
 
 #include <vp/util/util_logicalframebuffer.hpp>
 #include <vp/util/util_viewport.hpp>
 #include <vp/util/util_camera.hpp>
 #include <vp/util/util_projection.hpp>
+#include <vp/util/util_frustum.h>
+#include <vp/util/util_dynamicbvh.h>
 
 #include <vp/util/util_deltatime.h>
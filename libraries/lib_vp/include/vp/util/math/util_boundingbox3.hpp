@@ -0,0 +1,41 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::util {
+
+    template <typename T>
+    struct BoundingBox3 {
+        Vector3Type<T> min;
+        Vector3Type<T> max;
+    };
+
+    using BoundingBox3f = BoundingBox3<float>;
+
+    /* Structure of arrays view over bounding boxes, T is float or const float */
+    template <typename T>
+    struct BoundingBox3SoaArray {
+        T *min_x;
+        T *min_y;
+        T *min_z;
+        T *max_x;
+        T *max_y;
+        T *max_z;
+    };
+
+    using BoundingBox3fSoaArray      = BoundingBox3SoaArray<float>;
+    using ConstBoundingBox3fSoaArray = BoundingBox3SoaArray<const float>;
+}
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::util {
+
+    template <typename T>
+    struct BoundingSphere3 {
+        Vector3Type<T> center;
+        T              radius;
+    };
+
+    using BoundingSphere3f = BoundingSphere3<float>;
+
+    /* Structure of arrays view over bounding spheres, T is float or const float */
+    template <typename T>
+    struct BoundingSphere3SoaArray {
+        T *center_x;
+        T *center_y;
+        T *center_z;
+        T *radius;
+    };
+
+    using BoundingSphere3fSoaArray      = BoundingSphere3SoaArray<float>;
+    using ConstBoundingSphere3fSoaArray = BoundingSphere3SoaArray<const float>;
+}
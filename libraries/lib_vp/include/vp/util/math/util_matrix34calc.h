@@ -23,4 +23,7 @@ namespace vp::util {
     void RotateLocalY(Matrix34f *out_rot_matrix, float theta);
 
     void RotateLocalZ(Matrix34f *out_rot_matrix, float theta);
+
+    /* out = lhs * rhs, treating both as affine 4x4 matrices. out may alias either operand */
+    void MultiplyMatrix34(Matrix34f *out_matrix, const Matrix34f &lhs, const Matrix34f &rhs);
 }
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::util {
+
+    /* Rotation quaternion stored as (x, y, z, w) in a v4f */
+    class Quaternionf {
+        public:
+            union {
+                v4f m_vec;
+                struct {
+                    float x;
+                    float y;
+                    float z;
+                    float w;
+                };
+            };
+        public:
+            constexpr ALWAYS_INLINE Quaternionf() : m_vec{0.0f, 0.0f, 0.0f, 1.0f} {/*...*/}
+            constexpr ALWAYS_INLINE Quaternionf(float x, float y, float z, float w) : m_vec{x, y, z, w} {/*...*/}
+            constexpr ALWAYS_INLINE Quaternionf(const v4f &vec) : m_vec(vec) {/*...*/}
+            constexpr ALWAYS_INLINE Quaternionf(const Quaternionf &rhs) : m_vec(rhs.m_vec) {/*...*/}
+
+            constexpr ~Quaternionf() {/*...*/}
+
+            constexpr ALWAYS_INLINE Quaternionf &operator=(const Quaternionf &rhs) {
+                m_vec = rhs.m_vec;
+                return *this;
+            }
+
+            constexpr ALWAYS_INLINE v4f GetVectorType() const { return m_vec; }
+
+            /* Hamilton product, applies rhs then this */
+            constexpr ALWAYS_INLINE Quaternionf operator*(const Quaternionf &rhs) const {
+                const v4f rhs_wzyx = __builtin_shuffle(rhs.m_vec, v4si{ 3, 2, 1, 0 }) * v4f{  1.0f, -1.0f,  1.0f, -1.0f };
+                const v4f rhs_zwxy = __builtin_shuffle(rhs.m_vec, v4si{ 2, 3, 0, 1 }) * v4f{  1.0f,  1.0f, -1.0f, -1.0f };
+                const v4f rhs_yxwz = __builtin_shuffle(rhs.m_vec, v4si{ 1, 0, 3, 2 }) * v4f{ -1.0f,  1.0f,  1.0f, -1.0f };
+                return Quaternionf(rhs.m_vec * m_vec[3] + rhs_wzyx * m_vec[0] + rhs_zwxy * m_vec[1] + rhs_yxwz * m_vec[2]);
+            }
+            constexpr ALWAYS_INLINE Quaternionf &operator*=(const Quaternionf &rhs) {
+                m_vec = (*this * rhs).m_vec;
+                return *this;
+            }
+
+            constexpr ALWAYS_INLINE bool operator==(const Quaternionf &rhs) const {
+                return (m_vec[0] == rhs.m_vec[0]) & (m_vec[1] == rhs.m_vec[1]) & (m_vec[2] == rhs.m_vec[2]) & (m_vec[3] == rhs.m_vec[3]);
+            }
+
+            constexpr ALWAYS_INLINE float Dot(const Quaternionf &rhs) const {
+                const v4f product = m_vec * rhs.m_vec;
+                return product[0] + product[1] + product[2] + product[3];
+            }
+            constexpr ALWAYS_INLINE float GetLengthSquared() const { return this->Dot(*this); }
+
+            constexpr ALWAYS_INLINE Quaternionf GetConjugate() const {
+                return Quaternionf(m_vec * v4f{ -1.0f, -1.0f, -1.0f, 1.0f });
+            }
+            ALWAYS_INLINE Quaternionf GetInverse() const {
+                return Quaternionf(this->GetConjugate().m_vec / this->GetLengthSquared());
+            }
+            ALWAYS_INLINE Quaternionf GetNormalized() const {
+                return Quaternionf(m_vec / ::sqrtf(this->GetLengthSquared()));
+            }
+            ALWAYS_INLINE void Normalize() {
+                m_vec = m_vec / ::sqrtf(this->GetLengthSquared());
+            }
+
+            /* Rotates a vector, v' = q * (v, 0) * q^-1 for a unit quaternion */
+            constexpr ALWAYS_INLINE Vector3f Rotate(const Vector3f &vector) const {
+                const Vector3f axis(x, y, z);
+                const Vector3f t = Vector3f(Cross(axis, vector).GetVectorType() * 2.0f);
+                return Vector3f(vector.GetVectorType() + t.GetVectorType() * w + Cross(axis, t).GetVectorType());
+            }
+
+            static ALWAYS_INLINE Quaternionf MakeAxisAngle(const Vector3f &unit_axis, float angle) {
+                float sin = 0.0f;
+                float cos = 0.0f;
+                SinCos(std::addressof(sin), std::addressof(cos), angle * 0.5f);
+                return Quaternionf(unit_axis.x * sin, unit_axis.y * sin, unit_axis.z * sin, cos);
+            }
+        private:
+            static constexpr ALWAYS_INLINE Vector3f Cross(const Vector3f &lhs, const Vector3f &rhs) {
+                return Vector3f(lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x);
+            }
+    };
+    static_assert(sizeof(Quaternionf) == sizeof(v4f));
+}
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::util {
+
+    /* Rotation part of a matrix from a unit quaternion, and back. The matrix must be orthonormal */
+    void MakeMatrix34FromQuaternion(Matrix34f *out_matrix, const Quaternionf &quaternion, const Vector3f &translate = Vector3f(0.0f, 0.0f, 0.0f));
+    void MakeQuaternionFromMatrix34(Quaternionf *out_quaternion, const Matrix34f &matrix);
+
+    /* Interpolations take the shortest arc and return unit quaternions */
+
+    /* Normalized lerp, constant speed is not preserved */
+    void Nlerp(Quaternionf *out_quaternion, const Quaternionf &from, const Quaternionf &to, float t);
+
+    /* Spherical lerp through acos and sin */
+    void Slerp(Quaternionf *out_quaternion, const Quaternionf &from, const Quaternionf &to, float t);
+
+    /* Nlerp with a fitted correction of t approximating slerp, max angle error is around 1e-3 radians */
+    void SlerpFast(Quaternionf *out_quaternion, const Quaternionf &from, const Quaternionf &to, float t);
+
+    /* Batch versions, out[i] = interpolate(from[i], to[i], t). Eight quaternions are blended per iteration, out may alias either input */
+    void NlerpQuaternionArray(Quaternionf *out_quaternion_array, const Quaternionf *from_array, const Quaternionf *to_array, float t, u32 count);
+    void SlerpQuaternionArray(Quaternionf *out_quaternion_array, const Quaternionf *from_array, const Quaternionf *to_array, float t, u32 count);
+    void SlerpFastQuaternionArray(Quaternionf *out_quaternion_array, const Quaternionf *from_array, const Quaternionf *to_array, float t, u32 count);
+}
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::util {
+
+    /* Polynomial accuracy of SinCos, Fast is ~1.3e-5 absolute error and Precise is within a few ulp */
+    enum class SinCosAccuracy : u32 {
+        Fast,
+        Precise,
+    };
+
+    namespace impl {
+
+        template <typename T>
+        struct SinCosLaneTraits {};
+        template <>
+        struct SinCosLaneTraits<float> { using UnsignedType = u32; };
+        template <>
+        struct SinCosLaneTraits<v4f>   { using UnsignedType = v4ui; };
+        template <>
+        struct SinCosLaneTraits<v8f>   { using UnsignedType = v8ui; };
+
+        /* Adding 1.5 * 2^23 rounds to the nearest integer and leaves it in the low mantissa bits */
+        constexpr inline float cSinCosRoundMagic   = 12582912.0f;
+        constexpr inline float cSinCos2DividedPi   = 0.63661977f;
+
+        /* pi / 2 split into 8 bit parts so each product with a quadrant below 2^16 is exact */
+        constexpr inline float cSinCosPiDivided2Hi   = 1.5703125f;
+        constexpr inline float cSinCosPiDivided2Mid0 = 4.84466552734375e-4f;
+        constexpr inline float cSinCosPiDivided2Mid1 = -6.4074993133544921875e-7f;
+        constexpr inline float cSinCosPiDivided2Lo   = 9.920936294705e-10f;
+    }
+
+    /* Computes sin and cos of radians "angle" for float, v4f or v8f without table lookups, full precision for |angle| < 2^16 */
+    template <SinCosAccuracy Accuracy = SinCosAccuracy::Precise, typename T>
+    constexpr ALWAYS_INLINE void SinCos(T *out_sin, T *out_cos, T angle) {
+
+        using UnsignedType = typename impl::SinCosLaneTraits<T>::UnsignedType;
+
+        /* Reduce to [-pi/4, pi/4] around the nearest quarter turn */
+        const T shifted  = angle * impl::cSinCos2DividedPi + impl::cSinCosRoundMagic;
+        const T quadrant = shifted - impl::cSinCosRoundMagic;
+        const T r        = (((angle - quadrant * impl::cSinCosPiDivided2Hi) - quadrant * impl::cSinCosPiDivided2Mid0) - quadrant * impl::cSinCosPiDivided2Mid1) - quadrant * impl::cSinCosPiDivided2Lo;
+        const T r2       = r * r;
+
+        /* Evaluate both polynomials on the reduced angle */
+        T sin = {};
+        T cos = {};
+        if constexpr (Accuracy == SinCosAccuracy::Precise) {
+            sin = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+            cos = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+        } else {
+            sin = r + r * r2 * (-1.6662833e-1f + r2 * 8.152984e-3f);
+            cos = 1.0f + r2 * (-4.9977630e-1f + r2 * 4.0488904e-2f);
+        }
+
+        /* Swap and negate by quadrant, sin(x) = { s, c, -s, -c } and cos(x) = { c, -s, -c, s } */
+        const UnsignedType quadrant_index = std::bit_cast<UnsignedType>(shifted);
+        const UnsignedType swap_mask      = 0u - (quadrant_index & 1u);
+        const UnsignedType sin_bits       = std::bit_cast<UnsignedType>(sin);
+        const UnsignedType cos_bits       = std::bit_cast<UnsignedType>(cos);
+        *out_sin = std::bit_cast<T>(((sin_bits & ~swap_mask) | (cos_bits & swap_mask)) ^ ((quadrant_index & 2u) << 30));
+        *out_cos = std::bit_cast<T>(((cos_bits & ~swap_mask) | (sin_bits & swap_mask)) ^ (((quadrant_index + 1u) & 2u) << 30));
+    }
+
+    template <SinCosAccuracy Accuracy = SinCosAccuracy::Precise>
+    constexpr ALWAYS_INLINE float Sin(float angle) {
+        float sin = 0.0f;
+        float cos = 0.0f;
+        SinCos<Accuracy>(std::addressof(sin), std::addressof(cos), angle);
+        return sin;
+    }
+
+    template <SinCosAccuracy Accuracy = SinCosAccuracy::Precise>
+    constexpr ALWAYS_INLINE float Cos(float angle) {
+        float sin = 0.0f;
+        float cos = 0.0f;
+        SinCos<Accuracy>(std::addressof(sin), std::addressof(cos), angle);
+        return cos;
+    }
+}
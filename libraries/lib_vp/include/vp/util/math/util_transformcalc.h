@@ -0,0 +1,43 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::util {
+
+    /* Batch transforms, processed eight at a time. Outputs may alias inputs, 32 byte aligned SoA point and normal arrays take an aligned load path */
+
+    /* out = matrix * (point, 1) */
+    void TransformPointArray(Vector3f *out_point_array, const Matrix34f &matrix, const Vector3f *point_array, u32 count);
+    void TransformPointArraySoa(float *out_x_array, float *out_y_array, float *out_z_array, const Matrix34f &matrix, const float *x_array, const float *y_array, const float *z_array, u32 count);
+
+    /* out = matrix * (normal, 0). Pass the inverse transpose for non-uniform scale, the result is not normalized */
+    void TransformNormalArray(Vector3f *out_normal_array, const Matrix34f &matrix, const Vector3f *normal_array, u32 count);
+    void TransformNormalArraySoa(float *out_x_array, float *out_y_array, float *out_z_array, const Matrix34f &matrix, const float *x_array, const float *y_array, const float *z_array, u32 count);
+
+    /* out[i] = lhs[i] * rhs[i], or lhs * rhs[i] */
+    void MultiplyMatrix34Array(Matrix34f *out_matrix_array, const Matrix34f *lhs_matrix_array, const Matrix34f *rhs_matrix_array, u32 count);
+    void MultiplyMatrix34Array(Matrix34f *out_matrix_array, const Matrix34f &lhs_matrix, const Matrix34f *rhs_matrix_array, u32 count);
+
+    /* out = lhs * rhs. out may alias either operand */
+    void MultiplyMatrix44(Matrix44f *out_matrix, const Matrix44f &lhs, const Matrix44f &rhs);
+    void MultiplyMatrix44Array(Matrix44f *out_matrix_array, const Matrix44f *lhs_matrix_array, const Matrix44f *rhs_matrix_array, u32 count);
+    void MultiplyMatrix44Array(Matrix44f *out_matrix_array, const Matrix44f &lhs_matrix, const Matrix44f *rhs_matrix_array, u32 count);
+
+    /* Axis aligned bounds of a transformed bounding box */
+    void TransformBoundingBox3(BoundingBox3f *out_box, const Matrix34f &matrix, const BoundingBox3f &box);
+    void TransformBoundingBox3Array(BoundingBox3f *out_box_array, const Matrix34f &matrix, const BoundingBox3f *box_array, u32 count);
+    void TransformBoundingBox3ArraySoa(const BoundingBox3fSoaArray &out_box_array, const Matrix34f &matrix, const ConstBoundingBox3fSoaArray &box_array, u32 count);
+}
@@ -72,11 +72,98 @@ namespace vp::util {
         return THashDataCrc32bWithContext(0xffff'ffff, data, data_size);
     }
 
+    constexpr inline size_t cCrc32bFoldThreshold = 0x100;
+
+    namespace impl {
+
+        constexpr inline u64 cCrc32bFold512Constant0 = 0x1'5444'2bd4;
+        constexpr inline u64 cCrc32bFold512Constant1 = 0x1'c6e4'1596;
+        constexpr inline u64 cCrc32bFold128Constant0 = 0x1'7519'97d0;
+        constexpr inline u64 cCrc32bFold128Constant1 = 0x0'ccaa'009e;
+        constexpr inline u64 cCrc32bFold64Constant   = 0x1'63cd'6124;
+        constexpr inline u64 cCrc32bBarrettConstant0 = 0x1'db71'0641;
+        constexpr inline u64 cCrc32bBarrettConstant1 = 0x1'f701'1641;
+        constexpr inline u64 cCrc32bLow32Mask        = 0xffff'ffff;
+
+        ALWAYS_INLINE uint64x2_t Pmull(u64 a, u64 b) {
+            return vreinterpretq_u64_p128(vmull_p64(static_cast<poly64_t>(a), static_cast<poly64_t>(b)));
+        }
+
+        ALWAYS_INLINE uint64x2_t FoldCrc32bBlock(uint64x2_t state, uint64x2_t block, u64 constant0, u64 constant1) {
+            return veorq_u64(veorq_u64(Pmull(vgetq_lane_u64(state, 0), constant0), Pmull(vgetq_lane_u64(state, 1), constant1)), block);
+        }
+
+        /* Folds a multiple of 16 bytes of at least 64 bytes using four independent pmull lanes, returning the raw crc32b state */
+        ALWAYS_INLINE u32 FoldCrc32b(u32 seed, const u8 *data, size_t data_size) {
+
+            /* Load the first four blocks with the seed */
+            uint64x2_t state0 = veorq_u64(vld1q_u64(reinterpret_cast<const u64*>(data + 0x00)), vsetq_lane_u64(static_cast<u64>(seed), vdupq_n_u64(0), 0));
+            uint64x2_t state1 = vld1q_u64(reinterpret_cast<const u64*>(data + 0x10));
+            uint64x2_t state2 = vld1q_u64(reinterpret_cast<const u64*>(data + 0x20));
+            uint64x2_t state3 = vld1q_u64(reinterpret_cast<const u64*>(data + 0x30));
+            data      = data + 0x40;
+            data_size = data_size - 0x40;
+
+            /* Fold 64 bytes per iteration */
+            while (0x40 <= data_size) {
+                state0    = FoldCrc32bBlock(state0, vld1q_u64(reinterpret_cast<const u64*>(data + 0x00)), cCrc32bFold512Constant0, cCrc32bFold512Constant1);
+                state1    = FoldCrc32bBlock(state1, vld1q_u64(reinterpret_cast<const u64*>(data + 0x10)), cCrc32bFold512Constant0, cCrc32bFold512Constant1);
+                state2    = FoldCrc32bBlock(state2, vld1q_u64(reinterpret_cast<const u64*>(data + 0x20)), cCrc32bFold512Constant0, cCrc32bFold512Constant1);
+                state3    = FoldCrc32bBlock(state3, vld1q_u64(reinterpret_cast<const u64*>(data + 0x30)), cCrc32bFold512Constant0, cCrc32bFold512Constant1);
+                data      = data + 0x40;
+                data_size = data_size - 0x40;
+            }
+
+            /* Fold lanes into one */
+            uint64x2_t state = FoldCrc32bBlock(state0, state1, cCrc32bFold128Constant0, cCrc32bFold128Constant1);
+            state            = FoldCrc32bBlock(state,  state2, cCrc32bFold128Constant0, cCrc32bFold128Constant1);
+            state            = FoldCrc32bBlock(state,  state3, cCrc32bFold128Constant0, cCrc32bFold128Constant1);
+
+            /* Fold remaining blocks */
+            while (0x10 <= data_size) {
+                state     = FoldCrc32bBlock(state, vld1q_u64(reinterpret_cast<const u64*>(data)), cCrc32bFold128Constant0, cCrc32bFold128Constant1);
+                data      = data + 0x10;
+                data_size = data_size - 0x10;
+            }
+
+            /* Fold 128 bits to 64 bits */
+            const u64 state_lo = vgetq_lane_u64(state, 0);
+            const u64 state_hi = vgetq_lane_u64(state, 1);
+            uint64x2_t fold    = veorq_u64(Pmull(state_lo, cCrc32bFold128Constant1), vcombine_u64(vcreate_u64(state_hi), vcreate_u64(0)));
+            const u64 fold_lo  = vgetq_lane_u64(fold, 0);
+            const u64 fold_hi  = vgetq_lane_u64(fold, 1);
+            fold               = veorq_u64(Pmull(fold_lo & cCrc32bLow32Mask, cCrc32bFold64Constant), vcombine_u64(vcreate_u64((fold_lo >> 32) | (fold_hi << 32)), vcreate_u64(fold_hi >> 32)));
+
+            /* Barrett reduce to 32 bits */
+            const u64 reduce0 = vgetq_lane_u64(Pmull(vgetq_lane_u64(fold, 0) & cCrc32bLow32Mask, cCrc32bBarrettConstant1), 0);
+            const u64 reduce1 = vgetq_lane_u64(Pmull(reduce0 & cCrc32bLow32Mask, cCrc32bBarrettConstant0), 0);
+
+            return static_cast<u32>((vgetq_lane_u64(fold, 0) ^ reduce1) >> 32);
+        }
+    }
+
     ALWAYS_INLINE u32 HashDataCrc32bWithContext(u32 context, void *data, size_t data_size) {
 
         u32 seed = context;
         const u8 *iter = reinterpret_cast<const u8*>(data);
 
+        /* Fold large buffers 64 bytes at a time */
+        if (cCrc32bFoldThreshold <= data_size) {
+            const size_t fold_size = data_size & ~static_cast<size_t>(0xf);
+            seed      = impl::FoldCrc32b(seed, iter, fold_size);
+            iter      = iter + fold_size;
+            data_size = data_size - fold_size;
+        }
+
+        /* Hardware crc32 8 bytes at a time */
+        while (sizeof(u64) <= data_size) {
+            u64 value = 0;
+            ::memcpy(std::addressof(value), iter, sizeof(u64));
+            seed      = __crc32d(seed, value);
+            iter      = iter + sizeof(u64);
+            data_size = data_size - sizeof(u64);
+        }
+
         /* Fallback for rest of string */
         u32 count = data_size;
         while (count != 0) {
@@ -132,10 +132,84 @@ namespace vp::util {
         return THashDataCrc32bWithContext(0xffff'ffff, data, data_size);
     }
 
+    constexpr inline size_t cCrc32bFoldThreshold = 0x100;
+
+    namespace impl {
+
+        constexpr inline v2ull cCrc32bFold512Constant   = {0x1'5444'2bd4, 0x1'c6e4'1596};
+        constexpr inline v2ull cCrc32bFold128Constant   = {0x1'7519'97d0, 0x0'ccaa'009e};
+        constexpr inline v2ull cCrc32bFold64Constant    = {0x1'63cd'6124, 0};
+        constexpr inline v2ull cCrc32bBarrettConstant   = {0x1'db71'0641, 0x1'f701'1641};
+        constexpr inline v2ull cCrc32bLow32Mask         = {0xffff'ffff, 0xffff'ffff};
+
+        ALWAYS_INLINE v2ull LoadCrc32bBlock(const u8 *data) {
+            v2ull block;
+            ::memcpy(std::addressof(block), data, sizeof(v2ull));
+            return block;
+        }
+
+        ALWAYS_INLINE v2ull FoldCrc32bBlock(v2ull state, v2ull block, v2ull constant) {
+            return avx2::pclmulqdq(state, constant, avx2::PclmulSelectionMask(false, false)) ^ avx2::pclmulqdq(state, constant, avx2::PclmulSelectionMask(true, true)) ^ block;
+        }
+
+        /* Folds a multiple of 16 bytes of at least 64 bytes using four independent pclmul lanes, returning the raw crc32b state */
+        ALWAYS_INLINE u32 FoldCrc32b(u32 seed, const u8 *data, size_t data_size) {
+
+            /* Load the first four blocks with the seed */
+            v2ull state0 = LoadCrc32bBlock(data + 0x00) ^ v2ull{seed, 0};
+            v2ull state1 = LoadCrc32bBlock(data + 0x10);
+            v2ull state2 = LoadCrc32bBlock(data + 0x20);
+            v2ull state3 = LoadCrc32bBlock(data + 0x30);
+            data      = data + 0x40;
+            data_size = data_size - 0x40;
+
+            /* Fold 64 bytes per iteration */
+            while (0x40 <= data_size) {
+                state0    = FoldCrc32bBlock(state0, LoadCrc32bBlock(data + 0x00), cCrc32bFold512Constant);
+                state1    = FoldCrc32bBlock(state1, LoadCrc32bBlock(data + 0x10), cCrc32bFold512Constant);
+                state2    = FoldCrc32bBlock(state2, LoadCrc32bBlock(data + 0x20), cCrc32bFold512Constant);
+                state3    = FoldCrc32bBlock(state3, LoadCrc32bBlock(data + 0x30), cCrc32bFold512Constant);
+                data      = data + 0x40;
+                data_size = data_size - 0x40;
+            }
+
+            /* Fold lanes into one */
+            v2ull state = FoldCrc32bBlock(state0, state1, cCrc32bFold128Constant);
+            state       = FoldCrc32bBlock(state,  state2, cCrc32bFold128Constant);
+            state       = FoldCrc32bBlock(state,  state3, cCrc32bFold128Constant);
+
+            /* Fold remaining blocks */
+            while (0x10 <= data_size) {
+                state     = FoldCrc32bBlock(state, LoadCrc32bBlock(data), cCrc32bFold128Constant);
+                data      = data + 0x10;
+                data_size = data_size - 0x10;
+            }
+
+            /* Fold 128 bits to 64 bits */
+            state = avx2::pclmulqdq(state, cCrc32bFold128Constant, avx2::PclmulSelectionMask(false, true)) ^ v2ull{state[1], 0};
+            state = avx2::pclmulqdq(state & cCrc32bLow32Mask, cCrc32bFold64Constant, avx2::PclmulSelectionMask(false, false)) ^ v2ull{(state[0] >> 32) | (state[1] << 32), state[1] >> 32};
+
+            /* Barrett reduce to 32 bits */
+            v2ull reduce = avx2::pclmulqdq(state & cCrc32bLow32Mask, cCrc32bBarrettConstant, avx2::PclmulSelectionMask(false, true));
+            reduce       = avx2::pclmulqdq(reduce & cCrc32bLow32Mask, cCrc32bBarrettConstant, avx2::PclmulSelectionMask(false, false));
+            state        = state ^ reduce;
+
+            return static_cast<u32>(state[0] >> 32);
+        }
+    }
+
     ALWAYS_INLINE u32 HashDataCrc32bWithContext(u32 context, void *data, size_t data_size) {
 
         u32 seed = context;
 
+        /* Fold large buffers 64 bytes at a time */
+        if (cCrc32bFoldThreshold <= data_size) {
+            const size_t fold_size = data_size & ~static_cast<size_t>(0xf);
+            seed      = impl::FoldCrc32b(seed, reinterpret_cast<const u8*>(data), fold_size);
+            data      = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(data) + fold_size);
+            data_size = data_size - fold_size;
+        }
+
         /* Perform 8 byte aligned version of crc32 */
         const size_t aligned_size = (data_size & ~7);
         const u64 *data_iter     = reinterpret_cast<const u64*>(data);
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::util {
+
+    /* Structure of arrays view over rays, t is measured in units of the direction */
+    template <typename T>
+    struct Ray3SoaArray {
+        T *origin_x;
+        T *origin_y;
+        T *origin_z;
+        T *direction_x;
+        T *direction_y;
+        T *direction_z;
+        T *max_t;
+    };
+
+    using Ray3fSoaArray      = Ray3SoaArray<float>;
+    using ConstRay3fSoaArray = Ray3SoaArray<const float>;
+
+    /* Dynamic AABB tree over proxies, balanced on insert and queried 8 boxes or rays at a time */
+    class DynamicBvh {
+        public:
+            static constexpr u32 cInvalidIndex           = 0xffff'ffff;
+            static constexpr u32 cMaxTraversalDepth      = 128;
+            static constexpr u32 cMaxRebuildSubtreeCount = 64;
+        public:
+            /* Invoked with the query index and proxy id of each overlap */
+            using OverlapCallback = IFunction<void(u32, u32)>;
+            /* Invoked with the ray index, proxy id and current max t of each box hit, returns the new max t or a negative value to stop the ray */
+            using RayCastCallback = IFunction<float(u32, u32, float)>;
+        private:
+            /* One cache line per node, children bounds are stored in the parent so both are tested without touching them */
+            struct alignas(64) Node {
+                float child_min_x[2];
+                float child_min_y[2];
+                float child_min_z[2];
+                float child_max_x[2];
+                float child_max_y[2];
+                float child_max_z[2];
+                union {
+                    u32   child_index[2];
+                    void *user_data;
+                };
+                u32 parent_index;
+                u16 height;
+                u16 parent_slot;
+
+                constexpr ALWAYS_INLINE bool IsLeaf() const { return height == 0; }
+            };
+            static_assert(sizeof(Node) == 64);
+
+            struct BuildEntry {
+                BoundingBox3f box;
+                u32           leaf_index;
+            };
+
+            struct RebuildRange {
+                u32 leaf_begin;
+                u32 leaf_end;
+                u32 slot_base;
+                u32 parent_index;
+                u32 parent_slot;
+            };
+
+            struct TraversalEntry {
+                u32 node_index;
+                u32 lane_mask;
+            };
+
+            struct OverlapPacket;
+            struct RayPacket;
+        private:
+            Node          *m_node_array;
+            BuildEntry    *m_build_entry_array;
+            u32           *m_internal_slot_array;
+            u32            m_node_capacity;
+            u32            m_max_proxy_count;
+            u32            m_proxy_count;
+            u32            m_root_index;
+            u32            m_free_index;
+            BoundingBox3f  m_root_box;
+            u32            m_rebuild_range_count;
+            u32            m_top_node_count;
+            RebuildRange   m_rebuild_range_array[cMaxRebuildSubtreeCount];
+            u32            m_top_node_array[cMaxRebuildSubtreeCount];
+        private:
+            u32  AllocateNode();
+            void FreeNode(u32 node_index);
+
+            static BoundingBox3f GetChildBoundingBox(const Node &node, u32 slot);
+            static void          SetChildBoundingBox(Node *node, u32 slot, const BoundingBox3f &box);
+
+            BoundingBox3f GetNodeBoundingBox(u32 node_index) const;
+            void          SetNodeBoundingBox(u32 node_index, const BoundingBox3f &box);
+
+            void SetChild(u32 parent_index, u32 slot, u32 child_index, const BoundingBox3f &box);
+            void SetRoot(u32 node_index, const BoundingBox3f &box);
+
+            u32  RotateUp(u32 node_index, u32 heavy_slot);
+            u32  Balance(u32 node_index);
+            void UpdateAncestors(u32 node_index);
+
+            u32 SplitBuildRange(u32 leaf_begin, u32 leaf_end);
+            u32 BuildRange(BoundingBox3f *out_box, u32 leaf_begin, u32 leaf_end, u32 slot_base);
+
+            void QueryOverlapPacket(const OverlapPacket &packet, u32 lane_mask, u32 query_base, OverlapCallback *callback) const;
+            void RayCastPacket(RayPacket *packet, u32 lane_mask, u32 ray_base, RayCastCallback *callback) const;
+        public:
+            constexpr DynamicBvh() : m_node_array(nullptr), m_build_entry_array(nullptr), m_internal_slot_array(nullptr), m_node_capacity(0), m_max_proxy_count(0), m_proxy_count(0), m_root_index(cInvalidIndex), m_free_index(cInvalidIndex), m_root_box{}, m_rebuild_range_count(0), m_top_node_count(0), m_rebuild_range_array{}, m_top_node_array{} {/*...*/}
+            constexpr ~DynamicBvh() {/*...*/}
+
+            bool Initialize(imem::IHeap *heap, u32 max_proxy_count);
+            void Finalize();
+
+            /* Returns a proxy id that stays valid until removed, or cInvalidIndex when full */
+            u32  Insert(const BoundingBox3f &box, void *user_data);
+            void Remove(u32 proxy_id);
+
+            /* Replaces the bounds of a proxy and refits its ancestors without restructuring the tree */
+            void Refit(u32 proxy_id, const BoundingBox3f &box);
+
+            void QueryOverlap(const BoundingBox3f &box, OverlapCallback *callback) const;
+            void QueryOverlapArray(const ConstBoundingBox3fSoaArray &box_array, u32 query_count, OverlapCallback *callback) const;
+
+            void RayCast(const Vector3f &origin, const Vector3f &direction, float max_t, RayCastCallback *callback) const;
+            void RayCastArray(const ConstRay3fSoaArray &ray_array, u32 ray_count, RayCastCallback *callback) const;
+
+            /* Median split rebuild, the top of the tree is split into up to "max_subtree_count" subtrees that may be built in parallel before EndRebuild */
+            u32  BeginRebuild(u32 max_subtree_count);
+            void RebuildSubtree(u32 subtree_index);
+            void EndRebuild();
+            void Rebuild();
+
+            constexpr ALWAYS_INLINE void *GetUserData(u32 proxy_id) const { return m_node_array[proxy_id].user_data; }
+            ALWAYS_INLINE BoundingBox3f   GetBoundingBox(u32 proxy_id) const { return this->GetNodeBoundingBox(proxy_id); }
+
+            constexpr ALWAYS_INLINE u32 GetProxyCount()    const { return m_proxy_count; }
+            constexpr ALWAYS_INLINE u32 GetMaxProxyCount() const { return m_max_proxy_count; }
+            constexpr ALWAYS_INLINE u32 GetHeight()        const { return (m_root_index == cInvalidIndex) ? 0 : m_node_array[m_root_index].height; }
+    };
+
+    /* Builds a range of subtrees from DynamicBvh::BeginRebuild, register every rebuild job as a parent of the finish job */
+    class DynamicBvhRebuildJob : public Job {
+        private:
+            DynamicBvh *m_bvh;
+            u32         m_base_subtree_index;
+            u32         m_subtree_count;
+        public:
+            constexpr DynamicBvhRebuildJob() : Job("DynamicBvhRebuildJob"), m_bvh(nullptr), m_base_subtree_index(0), m_subtree_count(0) {/*...*/}
+            constexpr ~DynamicBvhRebuildJob() {/*...*/}
+
+            constexpr void Initialize(DynamicBvh *bvh, u32 base_subtree_index, u32 subtree_count) {
+                m_bvh                = bvh;
+                m_base_subtree_index = base_subtree_index;
+                m_subtree_count      = subtree_count;
+            }
+
+            virtual void Invoke() override {
+                for (u32 i = 0; i < m_subtree_count; ++i) {
+                    m_bvh->RebuildSubtree(m_base_subtree_index + i);
+                }
+            }
+    };
+
+    class DynamicBvhRebuildFinishJob : public Job {
+        private:
+            DynamicBvh *m_bvh;
+        public:
+            constexpr DynamicBvhRebuildFinishJob() : Job("DynamicBvhRebuildFinishJob"), m_bvh(nullptr) {/*...*/}
+            constexpr ~DynamicBvhRebuildFinishJob() {/*...*/}
+
+            constexpr void Initialize(DynamicBvh *bvh) {
+                m_bvh = bvh;
+            }
+
+            virtual void Invoke() override {
+                m_bvh->EndRebuild();
+            }
+    };
+}
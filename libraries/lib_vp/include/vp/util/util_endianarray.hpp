@@ -0,0 +1,51 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::util {
+
+    namespace impl {
+
+        template <size_t Size, size_t ...Indices>
+        consteval v32uc MakeSwapEndianShuffleMask(std::index_sequence<Indices...>) {
+            return v32uc{ static_cast<unsigned char>(Indices ^ (Size - 1))... };
+        }
+    }
+
+    template <typename T>
+        requires (std::is_integral<T>::value) && (sizeof(T) == sizeof(u64) || sizeof(T) == sizeof(u32) || sizeof(T) == sizeof(u16))
+    void SwapEndianArray(T *array, size_t count) {
+
+        /* Byte shuffle 32 bytes at a time, lowers to a pshufb on x86 and a tbl on aarch64 */
+        constexpr v32uc  cShuffleMask      = impl::MakeSwapEndianShuffleMask<sizeof(T)>(std::make_index_sequence<sizeof(v32uc)>());
+        constexpr size_t cElementsPerBlock = sizeof(v32uc) / sizeof(T);
+        const size_t block_count = count / cElementsPerBlock;
+        for (size_t i = 0; i < block_count; ++i) {
+            void  *block = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(array) + sizeof(v32uc) * i);
+            v32uc  value;
+            ::memcpy(std::addressof(value), block, sizeof(v32uc));
+            value = __builtin_shuffle(value, cShuffleMask);
+            ::memcpy(block, std::addressof(value), sizeof(v32uc));
+        }
+
+        /* Swap remainder */
+        for (size_t i = block_count * cElementsPerBlock; i < count; ++i) {
+            array[i] = SwapEndian(array[i]);
+        }
+
+        return;
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace vp::util {
+
+    /* View frustum as 6 world space planes, a point p is inside a plane when dot(plane.xyz, p) + plane.w >= 0 */
+    class Frustum {
+        public:
+            enum PlaneIndex : u32 {
+                PlaneIndex_Left   = 0,
+                PlaneIndex_Right  = 1,
+                PlaneIndex_Bottom = 2,
+                PlaneIndex_Top    = 3,
+                PlaneIndex_Near   = 4,
+                PlaneIndex_Far    = 5,
+            };
+            static constexpr u32 cPlaneCount = 6;
+        private:
+            Vector4f m_plane_array[cPlaneCount];
+        public:
+            constexpr Frustum() : m_plane_array{} {/*...*/}
+            constexpr ~Frustum() {/*...*/}
+
+            /* Extracts normalized planes from a clip space transform, planes are in the source space of the matrix */
+            void Set(const Matrix44f &view_projection);
+            void Set(const Matrix44f &projection, const Matrix34f &view);
+            void Set(Projection *projection, const Camera *camera);
+
+            constexpr ALWAYS_INLINE const Vector4f &GetPlane(u32 plane_index) const { return m_plane_array[plane_index]; }
+
+            constexpr ALWAYS_INLINE bool IsSphereVisible(const Vector3f &center, float radius) const {
+                for (u32 i = 0; i < cPlaneCount; ++i) {
+                    const Vector4f &plane = m_plane_array[i];
+                    if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) { return false; }
+                }
+                return true;
+            }
+
+            constexpr ALWAYS_INLINE bool IsBoundingBoxVisible(const BoundingBox3f &box) const {
+                for (u32 i = 0; i < cPlaneCount; ++i) {
+
+                    /* Test the corner furthest along the plane normal */
+                    const Vector4f &plane = m_plane_array[i];
+                    const float x = (0.0f <= plane.x) ? box.max.x : box.min.x;
+                    const float y = (0.0f <= plane.y) ? box.max.y : box.min.y;
+                    const float z = (0.0f <= plane.z) ? box.max.z : box.min.z;
+                    if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f) { return false; }
+                }
+                return true;
+            }
+
+            /* Writes the index of each visible element in [base_index, base_index + count) to the output in order, returns the visible count */
+            u32 CullSphereArray(u32 *out_visible_index_array, const ConstBoundingSphere3fSoaArray &sphere_array, u32 base_index, u32 count) const;
+            u32 CullBoundingBoxArray(u32 *out_visible_index_array, const ConstBoundingBox3fSoaArray &box_array, u32 base_index, u32 count) const;
+    };
+
+    /* Culls a range of spheres or boxes, jobs over disjoint ranges can run in parallel and be merged with CompactVisibleIndexArray */
+    class FrustumCullJob : public Job {
+        public:
+            enum ShapeType : u32 {
+                ShapeType_Sphere      = 0,
+                ShapeType_BoundingBox = 1,
+            };
+        private:
+            const Frustum                 *m_frustum;
+            u32                           *m_visible_index_array;
+            ConstBoundingSphere3fSoaArray  m_sphere_array;
+            ConstBoundingBox3fSoaArray     m_box_array;
+            ShapeType                      m_shape_type;
+            u32                            m_base_index;
+            u32                            m_count;
+            u32                            m_visible_count;
+        public:
+            constexpr FrustumCullJob() : Job("FrustumCullJob"), m_frustum(nullptr), m_visible_index_array(nullptr), m_sphere_array{}, m_box_array{}, m_shape_type(ShapeType_Sphere), m_base_index(0), m_count(0), m_visible_count(0) {/*...*/}
+            constexpr ~FrustumCullJob() {/*...*/}
+
+            /* The output array must hold "count" indices */
+            constexpr void Initialize(const Frustum *frustum, u32 *out_visible_index_array, const ConstBoundingSphere3fSoaArray &sphere_array, u32 base_index, u32 count) {
+                m_frustum             = frustum;
+                m_visible_index_array = out_visible_index_array;
+                m_sphere_array        = sphere_array;
+                m_shape_type          = ShapeType_Sphere;
+                m_base_index          = base_index;
+                m_count               = count;
+                m_visible_count       = 0;
+            }
+            constexpr void Initialize(const Frustum *frustum, u32 *out_visible_index_array, const ConstBoundingBox3fSoaArray &box_array, u32 base_index, u32 count) {
+                m_frustum             = frustum;
+                m_visible_index_array = out_visible_index_array;
+                m_box_array           = box_array;
+                m_shape_type          = ShapeType_BoundingBox;
+                m_base_index          = base_index;
+                m_count               = count;
+                m_visible_count       = 0;
+            }
+
+            virtual void Invoke() override {
+                if (m_shape_type == ShapeType_Sphere) {
+                    m_visible_count = m_frustum->CullSphereArray(m_visible_index_array, m_sphere_array, m_base_index, m_count);
+                } else {
+                    m_visible_count = m_frustum->CullBoundingBoxArray(m_visible_index_array, m_box_array, m_base_index, m_count);
+                }
+            }
+
+            constexpr ALWAYS_INLINE const u32 *GetVisibleIndexArray() const { return m_visible_index_array; }
+            constexpr ALWAYS_INLINE u32        GetVisibleCount()      const { return m_visible_count; }
+
+            /* Packs the output of completed jobs into one list, job outputs must be in ascending address order at or after the output */
+            static u32 CompactVisibleIndexArray(u32 *out_visible_index_array, const FrustumCullJob *job_array, u32 job_count);
+    };
+}
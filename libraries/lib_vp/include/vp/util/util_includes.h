@@ -68,6 +68,12 @@
     //#include <vp/nn.hpp>
 #endif
 
+/* Architecture includes */
+#ifdef VP_TARGET_ARCHITECTURE_aarch64
+    #include <arm_neon.h>
+    #include <arm_acle.h>
+#endif
+
 /* zstd */
 #define ZSTD_STATIC_LINKING_ONLY
 #include <zstd.h>
@@ -102,8 +102,8 @@ namespace vp::util {
         public:
             VP_RTTI_DERIVED(PerspectiveProjection, FrustumProjection);
         public:
-            constexpr PerspectiveProjection() : FrustumProjection(1.0f, 10000.0f, TRadians<float, 45.0f>, ::sinf(TRadians<float, 45.0f> / 2), ::cosf(TRadians<float, 45.0f> / 2), ::tanf(TRadians<float, 45.0f> / 2)), m_fov_x(4.0 / 3.0f) {/*...*/}
-            constexpr PerspectiveProjection(float near, float far, float fovy, float aspect) : FrustumProjection(near, far, fovy, ::sinf(fovy / 2), ::cosf(fovy / 2), ::tanf(fovy / 2)), m_fov_x(aspect) {/*...*/}
+            constexpr PerspectiveProjection() : FrustumProjection(1.0f, 10000.0f, TRadians<float, 45.0f>, Sin(TRadians<float, 45.0f> / 2), Cos(TRadians<float, 45.0f> / 2), ::tanf(TRadians<float, 45.0f> / 2)), m_fov_x(4.0 / 3.0f) {/*...*/}
+            constexpr PerspectiveProjection(float near, float far, float fovy, float aspect) : FrustumProjection(near, far, fovy, Sin(fovy / 2), Cos(fovy / 2), ::tanf(fovy / 2)), m_fov_x(aspect) {/*...*/}
             constexpr virtual ~PerspectiveProjection() override {/*...*/}
 
             constexpr virtual void UpdateMatrix(Matrix44f *out_proj_matrix) const override {
@@ -141,7 +141,10 @@ namespace vp::util {
             }
 
             void SetFovX(float new_fov_x) {
-                m_fov_x = ::tanf(new_fov_x * 0.5f) / m_right;
+                float sin = 0.0f;
+                float cos = 0.0f;
+                SinCos(std::addressof(sin), std::addressof(cos), new_fov_x * 0.5f);
+                m_fov_x = (sin / cos) / m_right;
                 m_requires_update = true;
             }
     };
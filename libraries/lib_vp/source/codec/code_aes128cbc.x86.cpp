@@ -17,44 +17,137 @@
 
 namespace vp::codec {
 
-    void DecryptBlocksAes128CbcImpl(vp::util::v2sll *output, vp::util::v2sll *init_vector, const vp::util::v2sll *input, u32 block_count, Aes128Context *aes128_context) {
+    namespace {
+
+        constexpr u32 cInterleaveBlockCount = 8;
+        constexpr u32 cVaesBlockCount       = 16;
+
+        template <u32 BlockCount>
+        ALWAYS_INLINE void DecryptInterleavedBlocks(vp::util::v2sll *output, vp::util::v2sll *iv_iter, const vp::util::v2sll *input, const Aes128Context *aes128_context) {
+
+            /* Load every input block before storing so in place decryption keeps its chaining values */
+            vp::util::v2sll input_array[BlockCount];
+            vp::util::v2sll round_array[BlockCount];
+            for (u32 i = 0; i < BlockCount; ++i) {
+                input_array[i] = input[i];
+                round_array[i] = input_array[i] ^ aes128_context->round_key9;
+            }
+
+            /* Interleave each round across all blocks to hide aesdec latency */
+            for (u32 i = 0; i < BlockCount; ++i) { round_array[i] = Aesdec(round_array[i], aes128_context->round_key8); }
+            for (u32 i = 0; i < BlockCount; ++i) { round_array[i] = Aesdec(round_array[i], aes128_context->round_key7); }
+            for (u32 i = 0; i < BlockCount; ++i) { round_array[i] = Aesdec(round_array[i], aes128_context->round_key6); }
+            for (u32 i = 0; i < BlockCount; ++i) { round_array[i] = Aesdec(round_array[i], aes128_context->round_key5); }
+            for (u32 i = 0; i < BlockCount; ++i) { round_array[i] = Aesdec(round_array[i], aes128_context->round_key4); }
+            for (u32 i = 0; i < BlockCount; ++i) { round_array[i] = Aesdec(round_array[i], aes128_context->round_key3); }
+            for (u32 i = 0; i < BlockCount; ++i) { round_array[i] = Aesdec(round_array[i], aes128_context->round_key2); }
+            for (u32 i = 0; i < BlockCount; ++i) { round_array[i] = Aesdec(round_array[i], aes128_context->round_key1); }
+            for (u32 i = 0; i < BlockCount; ++i) { round_array[i] = Aesdec(round_array[i], aes128_context->round_key0); }
+
+            /* Chain with the previous cipher blocks */
+            output[0] = *iv_iter ^ Aesdeclast(round_array[0], aes128_context->key);
+            for (u32 i = 1; i < BlockCount; ++i) {
+                output[i] = input_array[i - 1] ^ Aesdeclast(round_array[i], aes128_context->key);
+            }
+            *iv_iter = input_array[BlockCount - 1];
+
+            return;
+        }
 
-        const vp::util::v2sll key        = aes128_context->key;
-        const vp::util::v2sll round_key0 = aes128_context->round_key0;
-        const vp::util::v2sll round_key1 = aes128_context->round_key1;
-        const vp::util::v2sll round_key2 = aes128_context->round_key2;
-        const vp::util::v2sll round_key3 = aes128_context->round_key3;
-        const vp::util::v2sll round_key4 = aes128_context->round_key4;
-        const vp::util::v2sll round_key5 = aes128_context->round_key5;
-        const vp::util::v2sll round_key6 = aes128_context->round_key6;
-        const vp::util::v2sll round_key7 = aes128_context->round_key7;
-        const vp::util::v2sll round_key8 = aes128_context->round_key8;
-        const vp::util::v2sll round_key9 = aes128_context->round_key9;
+        __attribute__((target("vaes,avx512f"))) u32 DecryptBlocksAes128CbcVaes512(vp::util::v2sll *output, vp::util::v2sll *iv_iter, const vp::util::v2sll *input, u32 block_count, const Aes128Context *aes128_context) {
+
+            /* Broadcast round keys to four lanes, the full mask forms avoid gcc's undefined pass through operand */
+            const __m512i key        = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->key));
+            const __m512i round_key0 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key0));
+            const __m512i round_key1 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key1));
+            const __m512i round_key2 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key2));
+            const __m512i round_key3 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key3));
+            const __m512i round_key4 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key4));
+            const __m512i round_key5 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key5));
+            const __m512i round_key6 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key6));
+            const __m512i round_key7 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key7));
+            const __m512i round_key8 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key8));
+            const __m512i round_key9 = _mm512_maskz_broadcast_i32x4(0xffff, reinterpret_cast<__m128i>(aes128_context->round_key9));
+
+            __m128i iv = reinterpret_cast<__m128i>(*iv_iter);
+
+            u32 i = 0;
+            for (; i + cVaesBlockCount <= block_count; i += cVaesBlockCount) {
+
+                /* Load four lanes of four blocks and their previous cipher blocks, the block before the first comes from the iv */
+                const vp::util::v2sll *input_i = input + i;
+                const __m512i input0 = _mm512_loadu_si512(input_i + 0);
+                const __m512i input1 = _mm512_loadu_si512(input_i + 4);
+                const __m512i input2 = _mm512_loadu_si512(input_i + 8);
+                const __m512i input3 = _mm512_loadu_si512(input_i + 12);
+                const __m512i prev0  = _mm512_inserti32x4(_mm512_maskz_loadu_epi64(0xfc, input_i - 1), iv, 0);
+                const __m512i prev1  = _mm512_loadu_si512(input_i + 3);
+                const __m512i prev2  = _mm512_loadu_si512(input_i + 7);
+                const __m512i prev3  = _mm512_loadu_si512(input_i + 11);
+
+                /* Perform ten rounds of aes decryption */
+                __m512i round0 = _mm512_xor_si512(input0, round_key9);
+                __m512i round1 = _mm512_xor_si512(input1, round_key9);
+                __m512i round2 = _mm512_xor_si512(input2, round_key9);
+                __m512i round3 = _mm512_xor_si512(input3, round_key9);
+                #define VP_AES_DEC_ROUND(round_key) \
+                    round0 = _mm512_aesdec_epi128(round0, round_key); \
+                    round1 = _mm512_aesdec_epi128(round1, round_key); \
+                    round2 = _mm512_aesdec_epi128(round2, round_key); \
+                    round3 = _mm512_aesdec_epi128(round3, round_key)
+                VP_AES_DEC_ROUND(round_key8);
+                VP_AES_DEC_ROUND(round_key7);
+                VP_AES_DEC_ROUND(round_key6);
+                VP_AES_DEC_ROUND(round_key5);
+                VP_AES_DEC_ROUND(round_key4);
+                VP_AES_DEC_ROUND(round_key3);
+                VP_AES_DEC_ROUND(round_key2);
+                VP_AES_DEC_ROUND(round_key1);
+                VP_AES_DEC_ROUND(round_key0);
+                #undef VP_AES_DEC_ROUND
+
+                /* Chain and store */
+                vp::util::v2sll *output_i = output + i;
+                _mm512_storeu_si512(output_i + 0,  _mm512_xor_si512(prev0, _mm512_aesdeclast_epi128(round0, key)));
+                _mm512_storeu_si512(output_i + 4,  _mm512_xor_si512(prev1, _mm512_aesdeclast_epi128(round1, key)));
+                _mm512_storeu_si512(output_i + 8,  _mm512_xor_si512(prev2, _mm512_aesdeclast_epi128(round2, key)));
+                _mm512_storeu_si512(output_i + 12, _mm512_xor_si512(prev3, _mm512_aesdeclast_epi128(round3, key)));
+
+                iv = _mm512_maskz_extracti32x4_epi32(0xf, input3, 3);
+            }
+            *iv_iter = reinterpret_cast<vp::util::v2sll>(iv);
+
+            return i;
+        }
 
-        vp::util::v2sll iv_iter = *init_vector;
+        bool IsVaes512Supported() {
+            static const bool s_is_supported = __builtin_cpu_supports("vaes") && __builtin_cpu_supports("avx512f");
+            return s_is_supported;
+        }
+    }
 
-        for (u32 i = 0; i < block_count; ++i) {
+    void DecryptBlocksAes128CbcImpl(vp::util::v2sll *output, vp::util::v2sll *init_vector, const vp::util::v2sll *input, u32 block_count, Aes128Context *aes128_context) {
 
-            /* Perform ten rounds of aes decryption on input */
-            const vp::util::v2sll input_i = *input;
-            vp::util::v2sll       round_iter;
+        vp::util::v2sll iv_iter = *init_vector;
+        u32             i       = 0;
 
-            round_iter = input_i ^ round_key9;
-            round_iter = Aesdec(round_iter, round_key8);
-            round_iter = Aesdec(round_iter, round_key7);
-            round_iter = Aesdec(round_iter, round_key6);
-            round_iter = Aesdec(round_iter, round_key5);
-            round_iter = Aesdec(round_iter, round_key4);
-            round_iter = Aesdec(round_iter, round_key3);
-            round_iter = Aesdec(round_iter, round_key2);
-            round_iter = Aesdec(round_iter, round_key1);
-            round_iter = Aesdec(round_iter, round_key0);
-            *output    = iv_iter ^ Aesdeclast(round_iter, key);
+        /* Decrypt sixteen blocks at a time with vaes when supported */
+        if (cVaesBlockCount <= block_count && IsVaes512Supported() == true) {
+            i = DecryptBlocksAes128CbcVaes512(output, std::addressof(iv_iter), input, block_count, aes128_context);
+        }
 
-            /* Advance iters */
-            output  = output + 1;
-            input   = input  + 1;
-            iv_iter = input_i;
+        /* Decrypt eight blocks at a time, cbc decryption has no dependency between blocks */
+        for (; i + cInterleaveBlockCount <= block_count; i += cInterleaveBlockCount) {
+            DecryptInterleavedBlocks<cInterleaveBlockCount>(output + i, std::addressof(iv_iter), input + i, aes128_context);
+        }
+        if (i + (cInterleaveBlockCount >> 1) <= block_count) {
+            DecryptInterleavedBlocks<(cInterleaveBlockCount >> 1)>(output + i, std::addressof(iv_iter), input + i, aes128_context);
+            i += (cInterleaveBlockCount >> 1);
+        }
+
+        /* Remaining blocks */
+        for (; i < block_count; ++i) {
+            DecryptInterleavedBlocks<1>(output + i, std::addressof(iv_iter), input + i, aes128_context);
         }
         *init_vector = iv_iter;
 
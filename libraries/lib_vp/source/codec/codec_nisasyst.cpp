@@ -52,4 +52,74 @@ namespace vp::codec {
 
         return;
 	}
+
+    void InitializeNisasystStreamContext(NisasystStreamContext *out_stream_context, size_t file_size, const char *file_path) {
+
+        /* Integrity checks */
+        VP_ASSERT(out_stream_context != nullptr && sizeof(cNisasystMagic) <= file_size);
+
+		/* Initialize random to generate path based key */
+		const u32 hash = vp::util::HashCrc32b(file_path);
+		vp::res::NintendoWareRandom random(hash);
+
+        /* Generate keys */
+		NisasystKey key;
+		NisasystKey init_vector;
+        GenerateNisasystKey(std::addressof(key), std::addressof(random));
+        GenerateNisasystKey(std::addressof(init_vector), std::addressof(random));
+
+        /* Setup stream, the cipher text ends before the magic */
+        out_stream_context->aes128_context.Initialize(key.key_array, sizeof(NisasystKey), true);
+        ::memcpy(std::addressof(out_stream_context->init_vector), init_vector.key_array, sizeof(vp::util::v2sll));
+        out_stream_context->cipher_size = (file_size - sizeof(cNisasystMagic)) & ~(sizeof(vp::util::v2sll) - 1);
+        out_stream_context->cipher_used = 0;
+
+        return;
+    }
+
+    size_t StreamDecryptNisasyst(void *stream, size_t stream_size, NisasystStreamContext *stream_context) {
+
+        /* Integrity checks */
+        VP_ASSERT(stream_context != nullptr);
+
+        /* Clamp to the cipher text left */
+        const size_t cipher_left = stream_context->cipher_size - stream_context->cipher_used;
+        const size_t plain_size  = ((cipher_left < stream_size) ? cipher_left : stream_size) & ~(sizeof(vp::util::v2sll) - 1);
+
+        /* Decrypt in place, carrying the chaining value to the next stream */
+        vp::util::v2sll *block_array = reinterpret_cast<vp::util::v2sll*>(stream);
+        DecryptBlocksAes128CbcImpl(block_array, std::addressof(stream_context->init_vector), block_array, static_cast<u32>(plain_size / sizeof(vp::util::v2sll)), std::addressof(stream_context->aes128_context));
+        stream_context->cipher_used += plain_size;
+
+        return plain_size;
+    }
+
+    size_t StreamDecryptDecompressNisasystZstd(void *stream, size_t stream_size, NisasystStreamContext *decrypt_context, ZstdStreamContext *stream_context, u32 *in_out_crc32b) {
+
+        /* Integrity checks */
+        VP_ASSERT(decrypt_context != nullptr && stream_context != nullptr);
+
+        /* Decrypt and decompress each stage while it is still in cache */
+        size_t expected = stream_context->expected_left;
+        for (size_t offset = 0; offset < stream_size && stream_context->state != ZstdStreamContext::State::Finished; offset += cNisasystStreamStageSize) {
+
+            /* Decrypt stage */
+            const size_t  size_left  = stream_size - offset;
+            void         *stage      = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(stream) + offset);
+            const size_t  plain_size = StreamDecryptNisasyst(stage, (cNisasystStreamStageSize < size_left) ? cNisasystStreamStageSize : size_left, decrypt_context);
+            if (plain_size == 0) { break; }
+
+            /* Decompress stage */
+            const size_t output_offset = stream_context->output_used;
+            expected = StreamDecompressZstd(stage, plain_size, stream_context);
+            if (expected == ZstdStreamContext::cInvalidStreamState) { return ZstdStreamContext::cInvalidStreamState; }
+
+            /* Accumulate crc32b over the output just produced */
+            if (in_out_crc32b != nullptr && output_offset < stream_context->output_used) {
+                *in_out_crc32b = vp::util::HashDataCrc32bWithContext(~*in_out_crc32b, reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(stream_context->output) + output_offset), stream_context->output_used - output_offset);
+            }
+        }
+
+        return expected;
+    }
 }
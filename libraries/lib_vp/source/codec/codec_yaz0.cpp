@@ -0,0 +1,224 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <vp.hpp>
+
+namespace vp::codec {
+
+    namespace {
+
+        ALWAYS_INLINE void CopyYaz0Match(u8 *output_iter, size_t distance, size_t match_size, const u8 *output_end) {
+
+            /* Wide copies when the source never overlaps the copy unit and the output has room for the overrun */
+            const u8     *match_iter = output_iter - distance;
+            const size_t  room       = static_cast<size_t>(output_end - output_iter);
+            if (sizeof(u64) * 2 <= distance && match_size + sizeof(u64) * 2 <= room) {
+                for (size_t i = 0; i < match_size; i += sizeof(u64) * 2) {
+                    ::memcpy(output_iter + i, match_iter + i, sizeof(u64) * 2);
+                }
+                return;
+            }
+            if (sizeof(u64) <= distance && match_size + sizeof(u64) <= room) {
+                for (size_t i = 0; i < match_size; i += sizeof(u64)) {
+                    ::memcpy(output_iter + i, match_iter + i, sizeof(u64));
+                }
+                return;
+            }
+
+            /* Overlapping runs copy bytewise */
+            for (size_t i = 0; i < match_size; ++i) {
+                output_iter[i] = match_iter[i];
+            }
+
+            return;
+        }
+    }
+
+    Result GetDecompressedSizeYaz0(size_t *out_size, const void *yaz0_stream, size_t yaz0_stream_size) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(yaz0_stream != nullptr && cYaz0HeaderSize <= yaz0_stream_size, ResultInvalidYaz0Stream);
+
+        /* Check header */
+        const vp::res::ResSzs *szs = reinterpret_cast<const vp::res::ResSzs*>(yaz0_stream);
+        RESULT_RETURN_UNLESS(szs->IsValid() == true, ResultInvalidYaz0Stream);
+
+        if (out_size != nullptr) {
+            *out_size = szs->GetDecompressedSize();
+        }
+
+        RESULT_RETURN_SUCCESS;
+    }
+
+    Result DecompressYaz0(size_t *out_size, void *output, size_t output_size, const void *yaz0_stream, size_t yaz0_stream_size) {
+
+        /* Get decompressed size */
+        size_t       decomp_size = 0;
+        const Result size_result = GetDecompressedSizeYaz0(std::addressof(decomp_size), yaz0_stream, yaz0_stream_size);
+        RESULT_RETURN_UNLESS(size_result == ResultSuccess, size_result);
+        RESULT_RETURN_UNLESS(decomp_size <= output_size,   ResultOutputBufferTooSmall);
+
+        /* Decode groups */
+        const u8 *stream_iter = reinterpret_cast<const u8*>(yaz0_stream) + cYaz0HeaderSize;
+        const u8 *stream_end  = reinterpret_cast<const u8*>(yaz0_stream) + yaz0_stream_size;
+        u8       *output_base = reinterpret_cast<u8*>(output);
+        u8       *output_iter = output_base;
+        u8       *output_end  = output_base + decomp_size;
+        while (output_iter < output_end) {
+
+            /* Read group header */
+            RESULT_RETURN_UNLESS(stream_iter < stream_end, ResultInvalidYaz0Stream);
+            u32 group_header = *stream_iter;
+            ++stream_iter;
+
+            /* Copy a group of eight literals at once */
+            if (group_header == 0xff && sizeof(u64) <= static_cast<size_t>(stream_end - stream_iter) && sizeof(u64) <= static_cast<size_t>(output_end - output_iter)) {
+                ::memcpy(output_iter, stream_iter, sizeof(u64));
+                stream_iter += sizeof(u64);
+                output_iter += sizeof(u64);
+                continue;
+            }
+
+            for (u32 i = 0; i < 8 && output_iter < output_end; ++i, group_header = group_header << 1) {
+
+                /* Literal */
+                if ((group_header & 0x80) != 0) {
+                    RESULT_RETURN_UNLESS(stream_iter < stream_end, ResultInvalidYaz0Stream);
+                    *output_iter = *stream_iter;
+                    ++output_iter;
+                    ++stream_iter;
+                    continue;
+                }
+
+                /* Match */
+                RESULT_RETURN_UNLESS(2 <= stream_end - stream_iter, ResultInvalidYaz0Stream);
+                const u32 op0        = stream_iter[0];
+                const u32 op1        = stream_iter[1];
+                const size_t distance   = (((op0 & 0xf) << 8) | op1) + 1;
+                size_t       match_size = op0 >> 4;
+                stream_iter += 2;
+                if (match_size == 0) {
+                    RESULT_RETURN_UNLESS(stream_iter < stream_end, ResultInvalidYaz0Stream);
+                    match_size = *stream_iter + 0x12;
+                    ++stream_iter;
+                } else {
+                    match_size = match_size + 2;
+                }
+                RESULT_RETURN_UNLESS(distance <= static_cast<size_t>(output_iter - output_base),   ResultInvalidYaz0Stream);
+                RESULT_RETURN_UNLESS(match_size <= static_cast<size_t>(output_end - output_iter), ResultInvalidYaz0Stream);
+
+                CopyYaz0Match(output_iter, distance, match_size, output_end);
+                output_iter += match_size;
+            }
+        }
+
+        if (out_size != nullptr) {
+            *out_size = decomp_size;
+        }
+
+        RESULT_RETURN_SUCCESS;
+    }
+
+    size_t StreamDecompressYaz0(const void *stream, size_t stream_size, Yaz0StreamContext *stream_context) {
+
+        /* Integrity checks */
+        VP_ASSERT(stream_context != nullptr);
+
+        const u8 *stream_iter = reinterpret_cast<const u8*>(stream);
+        const u8 *stream_end  = stream_iter + stream_size;
+
+        /* Parse header, which may straddle streams */
+        if (stream_context->state == Yaz0StreamContext::State::Begin) {
+
+            /* Gather header */
+            const size_t header_left = cYaz0HeaderSize - stream_context->pending_size;
+            const size_t copy_size   = (header_left < stream_size) ? header_left : stream_size;
+            ::memcpy(stream_context->pending_array + stream_context->pending_size, stream_iter, copy_size);
+            stream_context->pending_size += copy_size;
+            stream_iter                  += copy_size;
+            if (stream_context->pending_size < cYaz0HeaderSize) { return stream_context->output_size; }
+
+            /* Get decompressed output size */
+            size_t decomp_size = 0;
+            if (GetDecompressedSizeYaz0(std::addressof(decomp_size), stream_context->pending_array, cYaz0HeaderSize) != ResultSuccess || stream_context->output_size < decomp_size) { stream_context->state = Yaz0StreamContext::State::Error; return Yaz0StreamContext::cInvalidStreamState; }
+
+            stream_context->expected_left   = decomp_size;
+            stream_context->output_used     = 0;
+            stream_context->group_header    = 0;
+            stream_context->group_bits_left = 0;
+            stream_context->pending_size    = 0;
+            stream_context->state           = Yaz0StreamContext::State::Streaming;
+        }
+        if (stream_context->state != Yaz0StreamContext::State::Streaming) { return (stream_context->state == Yaz0StreamContext::State::Error) ? Yaz0StreamContext::cInvalidStreamState : 0; }
+
+        /* Update stream state on scope exit */
+        u8  *output_base     = reinterpret_cast<u8*>(stream_context->output);
+        u8  *output_iter     = output_base + stream_context->output_used;
+        u8  *output_end      = output_iter + stream_context->expected_left;
+        u32  group_header    = stream_context->group_header;
+        u32  group_bits_left = stream_context->group_bits_left;
+        ON_SCOPE_EXIT {
+            stream_context->group_header    = group_header;
+            stream_context->group_bits_left = group_bits_left;
+            stream_context->expected_left   = static_cast<size_t>(output_end - output_iter);
+            stream_context->output_used     = static_cast<size_t>(output_iter - output_base);
+            if (stream_context->expected_left == 0 && stream_context->state == Yaz0StreamContext::State::Streaming) { stream_context->state = Yaz0StreamContext::State::Finished; }
+        };
+
+        /* Streaming decode loop */
+        while (output_iter < output_end) {
+
+            /* Read group header */
+            if (group_bits_left == 0) {
+                if (stream_iter == stream_end) { break; }
+                group_header    = *stream_iter;
+                group_bits_left = 8;
+                ++stream_iter;
+            }
+
+            /* Literal */
+            if ((group_header & 0x80) != 0) {
+                if (stream_iter == stream_end) { break; }
+                *output_iter = *stream_iter;
+                ++output_iter;
+                ++stream_iter;
+                group_header = group_header << 1;
+                --group_bits_left;
+                continue;
+            }
+
+            /* Gather match operation, carrying partial operations to the next stream */
+            u8  *op        = stream_context->pending_array;
+            u32  op_size   = stream_context->pending_size;
+            while (op_size < 2 && stream_iter < stream_end) { op[op_size] = *stream_iter; ++op_size; ++stream_iter; }
+            if (op_size == 2 && (op[0] >> 4) == 0 && stream_iter < stream_end) { op[op_size] = *stream_iter; ++op_size; ++stream_iter; }
+            const u32 required_size = (op_size < 1 || (op[0] >> 4) != 0) ? 2 : 3;
+            if (op_size < required_size) { stream_context->pending_size = op_size; break; }
+            stream_context->pending_size = 0;
+
+            /* Decode match */
+            const size_t distance   = (((static_cast<u32>(op[0]) & 0xf) << 8) | op[1]) + 1;
+            const size_t match_size = (required_size == 3) ? static_cast<size_t>(op[2]) + 0x12 : static_cast<size_t>(op[0] >> 4) + 2;
+            if (static_cast<size_t>(output_iter - output_base) < distance || static_cast<size_t>(output_end - output_iter) < match_size) { stream_context->state = Yaz0StreamContext::State::Error; return Yaz0StreamContext::cInvalidStreamState; }
+
+            CopyYaz0Match(output_iter, distance, match_size, output_end);
+            output_iter     += match_size;
+            group_header     = group_header << 1;
+            --group_bits_left;
+        }
+
+        return static_cast<size_t>(output_end - output_iter);
+    }
+}
@@ -17,6 +17,15 @@
 
 namespace vp::codec {
 
+    namespace {
+
+        ALWAYS_INLINE u32 LoadU32(const u8 *address) {
+            u32 value = 0;
+            ::memcpy(std::addressof(value), address, sizeof(u32));
+            return value;
+        }
+    }
+
     Result GetZstdDDictIdFromStream(u32 *out_id, const void *zstd_stream, size_t stream_size) {
         u32 id = ::ZSTD_getDictID_fromFrame(zstd_stream, stream_size);
         RESULT_RETURN_IF(id == 0, ResultInvalidZstdDictionary);
@@ -79,9 +88,10 @@ namespace vp::codec {
         /* Parse header */
         if (stream_context->state == ZstdStreamContext::State::Begin) {
 
-            /* Get decompressed output size */
-            const size_t expected_size = ::ZSTD_getFrameContentSize(stream, stream_size);
-            if (::ZSTD_isError(expected_size) != 0 || stream_context->output_size < expected_size) { stream_context->state = ZstdStreamContext::State::Error; return ZstdStreamContext::cInvalidStreamState; }
+            /* Get decompressed output size, bounding frames without a content size by the output */
+            const size_t content_size  = ::ZSTD_getFrameContentSize(stream, stream_size);
+            const size_t expected_size = (content_size == ZSTD_CONTENTSIZE_UNKNOWN) ? stream_context->output_size : content_size;
+            if (content_size == ZSTD_CONTENTSIZE_ERROR || stream_context->output_size < expected_size) { stream_context->state = ZstdStreamContext::State::Error; return ZstdStreamContext::cInvalidStreamState; }
             stream_context->expected_left = expected_size;
 
             /* Start decompression with ddict if available */
@@ -178,4 +188,76 @@ namespace vp::codec {
 
         return expected_size_left;
     }
+
+    Result GetZstdSeekTableSize(size_t *out_seek_table_size, u32 *out_frame_count, const void *seek_table_footer, size_t footer_size) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(seek_table_footer != nullptr && footer_size == cZstdSeekTableFooterSize, ResultInvalidZstdSeekTable);
+
+        /* Check footer */
+        const u8  *footer         = reinterpret_cast<const u8*>(seek_table_footer);
+        const u32  frame_count    = LoadU32(footer);
+        const u8   descriptor     = footer[4];
+        const u32  seekable_magic = LoadU32(footer + 5);
+        RESULT_RETURN_UNLESS(seekable_magic == cZstdSeekableMagic,           ResultInvalidZstdSeekTable);
+        RESULT_RETURN_UNLESS((descriptor & cZstdSeekTableReservedMask) == 0, ResultInvalidZstdSeekTable);
+
+        /* Calculate size of the whole seek table skippable frame */
+        const size_t entry_size = ((descriptor & cZstdSeekTableChecksumFlag) != 0) ? 12 : 8;
+        if (out_seek_table_size != nullptr) {
+            *out_seek_table_size = cZstdSkippableHeaderSize + entry_size * frame_count + cZstdSeekTableFooterSize;
+        }
+        if (out_frame_count != nullptr) {
+            *out_frame_count = frame_count;
+        }
+
+        RESULT_RETURN_SUCCESS;
+    }
+
+    Result ParseZstdSeekTable(ZstdFrameEntry *out_frame_array, u32 frame_count, size_t *out_decompressed_size, const void *seek_table, size_t seek_table_size) {
+
+        /* Integrity checks */
+        RESULT_RETURN_UNLESS(seek_table != nullptr && (cZstdSkippableHeaderSize + cZstdSeekTableFooterSize) <= seek_table_size, ResultInvalidZstdSeekTable);
+
+        /* Check skippable frame header */
+        const u8  *table           = reinterpret_cast<const u8*>(seek_table);
+        const u32  skippable_magic = LoadU32(table);
+        const u32  frame_size      = LoadU32(table + 4);
+        RESULT_RETURN_UNLESS(skippable_magic == cZstdSeekTableSkippableMagic,         ResultInvalidZstdSeekTable);
+        RESULT_RETURN_UNLESS(frame_size + cZstdSkippableHeaderSize == seek_table_size, ResultInvalidZstdSeekTable);
+
+        /* Check footer matches */
+        u32          footer_frame_count = 0;
+        size_t       table_size         = 0;
+        const Result footer_result      = GetZstdSeekTableSize(std::addressof(table_size), std::addressof(footer_frame_count), table + seek_table_size - cZstdSeekTableFooterSize, cZstdSeekTableFooterSize);
+        RESULT_RETURN_UNLESS(footer_result == ResultSuccess,                                     footer_result);
+        RESULT_RETURN_UNLESS(table_size == seek_table_size && footer_frame_count == frame_count, ResultInvalidZstdSeekTable);
+
+        /* Convert entries to absolute offsets */
+        const u8     descriptor          = table[seek_table_size - cZstdSeekTableFooterSize + 4];
+        const size_t entry_size          = ((descriptor & cZstdSeekTableChecksumFlag) != 0) ? 12 : 8;
+        const u8    *entry_iter          = table + cZstdSkippableHeaderSize;
+        size_t       compressed_offset   = 0;
+        size_t       decompressed_offset = 0;
+        for (u32 i = 0; i < frame_count; ++i) {
+            const u32 compressed_size   = LoadU32(entry_iter);
+            const u32 decompressed_size = LoadU32(entry_iter + 4);
+            RESULT_RETURN_IF(compressed_size == 0, ResultInvalidZstdSeekTable);
+
+            out_frame_array[i].compressed_offset   = compressed_offset;
+            out_frame_array[i].compressed_size     = compressed_size;
+            out_frame_array[i].decompressed_offset = decompressed_offset;
+            out_frame_array[i].decompressed_size   = decompressed_size;
+
+            compressed_offset   += compressed_size;
+            decompressed_offset += decompressed_size;
+            entry_iter          += entry_size;
+        }
+
+        if (out_decompressed_size != nullptr) {
+            *out_decompressed_size = decompressed_offset;
+        }
+
+        RESULT_RETURN_SUCCESS;
+    }
 }
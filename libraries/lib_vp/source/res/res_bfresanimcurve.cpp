@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <vp.hpp>
+
+namespace vp::res {
+
+    void SampleBfresAnimCurveFloatArray(float *out_value_array, const ResBfresAnimCurve *curve_array, u16 *key_cursor_array, u32 curve_count, float frame) {
+
+        constexpr u32 cLaneCount = sizeof(vp::util::v8f) / sizeof(float);
+
+        /* Gathered segment lanes */
+        vp::util::v8f t_lane                     = {};
+        vp::util::v8f c0_lane                    = {};
+        vp::util::v8f c1_lane                    = {};
+        vp::util::v8f c2_lane                    = {};
+        vp::util::v8f c3_lane                    = {};
+        vp::util::v8f scale_lane                 = {};
+        vp::util::v8f add_lane                   = {};
+        u32           out_index_lane[cLaneCount] = {};
+        u32           lane_count                 = 0;
+
+        /* Evaluate gathered segments with Horner's method */
+        auto evaluate_lanes = [&]() {
+            const vp::util::v8f value = (((c3_lane * t_lane + c2_lane) * t_lane + c1_lane) * t_lane + c0_lane) * scale_lane + add_lane;
+            for (u32 i = 0; i < lane_count; ++i) {
+                out_value_array[out_index_lane[i]] = value[i];
+            }
+            lane_count = 0;
+        };
+
+        for (u32 i = 0; i < curve_count; ++i) {
+
+            const ResBfresAnimCurve *curve = std::addressof(curve_array[i]);
+
+            /* Baked and stepped curves don't interpolate */
+            const BfresAnimCurveCurveType type = static_cast<BfresAnimCurveCurveType>(curve->curve_type);
+            if (type != BfresAnimCurveCurveType::CubicFloat && type != BfresAnimCurveCurveType::LinearFloat) {
+                out_value_array[i] = curve->EvaluateFloat(frame, std::addressof(key_cursor_array[i]));
+                continue;
+            }
+
+            /* Locate segment */
+            s32         cycle   = 0;
+            const float wrapped = curve->WrapFrame(std::addressof(cycle), frame);
+            const u32   segment = curve->FindKeyIndex(wrapped, std::addressof(key_cursor_array[i]));
+            const u32   base    = segment * curve->GetCoefficientCount();
+
+            /* Gather segment */
+            t_lane[lane_count]         = curve->CalculateSegmentRatio(segment, wrapped);
+            c0_lane[lane_count]        = curve->GetCoefficient(base);
+            c1_lane[lane_count]        = curve->GetCoefficient(base + 1);
+            c2_lane[lane_count]        = (type == BfresAnimCurveCurveType::CubicFloat) ? curve->GetCoefficient(base + 2) : 0.0f;
+            c3_lane[lane_count]        = (type == BfresAnimCurveCurveType::CubicFloat) ? curve->GetCoefficient(base + 3) : 0.0f;
+            scale_lane[lane_count]     = curve->GetValueScale();
+            add_lane[lane_count]       = curve->GetValueAdd(cycle);
+            out_index_lane[lane_count] = i;
+            ++lane_count;
+
+            if (lane_count == cLaneCount) { evaluate_lanes(); }
+        }
+
+        /* Evaluate the remainder */
+        if (lane_count != 0) { evaluate_lanes(); }
+
+        return;
+    }
+}
@@ -0,0 +1,378 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <vp.hpp>
+
+namespace vp::res {
+
+    namespace {
+
+        constexpr u32 cRotateChannel    = static_cast<u32>(BfresSkeletalPoseChannel::RotateX);
+        constexpr u32 cScaleChannel     = static_cast<u32>(BfresSkeletalPoseChannel::ScaleX);
+        constexpr u32 cInvalidBoneIndex = 0xffff;
+        constexpr u32 cInvalidChannel   = 0xffff'ffff;
+
+        /* Bone anim curves target the unpacked bone result {flag, scale xyz, translate xyz, padding, rotate xyzw} by byte offset */
+        struct BoneAnimCurveTarget {
+            BfresBoneAnimCurveType   curve_type;
+            u32                      result_offset;
+            BfresSkeletalPoseChannel channel;
+        };
+        constexpr BoneAnimCurveTarget cBoneAnimCurveTargetArray[] = {
+            { BfresBoneAnimCurveType::ScaleX,     0x04, BfresSkeletalPoseChannel::ScaleX },
+            { BfresBoneAnimCurveType::ScaleY,     0x08, BfresSkeletalPoseChannel::ScaleY },
+            { BfresBoneAnimCurveType::ScaleZ,     0x0c, BfresSkeletalPoseChannel::ScaleZ },
+            { BfresBoneAnimCurveType::RotateX,    0x20, BfresSkeletalPoseChannel::RotateX },
+            { BfresBoneAnimCurveType::RotateY,    0x24, BfresSkeletalPoseChannel::RotateY },
+            { BfresBoneAnimCurveType::RotateZ,    0x28, BfresSkeletalPoseChannel::RotateZ },
+            { BfresBoneAnimCurveType::RotateW,    0x2c, BfresSkeletalPoseChannel::RotateW },
+            { BfresBoneAnimCurveType::TranslateX, 0x10, BfresSkeletalPoseChannel::TranslateX },
+            { BfresBoneAnimCurveType::TranslateY, 0x14, BfresSkeletalPoseChannel::TranslateY },
+            { BfresBoneAnimCurveType::TranslateZ, 0x18, BfresSkeletalPoseChannel::TranslateZ },
+        };
+        constexpr u32 cBoneAnimResultSize = 0x30;
+
+        consteval std::array<BoneAnimCurveTarget, cBoneAnimResultSize / sizeof(float)> GenerateBoneAnimCurveTargetTable() {
+            std::array<BoneAnimCurveTarget, cBoneAnimResultSize / sizeof(float)> table = {};
+            for (u32 i = 0; i < table.size(); ++i) {
+                table[i] = { BfresBoneAnimCurveType{}, i * static_cast<u32>(sizeof(float)), static_cast<BfresSkeletalPoseChannel>(cInvalidChannel) };
+            }
+            for (const BoneAnimCurveTarget &target : cBoneAnimCurveTargetArray) {
+                table[target.result_offset / sizeof(float)] = target;
+            }
+            return table;
+        }
+        constexpr std::array<BoneAnimCurveTarget, cBoneAnimResultSize / sizeof(float)> cBoneAnimCurveTargetTable = GenerateBoneAnimCurveTargetTable();
+
+        ALWAYS_INLINE vp::util::v8f LoadLane(const float *channel, u32 bone_index) {
+            vp::util::v8f lane;
+            ::memcpy(std::addressof(lane), channel + bone_index, sizeof(vp::util::v8f));
+            return lane;
+        }
+
+        ALWAYS_INLINE void StoreLane(float *channel, u32 bone_index, vp::util::v8f lane) {
+            ::memcpy(channel + bone_index, std::addressof(lane), sizeof(vp::util::v8f));
+        }
+
+        ALWAYS_INLINE vp::util::v8f ReciprocalSqrtLane(vp::util::v8f lane) {
+            #ifdef VP_TARGET_ARCHITECTURE_x86
+                return 1.0f / __builtin_ia32_sqrtps256(lane);
+            #else
+                vp::util::v8f result;
+                for (u32 i = 0; i < BfresSkeletalPose::cLaneCount; ++i) {
+                    result[i] = 1.0f / ::sqrtf(lane[i]);
+                }
+                return result;
+            #endif
+        }
+
+        /* Converts euler xyz rotation channels of a bone to a quaternion in place, rotation is applied x then y then z */
+        void ConvertEulerXYZToQuaternion(BfresSkeletalPose *pose, u32 bone_index) {
+
+            float *rotate_x = pose->GetChannel(BfresSkeletalPoseChannel::RotateX);
+            float *rotate_y = pose->GetChannel(BfresSkeletalPoseChannel::RotateY);
+            float *rotate_z = pose->GetChannel(BfresSkeletalPoseChannel::RotateZ);
+            float *rotate_w = pose->GetChannel(BfresSkeletalPoseChannel::RotateW);
+
+            /* Evaluate the three half angles in one vector */
+            const vp::util::v4f half_angle = vp::util::v4f{ rotate_x[bone_index], rotate_y[bone_index], rotate_z[bone_index], 0.0f } * 0.5f;
+            vp::util::v4f sin = {};
+            vp::util::v4f cos = {};
+            vp::util::SinCos(std::addressof(sin), std::addressof(cos), half_angle);
+            const float sin_x  = sin[0];
+            const float cos_x  = cos[0];
+            const float sin_y  = sin[1];
+            const float cos_y  = cos[1];
+            const float sin_z  = sin[2];
+            const float cos_z  = cos[2];
+
+            rotate_x[bone_index] = sin_x * cos_y * cos_z - cos_x * sin_y * sin_z;
+            rotate_y[bone_index] = cos_x * sin_y * cos_z + sin_x * cos_y * sin_z;
+            rotate_z[bone_index] = cos_x * cos_y * sin_z - sin_x * sin_y * cos_z;
+            rotate_w[bone_index] = cos_x * cos_y * cos_z + sin_x * sin_y * sin_z;
+        }
+    }
+
+    void BfresSkeletalPose::SetBindPose(const ResBfresSkeleton *skeleton) {
+
+        /* Padding bones are identity */
+        for (u32 i = 0; i < m_channel_stride; ++i) {
+            for (u32 channel = 0; channel < cChannelCount; ++channel) {
+                m_channel_array[channel][i] = (channel == static_cast<u32>(BfresSkeletalPoseChannel::RotateW) || cScaleChannel <= channel) ? 1.0f : 0.0f;
+            }
+        }
+
+        /* Copy bone transforms */
+        const u32  bone_count = (skeleton->bone_count < m_bone_count) ? skeleton->bone_count : m_bone_count;
+        const bool is_euler   = static_cast<BfresSkeletonRotationMode>(skeleton->rotation_mode) == BfresSkeletonRotationMode::EulerXYZ;
+        for (u32 i = 0; i < bone_count; ++i) {
+
+            const ResBfresBone *bone = std::addressof(skeleton->bone_array[i]);
+            this->GetChannel(BfresSkeletalPoseChannel::TranslateX)[i] = bone->translate.x;
+            this->GetChannel(BfresSkeletalPoseChannel::TranslateY)[i] = bone->translate.y;
+            this->GetChannel(BfresSkeletalPoseChannel::TranslateZ)[i] = bone->translate.z;
+            this->GetChannel(BfresSkeletalPoseChannel::RotateX)[i]    = bone->rotate.x;
+            this->GetChannel(BfresSkeletalPoseChannel::RotateY)[i]    = bone->rotate.y;
+            this->GetChannel(BfresSkeletalPoseChannel::RotateZ)[i]    = bone->rotate.z;
+            this->GetChannel(BfresSkeletalPoseChannel::RotateW)[i]    = bone->rotate.w;
+            this->GetChannel(BfresSkeletalPoseChannel::ScaleX)[i]     = bone->scale.x;
+            this->GetChannel(BfresSkeletalPoseChannel::ScaleY)[i]     = bone->scale.y;
+            this->GetChannel(BfresSkeletalPoseChannel::ScaleZ)[i]     = bone->scale.z;
+
+            if (is_euler == true) { ConvertEulerXYZToQuaternion(this, i); }
+        }
+
+        return;
+    }
+
+    void BfresSkeletalPose::CalculateLocalMatrices(vp::util::Matrix34f *out_local_matrix_array) const {
+
+        for (u32 base = 0; base < m_bone_count; base += cLaneCount) {
+
+            /* Load 8 bones */
+            const vp::util::v8f tx = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::TranslateX), base);
+            const vp::util::v8f ty = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::TranslateY), base);
+            const vp::util::v8f tz = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::TranslateZ), base);
+            const vp::util::v8f qx = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::RotateX), base);
+            const vp::util::v8f qy = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::RotateY), base);
+            const vp::util::v8f qz = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::RotateZ), base);
+            const vp::util::v8f qw = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::RotateW), base);
+            const vp::util::v8f sx = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::ScaleX), base);
+            const vp::util::v8f sy = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::ScaleY), base);
+            const vp::util::v8f sz = LoadLane(this->GetChannel(BfresSkeletalPoseChannel::ScaleZ), base);
+
+            /* Quaternion to rotation, scaled per column */
+            const vp::util::v8f x2 = qx + qx;
+            const vp::util::v8f y2 = qy + qy;
+            const vp::util::v8f z2 = qz + qz;
+            const vp::util::v8f xx = qx * x2;
+            const vp::util::v8f yy = qy * y2;
+            const vp::util::v8f zz = qz * z2;
+            const vp::util::v8f xy = qx * y2;
+            const vp::util::v8f xz = qx * z2;
+            const vp::util::v8f yz = qy * z2;
+            const vp::util::v8f wx = qw * x2;
+            const vp::util::v8f wy = qw * y2;
+            const vp::util::v8f wz = qw * z2;
+
+            const vp::util::v8f m11 = (1.0f - (yy + zz)) * sx;
+            const vp::util::v8f m12 = (xy - wz) * sy;
+            const vp::util::v8f m13 = (xz + wy) * sz;
+            const vp::util::v8f m21 = (xy + wz) * sx;
+            const vp::util::v8f m22 = (1.0f - (xx + zz)) * sy;
+            const vp::util::v8f m23 = (yz - wx) * sz;
+            const vp::util::v8f m31 = (xz - wy) * sx;
+            const vp::util::v8f m32 = (yz + wx) * sy;
+            const vp::util::v8f m33 = (1.0f - (xx + yy)) * sz;
+
+            /* Scatter to matrices */
+            const u32 lane_count = (m_bone_count - base < cLaneCount) ? m_bone_count - base : cLaneCount;
+            for (u32 i = 0; i < lane_count; ++i) {
+                float *matrix = out_local_matrix_array[base + i].m_arr;
+                matrix[0]  = m11[i]; matrix[1]  = m12[i]; matrix[2]  = m13[i]; matrix[3]  = tx[i];
+                matrix[4]  = m21[i]; matrix[5]  = m22[i]; matrix[6]  = m23[i]; matrix[7]  = ty[i];
+                matrix[8]  = m31[i]; matrix[9]  = m32[i]; matrix[10] = m33[i]; matrix[11] = tz[i];
+            }
+        }
+
+        return;
+    }
+
+    void BfresSkeletalPose::CalculateWorldMatrices(vp::util::Matrix34f *out_world_matrix_array, const vp::util::Matrix34f *local_matrix_array, const ResBfresSkeleton *skeleton, const vp::util::Matrix34f &root_matrix) {
+
+        /* Bones are stored parents first, so a single forward pass resolves the hierarchy */
+        const u32 bone_count = skeleton->bone_count;
+        for (u32 i = 0; i < bone_count; ++i) {
+
+            const u32 parent_index = skeleton->bone_array[i].bone_parent_index;
+            if (parent_index == cInvalidBoneIndex) {
+                vp::util::MultiplyMatrix34(std::addressof(out_world_matrix_array[i]), root_matrix, local_matrix_array[i]);
+                continue;
+            }
+
+            VP_ASSERT(parent_index < i);
+            vp::util::MultiplyMatrix34(std::addressof(out_world_matrix_array[i]), out_world_matrix_array[parent_index], local_matrix_array[i]);
+        }
+
+        return;
+    }
+
+    void BlendBfresSkeletalPoses(BfresSkeletalPose *out_pose, const BfresSkeletalPose *const *layer_pose_array, const float *weight_array, u32 layer_count) {
+
+        /* Integrity checks */
+        if (layer_count == 0) { return; }
+
+        /* Normalize weights */
+        float total_weight = 0.0f;
+        for (u32 i = 0; i < layer_count; ++i) {
+            total_weight += weight_array[i];
+        }
+        if (total_weight <= 0.0f) {
+            out_pose->Copy(layer_pose_array[0]);
+            return;
+        }
+        const float inverse_total_weight = 1.0f / total_weight;
+
+        const u32 stride = out_pose->GetChannelStride();
+        for (u32 base = 0; base < stride; base += BfresSkeletalPose::cLaneCount) {
+
+            /* The first layer's rotation picks the hemisphere */
+            const vp::util::v8f q0x = LoadLane(layer_pose_array[0]->GetChannel(BfresSkeletalPoseChannel::RotateX), base);
+            const vp::util::v8f q0y = LoadLane(layer_pose_array[0]->GetChannel(BfresSkeletalPoseChannel::RotateY), base);
+            const vp::util::v8f q0z = LoadLane(layer_pose_array[0]->GetChannel(BfresSkeletalPoseChannel::RotateZ), base);
+            const vp::util::v8f q0w = LoadLane(layer_pose_array[0]->GetChannel(BfresSkeletalPoseChannel::RotateW), base);
+
+            /* Accumulate weighted channels */
+            vp::util::v8f accumulate_array[BfresSkeletalPose::cChannelCount] = {};
+            for (u32 layer = 0; layer < layer_count; ++layer) {
+
+                const BfresSkeletalPose *pose   = layer_pose_array[layer];
+                const float              weight = weight_array[layer] * inverse_total_weight;
+
+                for (u32 channel = 0; channel < cRotateChannel; ++channel) {
+                    accumulate_array[channel] += LoadLane(pose->GetChannel(channel), base) * weight;
+                }
+                for (u32 channel = cScaleChannel; channel < BfresSkeletalPose::cChannelCount; ++channel) {
+                    accumulate_array[channel] += LoadLane(pose->GetChannel(channel), base) * weight;
+                }
+
+                const vp::util::v8f qx   = LoadLane(pose->GetChannel(BfresSkeletalPoseChannel::RotateX), base);
+                const vp::util::v8f qy   = LoadLane(pose->GetChannel(BfresSkeletalPoseChannel::RotateY), base);
+                const vp::util::v8f qz   = LoadLane(pose->GetChannel(BfresSkeletalPoseChannel::RotateZ), base);
+                const vp::util::v8f qw   = LoadLane(pose->GetChannel(BfresSkeletalPoseChannel::RotateW), base);
+                const vp::util::v8f dot  = qx * q0x + qy * q0y + qz * q0z + qw * q0w;
+                const vp::util::v8f sign = (dot < 0.0f) ? vp::util::v8f{} - weight : vp::util::v8f{} + weight;
+                accumulate_array[cRotateChannel + 0] += qx * sign;
+                accumulate_array[cRotateChannel + 1] += qy * sign;
+                accumulate_array[cRotateChannel + 2] += qz * sign;
+                accumulate_array[cRotateChannel + 3] += qw * sign;
+            }
+
+            /* Renormalize rotation */
+            const vp::util::v8f length_sq = accumulate_array[cRotateChannel + 0] * accumulate_array[cRotateChannel + 0] + accumulate_array[cRotateChannel + 1] * accumulate_array[cRotateChannel + 1] + accumulate_array[cRotateChannel + 2] * accumulate_array[cRotateChannel + 2] + accumulate_array[cRotateChannel + 3] * accumulate_array[cRotateChannel + 3];
+            const vp::util::v8f inverse_length = ReciprocalSqrtLane(length_sq);
+            for (u32 channel = cRotateChannel; channel < cScaleChannel; ++channel) {
+                accumulate_array[channel] *= inverse_length;
+            }
+
+            /* Store after every layer is read so out_pose may alias a layer */
+            for (u32 channel = 0; channel < BfresSkeletalPose::cChannelCount; ++channel) {
+                StoreLane(out_pose->GetChannel(channel), base, accumulate_array[channel]);
+            }
+        }
+
+        return;
+    }
+
+    void BfresSkeletalAnimPlayer::Sample(BfresSkeletalPose *out_pose, const BfresSkeletalPose *bind_pose, float frame) {
+
+        /* Start from the bind pose */
+        out_pose->Copy(bind_pose);
+
+        const ResBfresSkeletalAnim *skeletal_anim   = m_skeletal_anim;
+        const u32                   bone_anim_count = skeletal_anim->bone_anim_count;
+
+        /* Bone anim curves are one contiguous array indexed by base curve index, batch them all when that holds */
+        const ResBfresAnimCurve *curve_array     = nullptr;
+        bool                     is_single_batch = true;
+        for (u32 i = 0; i < bone_anim_count; ++i) {
+            const ResBfresBoneAnim *bone_anim = std::addressof(skeletal_anim->bone_anim_array[i]);
+            if (bone_anim->anim_curve_count == 0) { continue; }
+            const ResBfresAnimCurve *bone_curve_array = bone_anim->anim_curve_array - bone_anim->base_curve_index;
+            if (curve_array == nullptr) { curve_array = bone_curve_array; }
+            is_single_batch = is_single_batch & (curve_array == bone_curve_array);
+        }
+
+        /* Sample every curve */
+        if (is_single_batch == true && curve_array != nullptr) {
+            SampleBfresAnimCurveFloatArray(m_curve_value_array, curve_array, m_key_cursor_array, m_curve_count, frame);
+        } else if (curve_array != nullptr) {
+            for (u32 i = 0; i < bone_anim_count; ++i) {
+                const ResBfresBoneAnim *bone_anim = std::addressof(skeletal_anim->bone_anim_array[i]);
+                SampleBfresAnimCurveFloatArray(m_curve_value_array + bone_anim->base_curve_index, bone_anim->anim_curve_array, m_key_cursor_array + bone_anim->base_curve_index, bone_anim->anim_curve_count, frame);
+            }
+        }
+
+        /* Scatter bone anims into pose channels */
+        const bool is_euler = static_cast<BfresSkeletonRotationMode>(skeletal_anim->rotation_mode) == BfresSkeletonRotationMode::EulerXYZ;
+        for (u32 i = 0; i < bone_anim_count; ++i) {
+
+            const ResBfresBoneAnim *bone_anim  = std::addressof(skeletal_anim->bone_anim_array[i]);
+            const u32               bone_index = (skeletal_anim->bind_table != nullptr) ? skeletal_anim->bind_table[i] : i;
+            if (out_pose->GetBoneCount() <= bone_index) { continue; }
+
+            /* Apply constant results, packed as scale, rotate then translate for each component in use */
+            const float *default_iter = reinterpret_cast<const float*>(bone_anim->default_result);
+            if (default_iter != nullptr) {
+                if (bone_anim->is_use_scale == true) {
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::ScaleX)[bone_index] = default_iter[0];
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::ScaleY)[bone_index] = default_iter[1];
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::ScaleZ)[bone_index] = default_iter[2];
+                    default_iter = default_iter + 3;
+                }
+                if (bone_anim->is_use_rotation == true) {
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::RotateX)[bone_index] = default_iter[0];
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::RotateY)[bone_index] = default_iter[1];
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::RotateZ)[bone_index] = default_iter[2];
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::RotateW)[bone_index] = default_iter[3];
+                    default_iter = default_iter + 4;
+                }
+                if (bone_anim->is_use_translation == true) {
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::TranslateX)[bone_index] = default_iter[0];
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::TranslateY)[bone_index] = default_iter[1];
+                    out_pose->GetChannel(BfresSkeletalPoseChannel::TranslateZ)[bone_index] = default_iter[2];
+                }
+            }
+
+            /* Apply curve results */
+            for (u32 curve = 0; curve < bone_anim->anim_curve_count; ++curve) {
+                const u32 result_index = bone_anim->anim_curve_array[curve].base_result_offset / sizeof(float);
+                if (cBoneAnimCurveTargetTable.size() <= result_index) { continue; }
+                const BoneAnimCurveTarget &target = cBoneAnimCurveTargetTable[result_index];
+                if ((bone_anim->curve_type_mask & static_cast<u32>(target.curve_type)) == 0) { continue; }
+                out_pose->GetChannel(target.channel)[bone_index] = m_curve_value_array[bone_anim->base_curve_index + curve];
+            }
+
+            if (is_euler == true && bone_anim->is_use_rotation == true) { ConvertEulerXYZToQuaternion(out_pose, bone_index); }
+        }
+
+        return;
+    }
+
+    void BfresSkeletalPoseJob::Invoke() {
+
+        /* Sample layers */
+        for (u32 i = 0; i < m_layer_count; ++i) {
+            m_anim_player_array[i].Sample(std::addressof(m_layer_pose_array[i]), m_bind_pose, m_frame_array[i]);
+            m_layer_pose_pointer_array[i] = std::addressof(m_layer_pose_array[i]);
+        }
+
+        /* Blend layers */
+        if (m_layer_count == 0) {
+            m_out_pose->Copy(m_bind_pose);
+        } else if (m_layer_count == 1) {
+            m_out_pose->Copy(std::addressof(m_layer_pose_array[0]));
+        } else {
+            BlendBfresSkeletalPoses(m_out_pose, m_layer_pose_pointer_array, m_weight_array, m_layer_count);
+        }
+
+        /* Local to world */
+        if (m_out_world_matrix_array == nullptr) { return; }
+        m_out_pose->CalculateLocalMatrices(m_out_world_matrix_array);
+        BfresSkeletalPose::CalculateWorldMatrices(m_out_world_matrix_array, m_out_world_matrix_array, m_skeleton, m_root_matrix);
+
+        return;
+    }
+}
@@ -227,11 +227,11 @@ namespace vp::res {
             /* Swap data */
             u32 *data_offset = reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(hash_offset) + hash_size);
             *data_offset     = this->SwapEndianData(static_cast<ByamlDataType>(data_type_array[i]), *data_offset, big_data_cache);
+        }
 
-            /* Swap index */
-            if ((static_cast<u32>(container_type) & 0x10) != 0) {
-                remap_array[i] = vp::util::SwapEndian(remap_array[i]);
-            }
+        /* Swap remap indices */
+        if ((static_cast<u32>(container_type) & 0x10) != 0) {
+            vp::util::SwapEndianArray(remap_array, r_count);
         }
 
         return;
@@ -250,11 +250,11 @@ namespace vp::res {
 
             /* Swap data */
             pair_array[i].u32_value = this->SwapEndianData(static_cast<ByamlDataType>(pair_array[i].data_type), pair_array[i].u32_value, big_data_cache);
+        }
 
-            /* Swap index */
-            if (container_type == ByamlDataType::DictionaryWithRemap) {
-                remap_array[i] = vp::util::SwapEndian(remap_array[i]);
-            }
+        /* Swap remap indices */
+        if (container_type == ByamlDataType::DictionaryWithRemap) {
+            vp::util::SwapEndianArray(remap_array, r_count);
         }
 
         return;
@@ -378,9 +378,7 @@ namespace vp::res {
         const u32 string_count = (this->IsReverseEndian() == false) ? string_table->count : vp::util::SwapEndian24(string_table->count);
         const u32 index_count = string_count + 1;
         u32 *index_array = reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(string_table) + sizeof(ResByamlContainer));
-        for (u32 i = 0; i < index_count; ++i) {
-            index_array[i] = vp::util::SwapEndian(index_array[i]);
-        }
+        vp::util::SwapEndianArray(index_array, index_count);
 
         return;
     }
@@ -403,9 +401,7 @@ namespace vp::res {
         const u32 string_count = (this->IsReverseEndian() == false) ? key_table->count : vp::util::SwapEndian24(key_table->count);
         const u32 index_count = string_count + 1;
         u32 *index_array = reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(key_table) + sizeof(ResByamlContainer));
-        for (u32 i = 0; i < index_count; ++i) {
-            index_array[i] = vp::util::SwapEndian(index_array[i]);
-        }
+        vp::util::SwapEndianArray(index_array, index_count);
 
         return;
     }
@@ -118,4 +118,37 @@ namespace vp::res {
 
         return true;
 	}
+
+    void ResNintendoWareDictionaryHashTable::Initialize(const ResNintendoWareDictionary *dictionary, void *work_memory, size_t work_memory_size) {
+
+        /* Integrity checks */
+        VP_ASSERT(dictionary != nullptr);
+        VP_ASSERT(GetWorkMemorySize(dictionary) <= work_memory_size);
+
+        /* Set state */
+        const u32 node_count = (0 < dictionary->node_count) ? dictionary->node_count : 0;
+        const u32 slot_count = CalculateSlotCount(node_count);
+        m_dictionary = dictionary;
+        m_slot_array = reinterpret_cast<HashSlot*>(work_memory);
+        m_slot_mask  = slot_count - 1;
+
+        /* Clear slots */
+        for (u32 i = 0; i < slot_count; ++i) {
+            m_slot_array[i].key_hash    = 0;
+            m_slot_array[i].entry_index = cInvalidEntryIndex;
+        }
+
+        /* Insert every entry */
+        for (u32 i = 0; i < node_count; ++i) {
+            const u32 key_hash   = util::HashMurmur3(dictionary->GetKeyByEntryIndex(i) + 2);
+            u32       slot_index = key_hash & m_slot_mask;
+            while (m_slot_array[slot_index].entry_index != cInvalidEntryIndex) {
+                slot_index = (slot_index + 1) & m_slot_mask;
+            }
+            m_slot_array[slot_index].key_hash    = key_hash;
+            m_slot_array[slot_index].entry_index = i;
+        }
+
+        return;
+    }
 }
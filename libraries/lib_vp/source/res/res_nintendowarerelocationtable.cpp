@@ -17,94 +17,107 @@
 
 namespace vp::res {
 
-    ResNintendoWareFileHeader *ResNintendoWareRelocationTable::GetFileHeader() {
-        return reinterpret_cast<ResNintendoWareFileHeader*>(reinterpret_cast<uintptr_t>(this) - offset_from_header);
-    }
+    namespace {
 
-    void ResNintendoWareRelocationTable::Relocate() {
+        typedef size_t RelocationVector __attribute__((vector_size(32)));
+        constexpr u32 cRelocationVectorCount = sizeof(RelocationVector) / sizeof(size_t);
 
-        ResNintendoWareFileHeader *file_header = GetFileHeader();
+        /* Adds the file base to every non-null offset of a pointer array */
+        ALWAYS_INLINE void RelocatePointerArray(uintptr_t pointer_array_address, u32 pointer_count, uintptr_t file_base) {
 
-        /* No sections is valid */
-        if (section_count == 0) {
-            file_header->SetRelocated(true);
-            return;
-        }
+            const RelocationVector base_vector = file_base - RelocationVector{};
 
-        const uintptr_t base_file = reinterpret_cast<uintptr_t>(file_header);
+            /* Masked add per vector, null offsets have their lane masked off */
+            u32 i = 0;
+            for (; i + cRelocationVectorCount <= pointer_count; i += cRelocationVectorCount) {
+                void *address = reinterpret_cast<void*>(pointer_array_address + i * sizeof(size_t));
 
-        const size_t entry_table_offset = this->GetEntryTableOffset();
+                RelocationVector offset_vector;
+                ::memcpy(std::addressof(offset_vector), address, sizeof(RelocationVector));
+                offset_vector = offset_vector + (base_vector & reinterpret_cast<RelocationVector>(offset_vector != 0));
+                ::memcpy(address, std::addressof(offset_vector), sizeof(RelocationVector));
+            }
+            if (i == pointer_count) { return; }
+
+            #if defined(VP_TARGET_ARCHITECTURE_x86) && defined(VP_64_BIT)
+                /* Masked load and store of the remainder */
+                const u32 remainder  = pointer_count - i;
+                const util::v4sll lane_mask = util::v4sll{0, 1, 2, 3} < static_cast<long long>(remainder);
+
+                util::v4sll *address = reinterpret_cast<util::v4sll*>(pointer_array_address + i * sizeof(size_t));
+                util::v4sll offset_vector = __builtin_ia32_maskloadq256(address, lane_mask);
+                offset_vector = offset_vector + (reinterpret_cast<util::v4sll>(base_vector) & (offset_vector != 0));
+                __builtin_ia32_maskstoreq256(address, lane_mask, offset_vector);
+            #else
+                for (; i < pointer_count; ++i) {
+                    size_t *offset = reinterpret_cast<size_t*>(pointer_array_address + i * sizeof(size_t));
+                    *offset = (*offset != 0) ? file_base + *offset : 0;
+                }
+            #endif
+        }
+    }
 
-        /* Iterate each section */
-        for(u32 i = 0; i < section_count; ++i) {
+    ResNintendoWareFileHeader *ResNintendoWareRelocationTable::GetFileHeader() {
+        return reinterpret_cast<ResNintendoWareFileHeader*>(reinterpret_cast<uintptr_t>(this) - offset_from_header);
+    }
 
-            /* Get section and calculate file base */
-            ResSection *section = this->GetSection(i);
-            uintptr_t file_base = (section->base_pointer == nullptr) ? base_file : reinterpret_cast<uintptr_t>(section->base_pointer) - section->region_offset;
+    s32 ResNintendoWareRelocationTable::FindSectionIndex(const void *address) {
 
-            /* Relocate entries */
-            u32 entry_count = section->entry_count;
-            for(u32 entry_index = section->base_entry_index; entry_index < entry_count + section->base_entry_index; ++entry_index) {
+        /* Find the section whose region contains the address */
+        const uintptr_t file_offset = reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(this->GetFileHeader());
+        for (u32 i = 0; i < section_count; ++i) {
+            const ResSection *section = this->GetSection(i);
+            if (section->region_offset <= file_offset && file_offset < static_cast<uintptr_t>(section->region_offset) + section->region_size) {
+                return i;
+            }
+        }
 
-                /* Calculate entry offset */
-                const size_t entry_offset = entry_table_offset + entry_index * sizeof(ResEntry);
-                ResEntry *entry = reinterpret_cast<ResEntry*>(reinterpret_cast<uintptr_t>(this) + entry_offset);
+        return -1;
+    }
 
-                /* Calculate relocation offset */
-                uintptr_t region_offset = base_file + entry->region_offset;
+    void ResNintendoWareRelocationTable::RelocateSection(u32 section_index) {
 
-                /* Relocate */
-                const u8 offset_count = entry->relocation_count;
-                const u8 offset_mask = offset_count & 3;
-                for(u32 array_index = 0; array_index < entry->array_count; ++array_index) {
+        const uintptr_t base_file          = reinterpret_cast<uintptr_t>(this->GetFileHeader());
+        const size_t    entry_table_offset = this->GetEntryTableOffset();
 
-                    /* Quadruple method */
-                    uintptr_t region_offset_iter = region_offset;
-                    if (3 < offset_count) {
-                        for(s32 offset_index = offset_mask - offset_count; offset_index < 0; offset_index = offset_index + 4) {
+        /* Get section and calculate file base */
+        ResSection *section = this->GetSection(section_index);
+        uintptr_t file_base = (section->base_pointer == nullptr) ? base_file : reinterpret_cast<uintptr_t>(section->base_pointer) - section->region_offset;
 
-                            /* Calculate and set pointer in file (x4) */
-                            size_t *offset = reinterpret_cast<size_t*>(region_offset_iter);
-                            
-                            size_t relocation_pointer = (*offset != 0) ? reinterpret_cast<size_t>(file_base + *offset) : 0;
-                            *offset = relocation_pointer;
-                            region_offset_iter = region_offset_iter + sizeof(size_t);
-                            offset = reinterpret_cast<size_t*>(region_offset_iter);
+        /* Relocate entries */
+        const u32 end_entry_index = section->base_entry_index + section->entry_count;
+        for (u32 entry_index = section->base_entry_index; entry_index < end_entry_index; ++entry_index) {
 
-                            relocation_pointer = (*offset != 0) ? reinterpret_cast<size_t>(file_base + *offset) : 0;
-                            *offset = relocation_pointer;
-                            region_offset_iter = region_offset_iter + sizeof(size_t);
-                            offset = reinterpret_cast<size_t*>(region_offset_iter);
+            /* Calculate entry offset */
+            const size_t entry_offset = entry_table_offset + entry_index * sizeof(ResEntry);
+            ResEntry *entry = reinterpret_cast<ResEntry*>(reinterpret_cast<uintptr_t>(this) + entry_offset);
 
-                            relocation_pointer = (*offset != 0) ? reinterpret_cast<size_t>(file_base + *offset) : 0;
-                            *offset = relocation_pointer;
-                            region_offset_iter = region_offset_iter + sizeof(size_t);
-                            offset = reinterpret_cast<size_t*>(region_offset_iter);
-
-                            relocation_pointer = (*offset != 0) ? reinterpret_cast<size_t>(file_base + *offset) : 0;
-                            *offset = relocation_pointer;
-                            region_offset_iter = region_offset_iter + sizeof(size_t);
-                        }
-                    }
-                    if (offset_mask != 0) {
-                        for(s32 offset_index = -offset_mask; offset_index < 0; ++offset_index) {
+            /* Relocate each pointer array */
+            const u32 offset_count  = entry->relocation_count;
+            const u32 array_stride  = (offset_count + entry->array_stride) * sizeof(size_t);
+            uintptr_t region_offset = base_file + entry->region_offset;
+            for (u32 array_index = 0; array_index < entry->array_count; ++array_index) {
+                RelocatePointerArray(region_offset, offset_count, file_base);
+                region_offset = region_offset + array_stride;
+            }
+        }
 
-                            /* Calculate and set pointer in file */
-                            size_t *offset = reinterpret_cast<size_t*>(region_offset_iter);
-                            size_t relocation_pointer = (*offset != 0) ? reinterpret_cast<size_t>(file_base + *offset) : 0;
-                            *offset = relocation_pointer;
-                            region_offset_iter = region_offset_iter + sizeof(size_t);
-                        }
-                    }
+        return;
+    }
 
-                    /* Calculate next array's region offset */
-                    region_offset = region_offset + offset_count * sizeof(size_t) + entry->array_stride * sizeof(size_t);
-                }
-            }
+    void ResNintendoWareRelocationTable::RelocateSectionRange(u32 base_section_index, u32 section_range_count) {
+        for (u32 i = base_section_index; i < base_section_index + section_range_count; ++i) {
+            this->RelocateSection(i);
         }
+    }
+
+    void ResNintendoWareRelocationTable::Relocate() {
+
+        /* Relocate every section */
+        this->RelocateSectionRange(0, section_count);
 
         /* Set relocation guard */
-        file_header->SetRelocated(true);
+        this->GetFileHeader()->SetRelocated(true);
 
         return;
     }
@@ -190,4 +203,62 @@ namespace vp::res {
 
         return;
     }
+
+    void ResNintendoWareLazyRelocator::Initialize(ResNintendoWareRelocationTable *relocation_table, void *work_memory, size_t work_memory_size) {
+
+        /* Integrity checks */
+        VP_ASSERT(relocation_table != nullptr);
+        VP_ASSERT(GetWorkMemorySize(relocation_table) <= work_memory_size);
+
+        /* Set state */
+        m_relocation_table        = relocation_table;
+        m_section_state_array     = reinterpret_cast<u32*>(work_memory);
+        m_relocated_section_count = 0;
+        for (u32 i = 0; i < relocation_table->section_count; ++i) {
+            m_section_state_array[i] = SectionState_Unrelocated;
+        }
+
+        /* No sections is valid */
+        if (relocation_table->section_count == 0) {
+            relocation_table->GetFileHeader()->SetRelocated(true);
+        }
+
+        return;
+    }
+
+    void ResNintendoWareLazyRelocator::RelocateSection(u32 section_index) {
+
+        u32 *section_state = std::addressof(m_section_state_array[section_index]);
+
+        /* Fast path for relocated sections */
+        if (util::InterlockedLoadAcquire(section_state) == SectionState_Relocated) { return; }
+
+        /* Claim the section, or wait on the thread relocating it */
+        const bool is_claimed = util::InterlockedCompareExchangeAcquire(static_cast<u32*>(nullptr), section_state, static_cast<u32>(SectionState_Relocating), static_cast<u32>(SectionState_Unrelocated));
+        if (is_claimed == false) {
+            while (util::InterlockedLoadAcquire(section_state) != SectionState_Relocated) {
+                #ifdef VP_TARGET_ARCHITECTURE_x86
+                    util::x86::pause();
+                #endif
+            }
+            return;
+        }
+
+        /* Relocate section */
+        m_relocation_table->RelocateSection(section_index);
+        util::InterlockedStoreRelease(section_state, static_cast<u32>(SectionState_Relocated));
+
+        /* Set relocation guard after the last section */
+        if (util::InterlockedIncrement(std::addressof(m_relocated_section_count)) == m_relocation_table->section_count) {
+            m_relocation_table->GetFileHeader()->SetRelocated(true);
+        }
+
+        return;
+    }
+
+    void ResNintendoWareLazyRelocator::RelocateAddress(const void *address) {
+        const s32 section_index = m_relocation_table->FindSectionIndex(address);
+        if (section_index < 0) { return; }
+        this->RelocateSection(section_index);
+    }
 }
@@ -0,0 +1,219 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program;
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <vp.hpp>
+
+namespace vp::resbui {
+
+    u32 ResourceSizeTableBuilder::CountUniqueCollisionCrc32() {
+
+        /* Count each crc32 once, the collision list is expected to be small */
+        u32 unique_count = 0;
+        for (auto node_iter = m_collision_entry_list.begin(); node_iter != m_collision_entry_list.end(); ++node_iter) {
+            const u32 path_crc32 = (*node_iter).hash_node.GetKey();
+            bool is_unique = true;
+            for (auto prev_iter = m_collision_entry_list.begin(); prev_iter != node_iter; ++prev_iter) {
+                if ((*prev_iter).hash_node.GetKey() == path_crc32) { is_unique = false; break; }
+            }
+            unique_count += is_unique;
+        }
+
+        return unique_count;
+    }
+
+    u32 ResourceSizeTableBuilder::CalculateCollisionStringPoolSize() {
+        u32 string_pool_size = 0;
+        for (ResourceSizeNode &collision_node : m_collision_entry_list) {
+            string_pool_size += ::strlen(collision_node.collision_node.GetKey()) + 1;
+        }
+        return util::AlignUp(string_pool_size, alignof(u32));
+    }
+
+    size_t ResourceSizeTableBuilder::GetPerfectHashWorkMemorySize() {
+        const u32 key_count       = m_crc32_entry_list.GetCount() + m_collision_entry_list.GetCount();
+        const u32 bucket_count    = CalculatePerfectHashBucketCount(key_count);
+        const u32 collision_count = m_collision_entry_list.GetCount();
+        return key_count * sizeof(PerfectHashKey) + collision_count * sizeof(ResourceSizeNode*) + key_count * sizeof(u32) + (bucket_count + 1) * sizeof(u32) + bucket_count * sizeof(u32) + key_count * sizeof(u8);
+    }
+
+    size_t ResourceSizeTableBuilder::CalculatePerfectHashSerializedSize() {
+        const u32 entry_count = this->GetPerfectHashEntryCount();
+        return res::ResRsizetablePerfectHash::CalculateSize(entry_count, CalculatePerfectHashBucketCount(entry_count), m_collision_entry_list.GetCount(), this->CalculateCollisionStringPoolSize());
+    }
+
+    bool ResourceSizeTableBuilder::TryBuildPerfectHash(PerfectHashKey *key_array, u32 key_count, u32 *pilot_array, u32 bucket_count, u32 seed, void *work_memory) {
+
+        /* Partition work memory */
+        u32 *key_order_array    = reinterpret_cast<u32*>(work_memory);
+        u32 *bucket_start_array = key_order_array + key_count;
+        u32 *bucket_order_array = bucket_start_array + bucket_count + 1;
+        u8  *slot_used_array    = reinterpret_cast<u8*>(bucket_order_array + bucket_count);
+
+        /* Bucket keys */
+        ::memset(bucket_start_array, 0, (bucket_count + 1) * sizeof(u32));
+        for (u32 i = 0; i < key_count; ++i) {
+            key_array[i].bucket = res::CalculateRsizetableBucket(res::MixRsizetableHash(key_array[i].path_crc32, seed), bucket_count);
+            ++bucket_start_array[key_array[i].bucket + 1];
+        }
+        for (u32 i = 0; i < bucket_count; ++i) {
+            if (cPerfectHashMaxBucketSize < bucket_start_array[i + 1]) { return false; }
+            bucket_order_array[i]     = bucket_start_array[i];
+            bucket_start_array[i + 1] = bucket_start_array[i + 1] + bucket_start_array[i];
+        }
+        for (u32 i = 0; i < key_count; ++i) {
+            key_order_array[bucket_order_array[key_array[i].bucket]] = i;
+            ++bucket_order_array[key_array[i].bucket];
+        }
+
+        /* Place the largest buckets first while the table is emptiest */
+        for (u32 i = 0; i < bucket_count; ++i) {
+            bucket_order_array[i] = i;
+        }
+        std::sort(bucket_order_array, bucket_order_array + bucket_count, [bucket_start_array](u32 lhs, u32 rhs) {
+            return (bucket_start_array[rhs + 1] - bucket_start_array[rhs]) < (bucket_start_array[lhs + 1] - bucket_start_array[lhs]);
+        });
+        ::memset(slot_used_array, 0, key_count * sizeof(u8));
+
+        /* Search a pilot for each multi key bucket */
+        u32 bucket_iter = 0;
+        for (; bucket_iter < bucket_count; ++bucket_iter) {
+
+            const u32 bucket     = bucket_order_array[bucket_iter];
+            const u32 base_index = bucket_start_array[bucket];
+            const u32 size       = bucket_start_array[bucket + 1] - base_index;
+            if (size < 2) { break; }
+
+            u32 slot_array[cPerfectHashMaxBucketSize] = {};
+            u32 pilot = 0;
+            for (; pilot < cPerfectHashMaxPilot; ++pilot) {
+
+                /* Check every key of the bucket lands in a distinct free slot */
+                u32 placed_count = 0;
+                for (; placed_count < size; ++placed_count) {
+                    const u32 slot = res::CalculateRsizetableSlot(key_array[key_order_array[base_index + placed_count]].path_crc32, seed, pilot, key_count);
+                    if (slot_used_array[slot] != 0) { break; }
+                    slot_used_array[slot]    = 1;
+                    slot_array[placed_count] = slot;
+                }
+                if (placed_count == size) { break; }
+
+                /* Unwind a failed pilot */
+                for (u32 i = 0; i < placed_count; ++i) {
+                    slot_used_array[slot_array[i]] = 0;
+                }
+            }
+            if (pilot == cPerfectHashMaxPilot) { return false; }
+
+            pilot_array[bucket] = pilot;
+            for (u32 i = 0; i < size; ++i) {
+                key_array[key_order_array[base_index + i]].slot = slot_array[i];
+            }
+        }
+
+        /* Directly assign single key buckets to the remaining slots */
+        u32 free_slot = 0;
+        for (; bucket_iter < bucket_count; ++bucket_iter) {
+
+            const u32 bucket = bucket_order_array[bucket_iter];
+            const u32 size   = bucket_start_array[bucket + 1] - bucket_start_array[bucket];
+            if (size == 0) { pilot_array[bucket] = 0; continue; }
+
+            while (slot_used_array[free_slot] != 0) { ++free_slot; }
+            slot_used_array[free_slot] = 1;
+
+            pilot_array[bucket] = res::cRsizetablePilotDirectSlot | free_slot;
+            key_array[key_order_array[bucket_start_array[bucket]]].slot = free_slot;
+        }
+
+        return true;
+    }
+
+    bool ResourceSizeTableBuilder::SerializePerfectHash(void *file, size_t file_size, void *work_memory, size_t work_memory_size) {
+
+        /* Integrity checks */
+        const size_t serialized_size = this->CalculatePerfectHashSerializedSize();
+        if (file == nullptr || file_size < serialized_size)                                      { return false; }
+        if (work_memory == nullptr || work_memory_size < this->GetPerfectHashWorkMemorySize()) { return false; }
+
+        /* Partition work memory */
+        const u32          collision_count      = m_collision_entry_list.GetCount();
+        PerfectHashKey    *key_array            = reinterpret_cast<PerfectHashKey*>(work_memory);
+        ResourceSizeNode **collision_node_array = reinterpret_cast<ResourceSizeNode**>(key_array + m_crc32_entry_list.GetCount() + collision_count);
+        void              *build_work_memory    = collision_node_array + collision_count;
+
+        /* Gather keys, each crc32 collision is a single key redirecting to the collision table */
+        u32 key_count = 0;
+        for (ResourceSizeNode &hash_node : m_crc32_entry_list) {
+            key_array[key_count] = { hash_node.hash_node.GetKey(), hash_node.size, 0, 0 };
+            ++key_count;
+        }
+        u32 collision_iter = 0;
+        for (ResourceSizeNode &collision_node : m_collision_entry_list) {
+            key_array[key_count] = { collision_node.hash_node.GetKey(), res::cRsizetableCollisionSize, 0, 0 };
+            collision_node_array[collision_iter] = std::addressof(collision_node);
+            ++key_count;
+            ++collision_iter;
+        }
+        std::sort(key_array, key_array + key_count, [](const PerfectHashKey &lhs, const PerfectHashKey &rhs) { return lhs.path_crc32 < rhs.path_crc32; });
+        key_count = std::unique(key_array, key_array + key_count, [](const PerfectHashKey &lhs, const PerfectHashKey &rhs) { return lhs.path_crc32 == rhs.path_crc32; }) - key_array;
+
+        /* Clear memory */
+        ::memset(file, 0, serialized_size);
+
+        /* Write header */
+        res::ResRsizetablePerfectHash *rsizetable = reinterpret_cast<res::ResRsizetablePerfectHash*>(file);
+        rsizetable->magic0           = res::ResRsizetable::cMagic0;
+        rsizetable->magic1           = res::ResRsizetable::cMagic1;
+        rsizetable->version          = res::ResRsizetablePerfectHash::cTargetVersion;
+        rsizetable->entry_count      = key_count;
+        rsizetable->bucket_count     = CalculatePerfectHashBucketCount(key_count);
+        rsizetable->collision_count  = collision_count;
+        rsizetable->string_pool_size = this->CalculateCollisionStringPoolSize();
+
+        /* Search seeds until every bucket can be placed */
+        u32 seed = 0;
+        for (; seed < cPerfectHashMaxSeedCount; ++seed) {
+            if (this->TryBuildPerfectHash(key_array, key_count, rsizetable->pilot_array, rsizetable->bucket_count, seed, build_work_memory) == true) { break; }
+        }
+        if (seed == cPerfectHashMaxSeedCount) { return false; }
+        rsizetable->hash_seed = seed;
+
+        /* Write fingerprints and sizes by slot */
+        u16 *fingerprint_array = rsizetable->GetFingerprintArray();
+        u32 *size_array        = rsizetable->GetSizeArray();
+        for (u32 i = 0; i < key_count; ++i) {
+            fingerprint_array[key_array[i].slot] = res::CalculateRsizetableFingerprint(res::MixRsizetableHash(key_array[i].path_crc32, seed));
+            size_array[key_array[i].slot]        = key_array[i].resource_size;
+        }
+
+        /* Write collisions sorted by path for binary search */
+        std::sort(collision_node_array, collision_node_array + collision_count, [](ResourceSizeNode *lhs, ResourceSizeNode *rhs) {
+            return ::strcmp(lhs->collision_node.GetKey(), rhs->collision_node.GetKey()) < 0;
+        });
+        res::ResRsizetablePerfectHashCollision *collision_array = rsizetable->GetCollisionArray();
+        char                                   *string_pool     = const_cast<char*>(rsizetable->GetStringPool());
+        u32                                     string_offset   = 0;
+        for (u32 i = 0; i < collision_count; ++i) {
+            const char *path        = collision_node_array[i]->collision_node.GetKey();
+            const u32   path_length = ::strlen(path);
+            collision_array[i].string_offset = string_offset;
+            collision_array[i].resource_size = collision_node_array[i]->size;
+            ::memcpy(string_pool + string_offset, path, path_length + 1);
+            string_offset += path_length + 1;
+        }
+
+        return true;
+    }
+}
@@ -18,8 +18,9 @@
 namespace vp::util {
 
     void RotateLocalX(Matrix34f *out_rot_matrix, float theta) {
-        const float sin = SampleSin(theta * (static_cast<float>(cAngleIndexHalfRound) / cFloatPi));
-        const float cos = SampleCos(theta * (static_cast<float>(cAngleIndexHalfRound) / cFloatPi));
+        float sin = 0.0f;
+        float cos = 0.0f;
+        SinCos(std::addressof(sin), std::addressof(cos), theta);
         const float m12 = out_rot_matrix->m_arr2d[0][1];
         const float m22 = out_rot_matrix->m_arr2d[1][1];
         const float m32 = out_rot_matrix->m_arr2d[2][1];
@@ -32,8 +33,9 @@ namespace vp::util {
     }
 
     void RotateLocalY(Matrix34f *out_rot_matrix, float theta) {
-        const float sin = SampleSin(theta * (static_cast<float>(cAngleIndexHalfRound) / cFloatPi));
-        const float cos = SampleCos(theta * (static_cast<float>(cAngleIndexHalfRound) / cFloatPi));
+        float sin = 0.0f;
+        float cos = 0.0f;
+        SinCos(std::addressof(sin), std::addressof(cos), theta);
         const float m11 = out_rot_matrix->m_arr2d[0][0];
         const float m21 = out_rot_matrix->m_arr2d[1][0];
         const float m31 = out_rot_matrix->m_arr2d[2][0];
@@ -46,8 +48,9 @@ namespace vp::util {
     }
 
     void RotateLocalZ(Matrix34f *out_rot_matrix, float theta) {
-        const float sin = SampleSin(theta * (static_cast<float>(cAngleIndexHalfRound) / cFloatPi));
-        const float cos = SampleCos(theta * (static_cast<float>(cAngleIndexHalfRound) / cFloatPi));
+        float sin = 0.0f;
+        float cos = 0.0f;
+        SinCos(std::addressof(sin), std::addressof(cos), theta);
         const float m11 = out_rot_matrix->m_arr2d[0][0];
         const float m21 = out_rot_matrix->m_arr2d[1][0];
         const float m31 = out_rot_matrix->m_arr2d[2][0];
@@ -58,4 +61,24 @@ namespace vp::util {
         out_rot_matrix->m_arr2d[2][0] = (m31 * cos)                           + (out_rot_matrix->m_arr2d[2][1] * sin);
         out_rot_matrix->m_arr2d[2][1] = (out_rot_matrix->m_arr2d[2][1] * cos) - (m31 * sin);
     }
+
+    void MultiplyMatrix34(Matrix34f *out_matrix, const Matrix34f &lhs, const Matrix34f &rhs) {
+
+        /* Load rhs rows, the implicit fourth row is (0, 0, 0, 1) */
+        const v4f rhs_row1 = rhs.m_row1.GetVectorType();
+        const v4f rhs_row2 = rhs.m_row2.GetVectorType();
+        const v4f rhs_row3 = rhs.m_row3.GetVectorType();
+        const v4f rhs_row4 = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+        /* Each out row is a linear combination of rhs rows */
+        v4f out_row_array[3];
+        for (u32 i = 0; i < 3; ++i) {
+            const v4f lhs_row = lhs.m_row_array[i].GetVectorType();
+            out_row_array[i]  = rhs_row1 * lhs_row[0] + rhs_row2 * lhs_row[1] + rhs_row3 * lhs_row[2] + rhs_row4 * lhs_row[3];
+        }
+
+        out_matrix->m_row1 = out_row_array[0];
+        out_matrix->m_row2 = out_row_array[1];
+        out_matrix->m_row3 = out_row_array[2];
+    }
 }
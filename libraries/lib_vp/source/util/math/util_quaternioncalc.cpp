@@ -0,0 +1,266 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <vp.hpp>
+
+namespace vp::util {
+
+    namespace {
+
+        constexpr u32   cLaneCount          = sizeof(v8f) / sizeof(float);
+        constexpr float cSlerpLinearCosine  = 0.9995f;
+
+        ALWAYS_INLINE v8f LoadLane(const void *address) {
+            v8f lane;
+            ::memcpy(std::addressof(lane), address, sizeof(v8f));
+            return lane;
+        }
+        ALWAYS_INLINE void StoreLane(void *address, v8f lane) {
+            ::memcpy(address, std::addressof(lane), sizeof(v8f));
+        }
+
+        ALWAYS_INLINE v8f BroadcastLane(float value) {
+            return v8f{ value, value, value, value, value, value, value, value };
+        }
+
+        ALWAYS_INLINE v8f ReciprocalSqrtLane(v8f lane) {
+            #ifdef VP_TARGET_ARCHITECTURE_x86
+                return 1.0f / __builtin_ia32_sqrtps256(lane);
+            #else
+                v8f result;
+                for (u32 i = 0; i < cLaneCount; ++i) {
+                    result[i] = 1.0f / ::sqrtf(lane[i]);
+                }
+                return result;
+            #endif
+        }
+
+        /* Transposes 8 packed quaternions (4 lanes) to x, y, z and w lanes */
+        struct QuaternionLane {
+            v8f x;
+            v8f y;
+            v8f z;
+            v8f w;
+
+            ALWAYS_INLINE void Load(const Quaternionf *quaternion_array) {
+                const v8f packed0 = LoadLane(quaternion_array + 0);
+                const v8f packed1 = LoadLane(quaternion_array + 2);
+                const v8f packed2 = LoadLane(quaternion_array + 4);
+                const v8f packed3 = LoadLane(quaternion_array + 6);
+                const v8f xy0 = __builtin_shuffle(packed0, packed1, v8si{ 0, 4, 8, 12, 1, 5, 9, 13 });
+                const v8f zw0 = __builtin_shuffle(packed0, packed1, v8si{ 2, 6, 10, 14, 3, 7, 11, 15 });
+                const v8f xy1 = __builtin_shuffle(packed2, packed3, v8si{ 0, 4, 8, 12, 1, 5, 9, 13 });
+                const v8f zw1 = __builtin_shuffle(packed2, packed3, v8si{ 2, 6, 10, 14, 3, 7, 11, 15 });
+                x = __builtin_shuffle(xy0, xy1, v8si{ 0, 1, 2, 3, 8, 9, 10, 11 });
+                y = __builtin_shuffle(xy0, xy1, v8si{ 4, 5, 6, 7, 12, 13, 14, 15 });
+                z = __builtin_shuffle(zw0, zw1, v8si{ 0, 1, 2, 3, 8, 9, 10, 11 });
+                w = __builtin_shuffle(zw0, zw1, v8si{ 4, 5, 6, 7, 12, 13, 14, 15 });
+            }
+
+            ALWAYS_INLINE void Store(Quaternionf *quaternion_array) const {
+                const v8f xy0 = __builtin_shuffle(x, y, v8si{ 0, 1, 2, 3, 8, 9, 10, 11 });
+                const v8f xy1 = __builtin_shuffle(x, y, v8si{ 4, 5, 6, 7, 12, 13, 14, 15 });
+                const v8f zw0 = __builtin_shuffle(z, w, v8si{ 0, 1, 2, 3, 8, 9, 10, 11 });
+                const v8f zw1 = __builtin_shuffle(z, w, v8si{ 4, 5, 6, 7, 12, 13, 14, 15 });
+                StoreLane(quaternion_array + 0, __builtin_shuffle(xy0, zw0, v8si{ 0, 4, 8, 12, 1, 5, 9, 13 }));
+                StoreLane(quaternion_array + 2, __builtin_shuffle(xy0, zw0, v8si{ 2, 6, 10, 14, 3, 7, 11, 15 }));
+                StoreLane(quaternion_array + 4, __builtin_shuffle(xy1, zw1, v8si{ 0, 4, 8, 12, 1, 5, 9, 13 }));
+                StoreLane(quaternion_array + 6, __builtin_shuffle(xy1, zw1, v8si{ 2, 6, 10, 14, 3, 7, 11, 15 }));
+            }
+        };
+
+        enum class InterpolationType {
+            Nlerp,
+            Slerp,
+            SlerpFast,
+        };
+
+        /* Fitted correction of t so nlerp tracks slerp, cosine is of the shortest arc */
+        template <typename T>
+        ALWAYS_INLINE T CalculateSlerpFastT(T cosine, T t) {
+            const T a = 1.0904f + cosine * (-3.2452f + cosine * (3.55645f - cosine * 1.43519f));
+            const T b = 0.848013f + cosine * (-1.06021f + cosine * 0.215638f);
+            const T k = a * (t - 0.5f) * (t - 0.5f) + b;
+            return t + t * (t - 0.5f) * (t - 1.0f) * k;
+        }
+
+        ALWAYS_INLINE void CalculateSlerpWeights(float *out_from_weight, float *out_to_weight, float cosine, float t) {
+
+            /* Fallback to linear weights when the arc is near zero */
+            if (cSlerpLinearCosine < cosine) {
+                *out_from_weight = 1.0f - t;
+                *out_to_weight   = t;
+                return;
+            }
+
+            const float angle       = ::acosf(cosine);
+            const float inverse_sin = 1.0f / ::sinf(angle);
+            *out_from_weight = ::sinf((1.0f - t) * angle) * inverse_sin;
+            *out_to_weight   = ::sinf(t * angle) * inverse_sin;
+        }
+
+        template <InterpolationType Type>
+        void Interpolate(Quaternionf *out_quaternion, const Quaternionf &from, const Quaternionf &to, float t) {
+
+            /* Take the shortest arc */
+            const float dot    = from.Dot(to);
+            const float sign   = (dot < 0.0f) ? -1.0f : 1.0f;
+            const float cosine = dot * sign;
+
+            /* Calculate weights */
+            float from_weight = 1.0f - t;
+            float to_weight   = t;
+            if constexpr (Type == InterpolationType::SlerpFast) {
+                to_weight   = CalculateSlerpFastT(cosine, t);
+                from_weight = 1.0f - to_weight;
+            } else if constexpr (Type == InterpolationType::Slerp) {
+                CalculateSlerpWeights(std::addressof(from_weight), std::addressof(to_weight), cosine, t);
+            }
+
+            /* Blend and renormalize */
+            const Quaternionf blend(from.GetVectorType() * from_weight + to.GetVectorType() * (to_weight * sign));
+            *out_quaternion = blend.GetNormalized();
+        }
+
+        template <InterpolationType Type>
+        void InterpolateArray(Quaternionf *out_quaternion_array, const Quaternionf *from_array, const Quaternionf *to_array, float t, u32 count) {
+
+            const v8f t_lane = BroadcastLane(t);
+
+            u32 i = 0;
+            for (; i + cLaneCount <= count; i += cLaneCount) {
+
+                /* Load as SoA lanes */
+                QuaternionLane from;
+                QuaternionLane to;
+                from.Load(from_array + i);
+                to.Load(to_array + i);
+
+                /* Take the shortest arc */
+                const v8f dot    = from.x * to.x + from.y * to.y + from.z * to.z + from.w * to.w;
+                const v8f sign   = (dot < 0.0f) ? BroadcastLane(-1.0f) : BroadcastLane(1.0f);
+                const v8f cosine = dot * sign;
+
+                /* Calculate weights */
+                v8f from_weight = 1.0f - t_lane;
+                v8f to_weight   = t_lane;
+                if constexpr (Type == InterpolationType::SlerpFast) {
+                    to_weight   = CalculateSlerpFastT(cosine, t_lane);
+                    from_weight = 1.0f - to_weight;
+                } else if constexpr (Type == InterpolationType::Slerp) {
+                    for (u32 lane = 0; lane < cLaneCount; ++lane) {
+                        float from_lane_weight = 0.0f;
+                        float to_lane_weight   = 0.0f;
+                        CalculateSlerpWeights(std::addressof(from_lane_weight), std::addressof(to_lane_weight), cosine[lane], t);
+                        from_weight[lane] = from_lane_weight;
+                        to_weight[lane]   = to_lane_weight;
+                    }
+                }
+                to_weight = to_weight * sign;
+
+                /* Blend and renormalize */
+                QuaternionLane out;
+                out.x = from.x * from_weight + to.x * to_weight;
+                out.y = from.y * from_weight + to.y * to_weight;
+                out.z = from.z * from_weight + to.z * to_weight;
+                out.w = from.w * from_weight + to.w * to_weight;
+                const v8f inverse_length = ReciprocalSqrtLane(out.x * out.x + out.y * out.y + out.z * out.z + out.w * out.w);
+                out.x *= inverse_length;
+                out.y *= inverse_length;
+                out.z *= inverse_length;
+                out.w *= inverse_length;
+                out.Store(out_quaternion_array + i);
+            }
+
+            /* Remainder */
+            for (; i < count; ++i) {
+                Interpolate<Type>(std::addressof(out_quaternion_array[i]), from_array[i], to_array[i], t);
+            }
+        }
+    }
+
+    void MakeMatrix34FromQuaternion(Matrix34f *out_matrix, const Quaternionf &quaternion, const Vector3f &translate) {
+
+        const float x  = quaternion.x;
+        const float y  = quaternion.y;
+        const float z  = quaternion.z;
+        const float w  = quaternion.w;
+        const float xx = x * x;
+        const float yy = y * y;
+        const float zz = z * z;
+        const float xy = x * y;
+        const float xz = x * z;
+        const float yz = y * z;
+        const float wx = w * x;
+        const float wy = w * y;
+        const float wz = w * z;
+
+        out_matrix->m_arr2d[0][0] = 1.0f - 2.0f * (yy + zz);
+        out_matrix->m_arr2d[0][1] = 2.0f * (xy - wz);
+        out_matrix->m_arr2d[0][2] = 2.0f * (xz + wy);
+        out_matrix->m_arr2d[0][3] = translate.x;
+        out_matrix->m_arr2d[1][0] = 2.0f * (xy + wz);
+        out_matrix->m_arr2d[1][1] = 1.0f - 2.0f * (xx + zz);
+        out_matrix->m_arr2d[1][2] = 2.0f * (yz - wx);
+        out_matrix->m_arr2d[1][3] = translate.y;
+        out_matrix->m_arr2d[2][0] = 2.0f * (xz - wy);
+        out_matrix->m_arr2d[2][1] = 2.0f * (yz + wx);
+        out_matrix->m_arr2d[2][2] = 1.0f - 2.0f * (xx + yy);
+        out_matrix->m_arr2d[2][3] = translate.z;
+    }
+
+    void MakeQuaternionFromMatrix34(Quaternionf *out_quaternion, const Matrix34f &matrix) {
+
+        const float m00 = matrix.m_arr2d[0][0];
+        const float m11 = matrix.m_arr2d[1][1];
+        const float m22 = matrix.m_arr2d[2][2];
+        const float trace = m00 + m11 + m22;
+
+        /* Solve for the largest component first for stability */
+        if (0.0f < trace) {
+            const float s = 0.5f / ::sqrtf(trace + 1.0f);
+            *out_quaternion = Quaternionf((matrix.m_arr2d[2][1] - matrix.m_arr2d[1][2]) * s, (matrix.m_arr2d[0][2] - matrix.m_arr2d[2][0]) * s, (matrix.m_arr2d[1][0] - matrix.m_arr2d[0][1]) * s, 0.25f / s);
+        } else if (m11 < m00 && m22 < m00) {
+            const float s = 0.5f / ::sqrtf(1.0f + m00 - m11 - m22);
+            *out_quaternion = Quaternionf(0.25f / s, (matrix.m_arr2d[0][1] + matrix.m_arr2d[1][0]) * s, (matrix.m_arr2d[0][2] + matrix.m_arr2d[2][0]) * s, (matrix.m_arr2d[2][1] - matrix.m_arr2d[1][2]) * s);
+        } else if (m22 < m11) {
+            const float s = 0.5f / ::sqrtf(1.0f + m11 - m00 - m22);
+            *out_quaternion = Quaternionf((matrix.m_arr2d[0][1] + matrix.m_arr2d[1][0]) * s, 0.25f / s, (matrix.m_arr2d[1][2] + matrix.m_arr2d[2][1]) * s, (matrix.m_arr2d[0][2] - matrix.m_arr2d[2][0]) * s);
+        } else {
+            const float s = 0.5f / ::sqrtf(1.0f + m22 - m00 - m11);
+            *out_quaternion = Quaternionf((matrix.m_arr2d[0][2] + matrix.m_arr2d[2][0]) * s, (matrix.m_arr2d[1][2] + matrix.m_arr2d[2][1]) * s, 0.25f / s, (matrix.m_arr2d[1][0] - matrix.m_arr2d[0][1]) * s);
+        }
+    }
+
+    void Nlerp(Quaternionf *out_quaternion, const Quaternionf &from, const Quaternionf &to, float t) {
+        Interpolate<InterpolationType::Nlerp>(out_quaternion, from, to, t);
+    }
+    void Slerp(Quaternionf *out_quaternion, const Quaternionf &from, const Quaternionf &to, float t) {
+        Interpolate<InterpolationType::Slerp>(out_quaternion, from, to, t);
+    }
+    void SlerpFast(Quaternionf *out_quaternion, const Quaternionf &from, const Quaternionf &to, float t) {
+        Interpolate<InterpolationType::SlerpFast>(out_quaternion, from, to, t);
+    }
+
+    void NlerpQuaternionArray(Quaternionf *out_quaternion_array, const Quaternionf *from_array, const Quaternionf *to_array, float t, u32 count) {
+        InterpolateArray<InterpolationType::Nlerp>(out_quaternion_array, from_array, to_array, t, count);
+    }
+    void SlerpQuaternionArray(Quaternionf *out_quaternion_array, const Quaternionf *from_array, const Quaternionf *to_array, float t, u32 count) {
+        InterpolateArray<InterpolationType::Slerp>(out_quaternion_array, from_array, to_array, t, count);
+    }
+    void SlerpFastQuaternionArray(Quaternionf *out_quaternion_array, const Quaternionf *from_array, const Quaternionf *to_array, float t, u32 count) {
+        InterpolateArray<InterpolationType::SlerpFast>(out_quaternion_array, from_array, to_array, t, count);
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <vp.hpp>
+
+namespace vp::util {
+
+    namespace {
+
+        constexpr u32 cLaneCount = sizeof(v8f) / sizeof(float);
+
+        template <SinCosAccuracy Accuracy>
+        void SinCosArrayImpl(float *out_sin_array, float *out_cos_array, const float *angle_array, u32 count) {
+
+            /* Full lanes */
+            const u32 lane_end = count & ~(cLaneCount - 1);
+            for (u32 i = 0; i < lane_end; i += cLaneCount) {
+                v8f angle;
+                ::memcpy(std::addressof(angle), angle_array + i, sizeof(v8f));
+
+                v8f sin;
+                v8f cos;
+                SinCos<Accuracy>(std::addressof(sin), std::addressof(cos), angle);
+
+                ::memcpy(out_sin_array + i, std::addressof(sin), sizeof(v8f));
+                ::memcpy(out_cos_array + i, std::addressof(cos), sizeof(v8f));
+            }
+
+            /* Remainder */
+            for (u32 i = lane_end; i < count; ++i) {
+                const float angle = angle_array[i];
+                SinCos<Accuracy>(out_sin_array + i, out_cos_array + i, angle);
+            }
+        }
+    }
+
+    void SinCosArray(float *out_sin_array, float *out_cos_array, const float *angle_array, u32 count, SinCosAccuracy accuracy) {
+        if (accuracy == SinCosAccuracy::Fast) {
+            SinCosArrayImpl<SinCosAccuracy::Fast>(out_sin_array, out_cos_array, angle_array, count);
+        } else {
+            SinCosArrayImpl<SinCosAccuracy::Precise>(out_sin_array, out_cos_array, angle_array, count);
+        }
+    }
+}
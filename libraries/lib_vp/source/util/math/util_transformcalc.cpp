@@ -0,0 +1,337 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <vp.hpp>
+
+namespace vp::util {
+
+    namespace {
+
+        constexpr u32    cLaneCount     = sizeof(v8f) / sizeof(float);
+        constexpr size_t cLaneAlignment = alignof(v8f);
+
+        template <bool IsAligned>
+        ALWAYS_INLINE v8f LoadLane(const float *address) {
+            if constexpr (IsAligned == true) {
+                return *reinterpret_cast<const v8f*>(address);
+            } else {
+                v8f lane;
+                ::memcpy(std::addressof(lane), address, sizeof(v8f));
+                return lane;
+            }
+        }
+        template <bool IsAligned>
+        ALWAYS_INLINE void StoreLane(float *address, v8f lane) {
+            if constexpr (IsAligned == true) {
+                *reinterpret_cast<v8f*>(address) = lane;
+            } else {
+                ::memcpy(address, std::addressof(lane), sizeof(v8f));
+            }
+        }
+
+        ALWAYS_INLINE bool IsLaneAligned(const void *address) {
+            return (reinterpret_cast<uintptr_t>(address) & (cLaneAlignment - 1)) == 0;
+        }
+
+        ALWAYS_INLINE v8f BroadcastLane(float value) {
+            return v8f{ value, value, value, value, value, value, value, value };
+        }
+
+        ALWAYS_INLINE v8f AbsLane(v8f lane) {
+            return reinterpret_cast<v8f>(reinterpret_cast<v8ui>(lane) & 0x7fff'ffffu);
+        }
+        ALWAYS_INLINE v4f AbsVector(v4f vector) {
+            return reinterpret_cast<v4f>(reinterpret_cast<v4ui>(vector) & 0x7fff'ffffu);
+        }
+
+        /* Splits 8 packed xyz vectors (3 lanes) into x, y and z lanes */
+        ALWAYS_INLINE void DeinterleaveVector3Lane(v8f *out_x, v8f *out_y, v8f *out_z, v8f packed0, v8f packed1, v8f packed2) {
+            const v8f x01 = __builtin_shuffle(packed0, packed1, v8si{ 0, 3, 6, 9, 12, 15, 0, 0 });
+            const v8f y01 = __builtin_shuffle(packed0, packed1, v8si{ 1, 4, 7, 10, 13, 0, 0, 0 });
+            const v8f z01 = __builtin_shuffle(packed0, packed1, v8si{ 2, 5, 8, 11, 14, 0, 0, 0 });
+            *out_x = __builtin_shuffle(x01, packed2, v8si{ 0, 1, 2, 3, 4, 5, 10, 13 });
+            *out_y = __builtin_shuffle(y01, packed2, v8si{ 0, 1, 2, 3, 4, 8, 11, 14 });
+            *out_z = __builtin_shuffle(z01, packed2, v8si{ 0, 1, 2, 3, 4, 9, 12, 15 });
+        }
+
+        /* Packs x, y and z lanes into 8 xyz vectors (3 lanes) */
+        ALWAYS_INLINE void InterleaveVector3Lane(v8f *out_packed0, v8f *out_packed1, v8f *out_packed2, v8f x, v8f y, v8f z) {
+            const v8f xy0 = __builtin_shuffle(x, y, v8si{ 0, 8, 0, 1, 9, 0, 2, 10 });
+            const v8f xy1 = __builtin_shuffle(x, y, v8si{ 0, 3, 11, 0, 4, 12, 0, 5 });
+            const v8f xy2 = __builtin_shuffle(x, y, v8si{ 13, 0, 6, 14, 0, 7, 15, 0 });
+            *out_packed0 = __builtin_shuffle(xy0, z, v8si{ 0, 1, 8, 3, 4, 9, 6, 7 });
+            *out_packed1 = __builtin_shuffle(xy1, z, v8si{ 10, 1, 2, 11, 4, 5, 12, 7 });
+            *out_packed2 = __builtin_shuffle(xy2, z, v8si{ 0, 13, 2, 3, 14, 5, 6, 15 });
+        }
+
+        /* Matrix broadcast to lanes, translation is zeroed for directions */
+        struct MatrixLane {
+            v8f m[3][4];
+
+            ALWAYS_INLINE MatrixLane(const Matrix34f &matrix, bool is_direction) {
+                for (u32 i = 0; i < 3; ++i) {
+                    for (u32 j = 0; j < 3; ++j) {
+                        m[i][j] = BroadcastLane(matrix.m_arr2d[i][j]);
+                    }
+                    m[i][3] = BroadcastLane((is_direction == true) ? 0.0f : matrix.m_arr2d[i][3]);
+                }
+            }
+
+            ALWAYS_INLINE void Transform(v8f *out_x, v8f *out_y, v8f *out_z, v8f x, v8f y, v8f z) const {
+                *out_x = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+                *out_y = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+                *out_z = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+            }
+        };
+
+        ALWAYS_INLINE void TransformVector3(Vector3f *out_vector, const Matrix34f &matrix, const Vector3f &vector, float w) {
+            const float x = vector.x;
+            const float y = vector.y;
+            const float z = vector.z;
+            out_vector->x = matrix.m_arr2d[0][0] * x + matrix.m_arr2d[0][1] * y + matrix.m_arr2d[0][2] * z + matrix.m_arr2d[0][3] * w;
+            out_vector->y = matrix.m_arr2d[1][0] * x + matrix.m_arr2d[1][1] * y + matrix.m_arr2d[1][2] * z + matrix.m_arr2d[1][3] * w;
+            out_vector->z = matrix.m_arr2d[2][0] * x + matrix.m_arr2d[2][1] * y + matrix.m_arr2d[2][2] * z + matrix.m_arr2d[2][3] * w;
+        }
+
+        void TransformVector3ArrayImpl(Vector3f *out_vector_array, const Matrix34f &matrix, const Vector3f *vector_array, u32 count, bool is_direction) {
+
+            /* Transform 8 vectors at a time through SoA lanes */
+            const MatrixLane matrix_lane(matrix, is_direction);
+            u32 i = 0;
+            for (; i + cLaneCount <= count; i += cLaneCount) {
+                const float *input  = reinterpret_cast<const float*>(vector_array + i);
+                float       *output = reinterpret_cast<float*>(out_vector_array + i);
+
+                v8f x, y, z;
+                DeinterleaveVector3Lane(std::addressof(x), std::addressof(y), std::addressof(z), LoadLane<false>(input), LoadLane<false>(input + cLaneCount), LoadLane<false>(input + cLaneCount * 2));
+                matrix_lane.Transform(std::addressof(x), std::addressof(y), std::addressof(z), x, y, z);
+
+                v8f packed0, packed1, packed2;
+                InterleaveVector3Lane(std::addressof(packed0), std::addressof(packed1), std::addressof(packed2), x, y, z);
+                StoreLane<false>(output, packed0);
+                StoreLane<false>(output + cLaneCount, packed1);
+                StoreLane<false>(output + cLaneCount * 2, packed2);
+            }
+
+            /* Remainder */
+            const float w = (is_direction == true) ? 0.0f : 1.0f;
+            for (; i < count; ++i) {
+                TransformVector3(std::addressof(out_vector_array[i]), matrix, vector_array[i], w);
+            }
+        }
+
+        template <bool IsAligned>
+        void TransformVector3ArraySoaImpl(float *out_x_array, float *out_y_array, float *out_z_array, const MatrixLane &matrix_lane, const float *x_array, const float *y_array, const float *z_array, u32 count) {
+            for (u32 i = 0; i < count; i += cLaneCount) {
+                v8f x, y, z;
+                matrix_lane.Transform(std::addressof(x), std::addressof(y), std::addressof(z), LoadLane<IsAligned>(x_array + i), LoadLane<IsAligned>(y_array + i), LoadLane<IsAligned>(z_array + i));
+                StoreLane<IsAligned>(out_x_array + i, x);
+                StoreLane<IsAligned>(out_y_array + i, y);
+                StoreLane<IsAligned>(out_z_array + i, z);
+            }
+        }
+
+        void TransformVector3ArraySoa(float *out_x_array, float *out_y_array, float *out_z_array, const Matrix34f &matrix, const float *x_array, const float *y_array, const float *z_array, u32 count, bool is_direction) {
+
+            /* Transform whole lanes, taking the aligned path when every array allows it */
+            const MatrixLane matrix_lane(matrix, is_direction);
+            const u32        lane_end   = count & ~(cLaneCount - 1);
+            const bool       is_aligned = IsLaneAligned(out_x_array) & IsLaneAligned(out_y_array) & IsLaneAligned(out_z_array) & IsLaneAligned(x_array) & IsLaneAligned(y_array) & IsLaneAligned(z_array);
+            if (is_aligned == true) {
+                TransformVector3ArraySoaImpl<true>(out_x_array, out_y_array, out_z_array, matrix_lane, x_array, y_array, z_array, lane_end);
+            } else {
+                TransformVector3ArraySoaImpl<false>(out_x_array, out_y_array, out_z_array, matrix_lane, x_array, y_array, z_array, lane_end);
+            }
+
+            /* Remainder */
+            const float w = (is_direction == true) ? 0.0f : 1.0f;
+            for (u32 i = lane_end; i < count; ++i) {
+                Vector3f vector(x_array[i], y_array[i], z_array[i]);
+                TransformVector3(std::addressof(vector), matrix, vector, w);
+                out_x_array[i] = vector.x;
+                out_y_array[i] = vector.y;
+                out_z_array[i] = vector.z;
+            }
+        }
+
+        ALWAYS_INLINE v8f MakeLanePair(const float *low, const float *high) {
+            v8f lane;
+            ::memcpy(std::addressof(lane), low, sizeof(v4f));
+            ::memcpy(reinterpret_cast<float*>(std::addressof(lane)) + 4, high, sizeof(v4f));
+            return lane;
+        }
+        ALWAYS_INLINE v8f BroadcastLanePair(float low, float high) {
+            return v8f{ low, low, low, low, high, high, high, high };
+        }
+
+        /* Multiplies two pairs of row major matrices at once, one per 128 bit half. Row count 3 has an implicit (0, 0, 0, 1) fourth row */
+        template <u32 RowCount>
+        ALWAYS_INLINE void MultiplyRowMajorPair(float *out0, float *out1, const float *lhs0, const float *lhs1, const float *rhs0, const float *rhs1) {
+
+            /* Load rhs row pairs */
+            v8f rhs_row_array[4];
+            for (u32 k = 0; k < RowCount; ++k) {
+                rhs_row_array[k] = MakeLanePair(rhs0 + k * 4, rhs1 + k * 4);
+            }
+            if constexpr (RowCount == 3) {
+                rhs_row_array[3] = v8f{ 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+            }
+
+            /* Each out row is a linear combination of rhs rows */
+            v8f out_row_array[RowCount];
+            for (u32 i = 0; i < RowCount; ++i) {
+                out_row_array[i] = rhs_row_array[0] * BroadcastLanePair(lhs0[i * 4 + 0], lhs1[i * 4 + 0])
+                                 + rhs_row_array[1] * BroadcastLanePair(lhs0[i * 4 + 1], lhs1[i * 4 + 1])
+                                 + rhs_row_array[2] * BroadcastLanePair(lhs0[i * 4 + 2], lhs1[i * 4 + 2])
+                                 + rhs_row_array[3] * BroadcastLanePair(lhs0[i * 4 + 3], lhs1[i * 4 + 3]);
+            }
+
+            /* Store after every row is computed so out may alias */
+            for (u32 i = 0; i < RowCount; ++i) {
+                ::memcpy(out0 + i * 4, std::addressof(out_row_array[i]), sizeof(v4f));
+                ::memcpy(out1 + i * 4, reinterpret_cast<const float*>(std::addressof(out_row_array[i])) + 4, sizeof(v4f));
+            }
+        }
+
+        template <u32 RowCount, typename Matrix>
+        void MultiplyRowMajorArray(Matrix *out_matrix_array, const Matrix *lhs_matrix_array, size_t lhs_stride, const Matrix *rhs_matrix_array, u32 count) {
+
+            /* Two matrices per iteration, an odd remainder is paired with itself */
+            for (u32 i = 0; i < count; i += 2) {
+                const u32 i1 = (i + 1 < count) ? i + 1 : i;
+                MultiplyRowMajorPair<RowCount>(out_matrix_array[i].m_arr, out_matrix_array[i1].m_arr, lhs_matrix_array[i * lhs_stride].m_arr, lhs_matrix_array[i1 * lhs_stride].m_arr, rhs_matrix_array[i].m_arr, rhs_matrix_array[i1].m_arr);
+            }
+        }
+    }
+
+    void TransformPointArray(Vector3f *out_point_array, const Matrix34f &matrix, const Vector3f *point_array, u32 count) {
+        TransformVector3ArrayImpl(out_point_array, matrix, point_array, count, false);
+    }
+    void TransformPointArraySoa(float *out_x_array, float *out_y_array, float *out_z_array, const Matrix34f &matrix, const float *x_array, const float *y_array, const float *z_array, u32 count) {
+        TransformVector3ArraySoa(out_x_array, out_y_array, out_z_array, matrix, x_array, y_array, z_array, count, false);
+    }
+
+    void TransformNormalArray(Vector3f *out_normal_array, const Matrix34f &matrix, const Vector3f *normal_array, u32 count) {
+        TransformVector3ArrayImpl(out_normal_array, matrix, normal_array, count, true);
+    }
+    void TransformNormalArraySoa(float *out_x_array, float *out_y_array, float *out_z_array, const Matrix34f &matrix, const float *x_array, const float *y_array, const float *z_array, u32 count) {
+        TransformVector3ArraySoa(out_x_array, out_y_array, out_z_array, matrix, x_array, y_array, z_array, count, true);
+    }
+
+    void MultiplyMatrix34Array(Matrix34f *out_matrix_array, const Matrix34f *lhs_matrix_array, const Matrix34f *rhs_matrix_array, u32 count) {
+        MultiplyRowMajorArray<3>(out_matrix_array, lhs_matrix_array, 1, rhs_matrix_array, count);
+    }
+    void MultiplyMatrix34Array(Matrix34f *out_matrix_array, const Matrix34f &lhs_matrix, const Matrix34f *rhs_matrix_array, u32 count) {
+        const Matrix34f lhs = lhs_matrix;
+        MultiplyRowMajorArray<3>(out_matrix_array, std::addressof(lhs), 0, rhs_matrix_array, count);
+    }
+
+    void MultiplyMatrix44(Matrix44f *out_matrix, const Matrix44f &lhs, const Matrix44f &rhs) {
+
+        /* Each out row is a linear combination of rhs rows */
+        v4f out_row_array[4];
+        for (u32 i = 0; i < 4; ++i) {
+            out_row_array[i] = rhs.m_row1.GetVectorType() * lhs.m_arr2d[i][0] + rhs.m_row2.GetVectorType() * lhs.m_arr2d[i][1] + rhs.m_row3.GetVectorType() * lhs.m_arr2d[i][2] + rhs.m_row4.GetVectorType() * lhs.m_arr2d[i][3];
+        }
+
+        out_matrix->m_row1 = out_row_array[0];
+        out_matrix->m_row2 = out_row_array[1];
+        out_matrix->m_row3 = out_row_array[2];
+        out_matrix->m_row4 = out_row_array[3];
+    }
+    void MultiplyMatrix44Array(Matrix44f *out_matrix_array, const Matrix44f *lhs_matrix_array, const Matrix44f *rhs_matrix_array, u32 count) {
+        MultiplyRowMajorArray<4>(out_matrix_array, lhs_matrix_array, 1, rhs_matrix_array, count);
+    }
+    void MultiplyMatrix44Array(Matrix44f *out_matrix_array, const Matrix44f &lhs_matrix, const Matrix44f *rhs_matrix_array, u32 count) {
+        const Matrix44f lhs = lhs_matrix;
+        MultiplyRowMajorArray<4>(out_matrix_array, std::addressof(lhs), 0, rhs_matrix_array, count);
+    }
+
+    void TransformBoundingBox3(BoundingBox3f *out_box, const Matrix34f &matrix, const BoundingBox3f &box) {
+
+        /* Matrix columns */
+        const v4f column0 = { matrix.m_arr2d[0][0], matrix.m_arr2d[1][0], matrix.m_arr2d[2][0], 0.0f };
+        const v4f column1 = { matrix.m_arr2d[0][1], matrix.m_arr2d[1][1], matrix.m_arr2d[2][1], 0.0f };
+        const v4f column2 = { matrix.m_arr2d[0][2], matrix.m_arr2d[1][2], matrix.m_arr2d[2][2], 0.0f };
+        const v4f column3 = { matrix.m_arr2d[0][3], matrix.m_arr2d[1][3], matrix.m_arr2d[2][3], 0.0f };
+
+        /* Transform the center, and the extent by the absolute matrix */
+        const v4f center = (box.max.GetVectorType() + box.min.GetVectorType()) * 0.5f;
+        const v4f extent = (box.max.GetVectorType() - box.min.GetVectorType()) * 0.5f;
+        const v4f out_center = column0 * center[0] + column1 * center[1] + column2 * center[2] + column3;
+        const v4f out_extent = AbsVector(column0) * extent[0] + AbsVector(column1) * extent[1] + AbsVector(column2) * extent[2];
+
+        out_box->min = Vector3f(out_center - out_extent);
+        out_box->max = Vector3f(out_center + out_extent);
+    }
+    void TransformBoundingBox3Array(BoundingBox3f *out_box_array, const Matrix34f &matrix, const BoundingBox3f *box_array, u32 count) {
+        for (u32 i = 0; i < count; ++i) {
+            TransformBoundingBox3(std::addressof(out_box_array[i]), matrix, box_array[i]);
+        }
+    }
+
+    void TransformBoundingBox3ArraySoa(const BoundingBox3fSoaArray &out_box_array, const Matrix34f &matrix, const ConstBoundingBox3fSoaArray &box_array, u32 count) {
+
+        /* Absolute matrix lanes for the extent */
+        const MatrixLane matrix_lane(matrix, false);
+        v8f abs_matrix_lane[3][3];
+        for (u32 i = 0; i < 3; ++i) {
+            for (u32 j = 0; j < 3; ++j) {
+                abs_matrix_lane[i][j] = AbsLane(matrix_lane.m[i][j]);
+            }
+        }
+
+        /* Transform 8 boxes at a time */
+        const v8f half = BroadcastLane(0.5f);
+        u32 i = 0;
+        for (; i + cLaneCount <= count; i += cLaneCount) {
+            const v8f min_x = LoadLane<false>(box_array.min_x + i);
+            const v8f min_y = LoadLane<false>(box_array.min_y + i);
+            const v8f min_z = LoadLane<false>(box_array.min_z + i);
+            const v8f max_x = LoadLane<false>(box_array.max_x + i);
+            const v8f max_y = LoadLane<false>(box_array.max_y + i);
+            const v8f max_z = LoadLane<false>(box_array.max_z + i);
+
+            v8f center_x, center_y, center_z;
+            matrix_lane.Transform(std::addressof(center_x), std::addressof(center_y), std::addressof(center_z), (max_x + min_x) * half, (max_y + min_y) * half, (max_z + min_z) * half);
+            const v8f extent_x  = (max_x - min_x) * half;
+            const v8f extent_y  = (max_y - min_y) * half;
+            const v8f extent_z  = (max_z - min_z) * half;
+            const v8f out_ext_x = abs_matrix_lane[0][0] * extent_x + abs_matrix_lane[0][1] * extent_y + abs_matrix_lane[0][2] * extent_z;
+            const v8f out_ext_y = abs_matrix_lane[1][0] * extent_x + abs_matrix_lane[1][1] * extent_y + abs_matrix_lane[1][2] * extent_z;
+            const v8f out_ext_z = abs_matrix_lane[2][0] * extent_x + abs_matrix_lane[2][1] * extent_y + abs_matrix_lane[2][2] * extent_z;
+
+            StoreLane<false>(out_box_array.min_x + i, center_x - out_ext_x);
+            StoreLane<false>(out_box_array.min_y + i, center_y - out_ext_y);
+            StoreLane<false>(out_box_array.min_z + i, center_z - out_ext_z);
+            StoreLane<false>(out_box_array.max_x + i, center_x + out_ext_x);
+            StoreLane<false>(out_box_array.max_y + i, center_y + out_ext_y);
+            StoreLane<false>(out_box_array.max_z + i, center_z + out_ext_z);
+        }
+
+        /* Remainder */
+        for (; i < count; ++i) {
+            const BoundingBox3f box = { Vector3f(box_array.min_x[i], box_array.min_y[i], box_array.min_z[i]), Vector3f(box_array.max_x[i], box_array.max_y[i], box_array.max_z[i]) };
+            BoundingBox3f out_box;
+            TransformBoundingBox3(std::addressof(out_box), matrix, box);
+            out_box_array.min_x[i] = out_box.min.x;
+            out_box_array.min_y[i] = out_box.min.y;
+            out_box_array.min_z[i] = out_box.min.z;
+            out_box_array.max_x[i] = out_box.max.x;
+            out_box_array.max_y[i] = out_box.max.y;
+            out_box_array.max_z[i] = out_box.max.z;
+        }
+    }
+}
@@ -19,9 +19,9 @@ namespace vp::util {
 
     /* Rotates a vector by "angle" along the x-axis */
     void RotateVectorAxisX(Vector3f *out_vector, const Vector3f& rot_vector, float angle) {
-        const float index = angle * (static_cast<float>(cAngleIndexHalfRound) / cFloatPi);
-        const float sin = SampleSin(index);
-        const float cos = SampleCos(index);
+        float sin = 0.0f;
+        float cos = 0.0f;
+        SinCos(std::addressof(sin), std::addressof(cos), angle);
         /*  | x                       |
          *  | y*sin(ang) - z*cos(ang) |
          *  | y*cos(ang) + z*sin(ang) |
@@ -33,9 +33,9 @@ namespace vp::util {
 
     /* Rotates a vector by "angle" along the y-axis */
     void RotateVectorAxisY(Vector3f *out_vector, const Vector3f& rot_vector, float angle) {
-        const float index = angle * (static_cast<float>(cAngleIndexHalfRound) / cFloatPi);
-        const float sin = SampleSin(index);
-        const float cos = SampleCos(index);
+        float sin = 0.0f;
+        float cos = 0.0f;
+        SinCos(std::addressof(sin), std::addressof(cos), angle);
         /*  | z*cos(ang) + x*sin(ang) |
          *  | y                       |
          *  | z*sin(ang) - x*cos(ang) |
@@ -47,9 +47,9 @@ namespace vp::util {
 
     /* Rotates a vector by "angle" along the y-axis */
     void RotateVectorAxisZ(Vector3f *out_vector, const Vector3f& rot_vector, float angle) {
-        const float index = angle * (static_cast<float>(cAngleIndexHalfRound) / cFloatPi);
-        const float sin = SampleSin(index);
-        const float cos = SampleCos(index);
+        float sin = 0.0f;
+        float cos = 0.0f;
+        SinCos(std::addressof(sin), std::addressof(cos), angle);
         /*  | x*sin(ang) - y*cos(ang) |
          *  | x*cos(ang) + y*sin(ang) |
          *  | z                       |
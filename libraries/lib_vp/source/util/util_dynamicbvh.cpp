@@ -0,0 +1,695 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <vp.hpp>
+
+namespace vp::util {
+
+    namespace {
+
+        constexpr u32 cLaneCount      = sizeof(v8f) / sizeof(float);
+        constexpr u32 cFullLaneMask   = (1u << cLaneCount) - 1;
+        constexpr u16 cFreeNodeHeight = 0xffff;
+
+        /* Loads "count" floats into a lane, unused lanes are zero */
+        ALWAYS_INLINE v8f LoadLane(const float *address, u32 count) {
+            v8f lane = {};
+            ::memcpy(std::addressof(lane), address, sizeof(float) * count);
+            return lane;
+        }
+
+        ALWAYS_INLINE v8f BroadcastLane(float value) {
+            return v8f{ value, value, value, value, value, value, value, value };
+        }
+
+        ALWAYS_INLINE v8f MinLane(v8f lhs, v8f rhs) {
+            return (lhs < rhs) ? lhs : rhs;
+        }
+        ALWAYS_INLINE v8f MaxLane(v8f lhs, v8f rhs) {
+            return (lhs < rhs) ? rhs : lhs;
+        }
+
+        /* Packs the sign bit of each lane into the low 8 bits */
+        ALWAYS_INLINE u32 GetLaneMask(v8si mask) {
+            #if defined(VP_TARGET_ARCHITECTURE_x86)
+                return static_cast<u32>(__builtin_ia32_movmskps256(reinterpret_cast<v8f>(mask)));
+            #else
+                u32 bits = 0;
+                for (u32 i = 0; i < cLaneCount; ++i) {
+                    bits |= static_cast<u32>(mask[i] & 1) << i;
+                }
+                return bits;
+            #endif
+        }
+
+        ALWAYS_INLINE BoundingBox3f MergeBoundingBox(const BoundingBox3f &lhs, const BoundingBox3f &rhs) {
+            return {
+                Vector3f(Min(lhs.min.x, rhs.min.x), Min(lhs.min.y, rhs.min.y), Min(lhs.min.z, rhs.min.z)),
+                Vector3f(Max(lhs.max.x, rhs.max.x), Max(lhs.max.y, rhs.max.y), Max(lhs.max.z, rhs.max.z))
+            };
+        }
+
+        ALWAYS_INLINE bool IsBoundingBoxEqual(const BoundingBox3f &lhs, const BoundingBox3f &rhs) {
+            return lhs.min.x == rhs.min.x && lhs.min.y == rhs.min.y && lhs.min.z == rhs.min.z && lhs.max.x == rhs.max.x && lhs.max.y == rhs.max.y && lhs.max.z == rhs.max.z;
+        }
+
+        /* Half of the surface area, only used for relative insertion costs */
+        ALWAYS_INLINE float CalculateHalfSurfaceArea(const BoundingBox3f &box) {
+            const float x = box.max.x - box.min.x;
+            const float y = box.max.y - box.min.y;
+            const float z = box.max.z - box.min.z;
+            return x * y + y * z + z * x;
+        }
+
+        /* Doubled centroid along an axis */
+        ALWAYS_INLINE float GetCentroid(const BoundingBox3f &box, u32 axis) {
+            switch (axis) {
+                case 0:  return box.min.x + box.max.x;
+                case 1:  return box.min.y + box.max.y;
+                default: return box.min.z + box.max.z;
+            }
+        }
+    }
+
+    struct DynamicBvh::OverlapPacket {
+        v8f min_x;
+        v8f min_y;
+        v8f min_z;
+        v8f max_x;
+        v8f max_y;
+        v8f max_z;
+
+        ALWAYS_INLINE u32 TestBoundingBox(float box_min_x, float box_min_y, float box_min_z, float box_max_x, float box_max_y, float box_max_z) const {
+            const v8si overlap = (BroadcastLane(box_min_x) <= max_x) & (min_x <= BroadcastLane(box_max_x))
+                               & (BroadcastLane(box_min_y) <= max_y) & (min_y <= BroadcastLane(box_max_y))
+                               & (BroadcastLane(box_min_z) <= max_z) & (min_z <= BroadcastLane(box_max_z));
+            return GetLaneMask(overlap);
+        }
+    };
+
+    struct DynamicBvh::RayPacket {
+        v8f origin_x;
+        v8f origin_y;
+        v8f origin_z;
+        v8f inverse_direction_x;
+        v8f inverse_direction_y;
+        v8f inverse_direction_z;
+        v8f max_t;
+
+        /* Slab test clipped to [0, max t] */
+        ALWAYS_INLINE u32 TestBoundingBox(float box_min_x, float box_min_y, float box_min_z, float box_max_x, float box_max_y, float box_max_z) const {
+            const v8f t0_x = (BroadcastLane(box_min_x) - origin_x) * inverse_direction_x;
+            const v8f t1_x = (BroadcastLane(box_max_x) - origin_x) * inverse_direction_x;
+            const v8f t0_y = (BroadcastLane(box_min_y) - origin_y) * inverse_direction_y;
+            const v8f t1_y = (BroadcastLane(box_max_y) - origin_y) * inverse_direction_y;
+            const v8f t0_z = (BroadcastLane(box_min_z) - origin_z) * inverse_direction_z;
+            const v8f t1_z = (BroadcastLane(box_max_z) - origin_z) * inverse_direction_z;
+            const v8f t_near = MaxLane(MaxLane(MinLane(t0_x, t1_x), MinLane(t0_y, t1_y)), MaxLane(MinLane(t0_z, t1_z), v8f{}));
+            const v8f t_far  = MinLane(MinLane(MaxLane(t0_x, t1_x), MaxLane(t0_y, t1_y)), MinLane(MaxLane(t0_z, t1_z), max_t));
+            return GetLaneMask(t_near <= t_far);
+        }
+    };
+
+    bool DynamicBvh::Initialize(imem::IHeap *heap, u32 max_proxy_count) {
+
+        /* Integrity checks */
+        if (max_proxy_count == 0) { return false; }
+
+        /* A full binary tree over n leaves has n - 1 internal nodes */
+        const u32    node_capacity    = max_proxy_count * 2 - 1;
+        const size_t node_size        = sizeof(Node) * node_capacity;
+        const size_t build_entry_size = sizeof(BuildEntry) * max_proxy_count;
+        const size_t slot_size        = sizeof(u32) * max_proxy_count;
+
+        /* Allocate nodes and rebuild memory together */
+        void *memory = ::operator new(node_size + build_entry_size + slot_size, heap, alignof(Node));
+        if (memory == nullptr) { return false; }
+
+        m_node_array          = reinterpret_cast<Node*>(memory);
+        m_build_entry_array   = reinterpret_cast<BuildEntry*>(reinterpret_cast<uintptr_t>(memory) + node_size);
+        m_internal_slot_array = reinterpret_cast<u32*>(reinterpret_cast<uintptr_t>(m_build_entry_array) + build_entry_size);
+        m_node_capacity       = node_capacity;
+        m_max_proxy_count     = max_proxy_count;
+        m_proxy_count         = 0;
+        m_root_index          = cInvalidIndex;
+        m_root_box            = {};
+
+        /* Link every node into the free list */
+        m_free_index = cInvalidIndex;
+        for (u32 i = node_capacity; 0 < i; --i) {
+            this->FreeNode(i - 1);
+        }
+
+        return true;
+    }
+
+    void DynamicBvh::Finalize() {
+        if (m_node_array != nullptr) {
+            ::operator delete(m_node_array);
+        }
+        m_node_array          = nullptr;
+        m_build_entry_array   = nullptr;
+        m_internal_slot_array = nullptr;
+        m_node_capacity       = 0;
+        m_max_proxy_count     = 0;
+        m_proxy_count         = 0;
+        m_root_index          = cInvalidIndex;
+        m_free_index          = cInvalidIndex;
+    }
+
+    u32 DynamicBvh::AllocateNode() {
+        const u32 node_index = m_free_index;
+        VP_ASSERT(node_index != cInvalidIndex);
+        m_free_index = m_node_array[node_index].parent_index;
+        return node_index;
+    }
+
+    void DynamicBvh::FreeNode(u32 node_index) {
+        Node *node         = std::addressof(m_node_array[node_index]);
+        node->parent_index = m_free_index;
+        node->height       = cFreeNodeHeight;
+        m_free_index       = node_index;
+    }
+
+    BoundingBox3f DynamicBvh::GetChildBoundingBox(const Node &node, u32 slot) {
+        return {
+            Vector3f(node.child_min_x[slot], node.child_min_y[slot], node.child_min_z[slot]),
+            Vector3f(node.child_max_x[slot], node.child_max_y[slot], node.child_max_z[slot])
+        };
+    }
+
+    void DynamicBvh::SetChildBoundingBox(Node *node, u32 slot, const BoundingBox3f &box) {
+        node->child_min_x[slot] = box.min.x;
+        node->child_min_y[slot] = box.min.y;
+        node->child_min_z[slot] = box.min.z;
+        node->child_max_x[slot] = box.max.x;
+        node->child_max_y[slot] = box.max.y;
+        node->child_max_z[slot] = box.max.z;
+    }
+
+    BoundingBox3f DynamicBvh::GetNodeBoundingBox(u32 node_index) const {
+        if (node_index == m_root_index) { return m_root_box; }
+        const Node &node = m_node_array[node_index];
+        return GetChildBoundingBox(m_node_array[node.parent_index], node.parent_slot);
+    }
+
+    void DynamicBvh::SetNodeBoundingBox(u32 node_index, const BoundingBox3f &box) {
+        if (node_index == m_root_index) { m_root_box = box; return; }
+        const Node &node = m_node_array[node_index];
+        SetChildBoundingBox(std::addressof(m_node_array[node.parent_index]), node.parent_slot, box);
+    }
+
+    void DynamicBvh::SetChild(u32 parent_index, u32 slot, u32 child_index, const BoundingBox3f &box) {
+        Node *parent = std::addressof(m_node_array[parent_index]);
+        Node *child  = std::addressof(m_node_array[child_index]);
+        parent->child_index[slot] = child_index;
+        child->parent_index       = parent_index;
+        child->parent_slot        = slot;
+        SetChildBoundingBox(parent, slot, box);
+    }
+
+    void DynamicBvh::SetRoot(u32 node_index, const BoundingBox3f &box) {
+        m_root_index                          = node_index;
+        m_root_box                            = box;
+        m_node_array[node_index].parent_index = cInvalidIndex;
+        m_node_array[node_index].parent_slot  = 0;
+    }
+
+    u32 DynamicBvh::RotateUp(u32 node_index, u32 heavy_slot) {
+
+        /* Read the heavy child "c" and its taller child before relinking */
+        Node      *node        = std::addressof(m_node_array[node_index]);
+        const u32  light_slot  = 1 - heavy_slot;
+        const u32  light_index = node->child_index[light_slot];
+        const u32  c_index     = node->child_index[heavy_slot];
+        Node      *c           = std::addressof(m_node_array[c_index]);
+        const u32  tall_slot   = (m_node_array[c->child_index[1]].height < m_node_array[c->child_index[0]].height) ? 0 : 1;
+        const u32  tall_index  = c->child_index[tall_slot];
+        const u32  short_index = c->child_index[1 - tall_slot];
+
+        const BoundingBox3f light_box = GetChildBoundingBox(*node, light_slot);
+        const BoundingBox3f tall_box  = GetChildBoundingBox(*c, tall_slot);
+        const BoundingBox3f short_box = GetChildBoundingBox(*c, 1 - tall_slot);
+        const BoundingBox3f node_box  = MergeBoundingBox(light_box, short_box);
+        const BoundingBox3f c_box     = MergeBoundingBox(node_box, tall_box);
+        const u32           parent    = node->parent_index;
+        const u32           slot      = node->parent_slot;
+
+        /* The node keeps its light child and adopts the shorter grandchild */
+        this->SetChild(node_index, heavy_slot, short_index, short_box);
+        node->height = 1 + Max(m_node_array[light_index].height, m_node_array[short_index].height);
+
+        /* "c" takes the place of the node */
+        this->SetChild(c_index, 0, node_index, node_box);
+        this->SetChild(c_index, 1, tall_index, tall_box);
+        c->height = 1 + Max(node->height, m_node_array[tall_index].height);
+        if (parent == cInvalidIndex) {
+            this->SetRoot(c_index, c_box);
+        } else {
+            this->SetChild(parent, slot, c_index, c_box);
+        }
+
+        return c_index;
+    }
+
+    u32 DynamicBvh::Balance(u32 node_index) {
+
+        const Node &node = m_node_array[node_index];
+        if (node.height < 2) { return node_index; }
+
+        const s32 balance = static_cast<s32>(m_node_array[node.child_index[1]].height) - static_cast<s32>(m_node_array[node.child_index[0]].height);
+        if (1 < balance)  { return this->RotateUp(node_index, 1); }
+        if (balance < -1) { return this->RotateUp(node_index, 0); }
+
+        return node_index;
+    }
+
+    void DynamicBvh::UpdateAncestors(u32 node_index) {
+        while (node_index != cInvalidIndex) {
+            node_index = this->Balance(node_index);
+
+            Node *node   = std::addressof(m_node_array[node_index]);
+            node->height = 1 + Max(m_node_array[node->child_index[0]].height, m_node_array[node->child_index[1]].height);
+            this->SetNodeBoundingBox(node_index, MergeBoundingBox(GetChildBoundingBox(*node, 0), GetChildBoundingBox(*node, 1)));
+
+            node_index = node->parent_index;
+        }
+    }
+
+    u32 DynamicBvh::Insert(const BoundingBox3f &box, void *user_data) {
+
+        /* Integrity checks */
+        if (m_max_proxy_count <= m_proxy_count) { return cInvalidIndex; }
+
+        /* Allocate leaf */
+        const u32 leaf_index = this->AllocateNode();
+        Node     *leaf       = std::addressof(m_node_array[leaf_index]);
+        leaf->user_data      = user_data;
+        leaf->height         = 0;
+        ++m_proxy_count;
+
+        if (m_root_index == cInvalidIndex) {
+            this->SetRoot(leaf_index, box);
+            return leaf_index;
+        }
+
+        /* Descend to the sibling with the lowest surface area cost */
+        u32           sibling_index = m_root_index;
+        BoundingBox3f sibling_box   = m_root_box;
+        while (m_node_array[sibling_index].IsLeaf() == false) {
+
+            const Node  &node             = m_node_array[sibling_index];
+            const float  area             = CalculateHalfSurfaceArea(sibling_box);
+            const float  combined_area    = CalculateHalfSurfaceArea(MergeBoundingBox(sibling_box, box));
+            const float  cost             = 2.0f * combined_area;
+            const float  inheritance_cost = 2.0f * (combined_area - area);
+
+            BoundingBox3f child_box[2];
+            float         child_cost[2];
+            for (u32 slot = 0; slot < 2; ++slot) {
+                child_box[slot] = GetChildBoundingBox(node, slot);
+                const float merged_area = CalculateHalfSurfaceArea(MergeBoundingBox(child_box[slot], box));
+                const float grown_area  = (m_node_array[node.child_index[slot]].IsLeaf() == true) ? merged_area : merged_area - CalculateHalfSurfaceArea(child_box[slot]);
+                child_cost[slot] = grown_area + inheritance_cost;
+            }
+            if (cost < child_cost[0] && cost < child_cost[1]) { break; }
+
+            const u32 slot = (child_cost[1] < child_cost[0]) ? 1 : 0;
+            sibling_index  = node.child_index[slot];
+            sibling_box    = child_box[slot];
+        }
+
+        /* Join the sibling and leaf under a new parent */
+        const u32           old_parent_index = m_node_array[sibling_index].parent_index;
+        const u32           old_parent_slot  = m_node_array[sibling_index].parent_slot;
+        const u32           parent_index     = this->AllocateNode();
+        const BoundingBox3f parent_box       = MergeBoundingBox(sibling_box, box);
+        this->SetChild(parent_index, 0, sibling_index, sibling_box);
+        this->SetChild(parent_index, 1, leaf_index, box);
+        m_node_array[parent_index].height = m_node_array[sibling_index].height + 1;
+
+        if (old_parent_index == cInvalidIndex) {
+            this->SetRoot(parent_index, parent_box);
+        } else {
+            this->SetChild(old_parent_index, old_parent_slot, parent_index, parent_box);
+            this->UpdateAncestors(old_parent_index);
+        }
+
+        return leaf_index;
+    }
+
+    void DynamicBvh::Remove(u32 proxy_id) {
+
+        VP_ASSERT(m_node_array[proxy_id].IsLeaf() == true);
+        --m_proxy_count;
+
+        if (proxy_id == m_root_index) {
+            m_root_index = cInvalidIndex;
+            this->FreeNode(proxy_id);
+            return;
+        }
+
+        /* Replace the parent with the sibling */
+        const u32            parent_index  = m_node_array[proxy_id].parent_index;
+        const Node          &parent        = m_node_array[parent_index];
+        const u32            sibling_slot  = 1 - m_node_array[proxy_id].parent_slot;
+        const u32            sibling_index = parent.child_index[sibling_slot];
+        const BoundingBox3f  sibling_box   = GetChildBoundingBox(parent, sibling_slot);
+        const u32            grand_index   = parent.parent_index;
+        if (grand_index == cInvalidIndex) {
+            this->SetRoot(sibling_index, sibling_box);
+        } else {
+            this->SetChild(grand_index, parent.parent_slot, sibling_index, sibling_box);
+            this->UpdateAncestors(grand_index);
+        }
+
+        this->FreeNode(parent_index);
+        this->FreeNode(proxy_id);
+    }
+
+    void DynamicBvh::Refit(u32 proxy_id, const BoundingBox3f &box) {
+
+        VP_ASSERT(m_node_array[proxy_id].IsLeaf() == true);
+        this->SetNodeBoundingBox(proxy_id, box);
+
+        /* Refit ancestors until one is unchanged */
+        u32 node_index = m_node_array[proxy_id].parent_index;
+        while (node_index != cInvalidIndex) {
+            const Node          &node       = m_node_array[node_index];
+            const BoundingBox3f  merged_box = MergeBoundingBox(GetChildBoundingBox(node, 0), GetChildBoundingBox(node, 1));
+            if (IsBoundingBoxEqual(merged_box, this->GetNodeBoundingBox(node_index)) == true) { break; }
+
+            this->SetNodeBoundingBox(node_index, merged_box);
+            node_index = node.parent_index;
+        }
+    }
+
+    void DynamicBvh::QueryOverlapPacket(const OverlapPacket &packet, u32 lane_mask, u32 query_base, OverlapCallback *callback) const {
+
+        /* Test the root */
+        lane_mask &= packet.TestBoundingBox(m_root_box.min.x, m_root_box.min.y, m_root_box.min.z, m_root_box.max.x, m_root_box.max.y, m_root_box.max.z);
+        if (lane_mask == 0) { return; }
+        if (m_node_array[m_root_index].IsLeaf() == true) {
+            for (u32 mask = lane_mask; mask != 0; mask &= mask - 1) {
+                callback->Invoke(query_base + __builtin_ctz(mask), m_root_index);
+            }
+            return;
+        }
+
+        /* Depth first traversal, both children bounds are in the node */
+        TraversalEntry stack[cMaxTraversalDepth];
+        u32            stack_count = 1;
+        stack[0] = { m_root_index, lane_mask };
+        while (stack_count != 0) {
+            --stack_count;
+            const TraversalEntry entry = stack[stack_count];
+            const Node          &node  = m_node_array[entry.node_index];
+
+            for (u32 slot = 0; slot < 2; ++slot) {
+                const u32 child_mask = entry.lane_mask & packet.TestBoundingBox(node.child_min_x[slot], node.child_min_y[slot], node.child_min_z[slot], node.child_max_x[slot], node.child_max_y[slot], node.child_max_z[slot]);
+                if (child_mask == 0) { continue; }
+
+                const u32 child_index = node.child_index[slot];
+                if (m_node_array[child_index].IsLeaf() == true) {
+                    for (u32 mask = child_mask; mask != 0; mask &= mask - 1) {
+                        callback->Invoke(query_base + __builtin_ctz(mask), child_index);
+                    }
+                    continue;
+                }
+
+                VP_ASSERT(stack_count < cMaxTraversalDepth);
+                stack[stack_count] = { child_index, child_mask };
+                ++stack_count;
+            }
+        }
+    }
+
+    void DynamicBvh::RayCastPacket(RayPacket *packet, u32 lane_mask, u32 ray_base, RayCastCallback *callback) const {
+
+        /* Reports a leaf hit to every lane in the mask and clips or stops each ray by the result */
+        u32 active_mask = lane_mask;
+        auto report_hit = [&](u32 hit_mask, u32 leaf_index) {
+            for (u32 mask = hit_mask; mask != 0; mask &= mask - 1) {
+                const u32   lane  = __builtin_ctz(mask);
+                const float max_t = callback->Invoke(ray_base + lane, leaf_index, packet->max_t[lane]);
+                if (max_t < 0.0f) {
+                    active_mask &= ~(1u << lane);
+                } else {
+                    packet->max_t[lane] = max_t;
+                }
+            }
+        };
+
+        /* Test the root */
+        const u32 root_mask = active_mask & packet->TestBoundingBox(m_root_box.min.x, m_root_box.min.y, m_root_box.min.z, m_root_box.max.x, m_root_box.max.y, m_root_box.max.z);
+        if (root_mask == 0) { return; }
+        if (m_node_array[m_root_index].IsLeaf() == true) {
+            report_hit(root_mask, m_root_index);
+            return;
+        }
+
+        /* Depth first traversal, lanes stopped by the callback are dropped on pop */
+        TraversalEntry stack[cMaxTraversalDepth];
+        u32            stack_count = 1;
+        stack[0] = { m_root_index, root_mask };
+        while (stack_count != 0) {
+            --stack_count;
+            const TraversalEntry entry = stack[stack_count];
+            const Node          &node  = m_node_array[entry.node_index];
+
+            for (u32 slot = 0; slot < 2; ++slot) {
+                const u32 child_mask = entry.lane_mask & active_mask & packet->TestBoundingBox(node.child_min_x[slot], node.child_min_y[slot], node.child_min_z[slot], node.child_max_x[slot], node.child_max_y[slot], node.child_max_z[slot]);
+                if (child_mask == 0) { continue; }
+
+                const u32 child_index = node.child_index[slot];
+                if (m_node_array[child_index].IsLeaf() == true) {
+                    report_hit(child_mask, child_index);
+                    continue;
+                }
+
+                VP_ASSERT(stack_count < cMaxTraversalDepth);
+                stack[stack_count] = { child_index, child_mask };
+                ++stack_count;
+            }
+        }
+    }
+
+    void DynamicBvh::QueryOverlap(const BoundingBox3f &box, OverlapCallback *callback) const {
+        const BoundingBox3f box_array[1]  = { box };
+        const ConstBoundingBox3fSoaArray soa_array = {
+            std::addressof(box_array[0].min.x), std::addressof(box_array[0].min.y), std::addressof(box_array[0].min.z),
+            std::addressof(box_array[0].max.x), std::addressof(box_array[0].max.y), std::addressof(box_array[0].max.z)
+        };
+        this->QueryOverlapArray(soa_array, 1, callback);
+    }
+
+    void DynamicBvh::QueryOverlapArray(const ConstBoundingBox3fSoaArray &box_array, u32 query_count, OverlapCallback *callback) const {
+
+        if (m_root_index == cInvalidIndex) { return; }
+
+        /* Traverse 8 queries at a time */
+        for (u32 i = 0; i < query_count; i += cLaneCount) {
+            const u32           lane_count = Min(query_count - i, cLaneCount);
+            const OverlapPacket packet     = {
+                LoadLane(box_array.min_x + i, lane_count),
+                LoadLane(box_array.min_y + i, lane_count),
+                LoadLane(box_array.min_z + i, lane_count),
+                LoadLane(box_array.max_x + i, lane_count),
+                LoadLane(box_array.max_y + i, lane_count),
+                LoadLane(box_array.max_z + i, lane_count),
+            };
+            this->QueryOverlapPacket(packet, cFullLaneMask >> (cLaneCount - lane_count), i, callback);
+        }
+    }
+
+    void DynamicBvh::RayCast(const Vector3f &origin, const Vector3f &direction, float max_t, RayCastCallback *callback) const {
+        const ConstRay3fSoaArray ray_array = {
+            std::addressof(origin.x), std::addressof(origin.y), std::addressof(origin.z),
+            std::addressof(direction.x), std::addressof(direction.y), std::addressof(direction.z),
+            std::addressof(max_t)
+        };
+        this->RayCastArray(ray_array, 1, callback);
+    }
+
+    void DynamicBvh::RayCastArray(const ConstRay3fSoaArray &ray_array, u32 ray_count, RayCastCallback *callback) const {
+
+        if (m_root_index == cInvalidIndex) { return; }
+
+        /* Traverse 8 rays at a time */
+        const v8f one = BroadcastLane(1.0f);
+        for (u32 i = 0; i < ray_count; i += cLaneCount) {
+            const u32 lane_count = Min(ray_count - i, cLaneCount);
+            RayPacket packet     = {
+                LoadLane(ray_array.origin_x + i, lane_count),
+                LoadLane(ray_array.origin_y + i, lane_count),
+                LoadLane(ray_array.origin_z + i, lane_count),
+                one / LoadLane(ray_array.direction_x + i, lane_count),
+                one / LoadLane(ray_array.direction_y + i, lane_count),
+                one / LoadLane(ray_array.direction_z + i, lane_count),
+                LoadLane(ray_array.max_t + i, lane_count),
+            };
+            this->RayCastPacket(std::addressof(packet), cFullLaneMask >> (cLaneCount - lane_count), i, callback);
+        }
+    }
+
+    u32 DynamicBvh::SplitBuildRange(u32 leaf_begin, u32 leaf_end) {
+
+        /* Split at the median centroid of the longest centroid axis */
+        BoundingBox3f centroid_box = {};
+        for (u32 i = leaf_begin; i < leaf_end; ++i) {
+            const BoundingBox3f &box = m_build_entry_array[i].box;
+            const Vector3f       centroid(box.min.x + box.max.x, box.min.y + box.max.y, box.min.z + box.max.z);
+            centroid_box = (i == leaf_begin) ? BoundingBox3f{ centroid, centroid } : MergeBoundingBox(centroid_box, BoundingBox3f{ centroid, centroid });
+        }
+        const float extent_x = centroid_box.max.x - centroid_box.min.x;
+        const float extent_y = centroid_box.max.y - centroid_box.min.y;
+        const float extent_z = centroid_box.max.z - centroid_box.min.z;
+        const u32   axis     = (extent_y < extent_x) ? ((extent_z < extent_x) ? 0 : 2) : ((extent_z < extent_y) ? 1 : 2);
+
+        const u32 leaf_mid = leaf_begin + (leaf_end - leaf_begin) / 2;
+        std::nth_element(m_build_entry_array + leaf_begin, m_build_entry_array + leaf_mid, m_build_entry_array + leaf_end, [axis](const BuildEntry &lhs, const BuildEntry &rhs) {
+            return GetCentroid(lhs.box, axis) < GetCentroid(rhs.box, axis);
+        });
+
+        return leaf_mid;
+    }
+
+    u32 DynamicBvh::BuildRange(BoundingBox3f *out_box, u32 leaf_begin, u32 leaf_end, u32 slot_base) {
+
+        if (leaf_end - leaf_begin == 1) {
+            *out_box = m_build_entry_array[leaf_begin].box;
+            return m_build_entry_array[leaf_begin].leaf_index;
+        }
+
+        /* A range of n leaves owns the n - 1 internal slots from its slot base, the node takes the first */
+        const u32 leaf_mid   = this->SplitBuildRange(leaf_begin, leaf_end);
+        const u32 node_index = m_internal_slot_array[slot_base];
+
+        BoundingBox3f left_box  = {};
+        BoundingBox3f right_box = {};
+        const u32 left_index  = this->BuildRange(std::addressof(left_box), leaf_begin, leaf_mid, slot_base + 1);
+        const u32 right_index = this->BuildRange(std::addressof(right_box), leaf_mid, leaf_end, slot_base + (leaf_mid - leaf_begin));
+
+        this->SetChild(node_index, 0, left_index, left_box);
+        this->SetChild(node_index, 1, right_index, right_box);
+        m_node_array[node_index].height = 1 + Max(m_node_array[left_index].height, m_node_array[right_index].height);
+
+        *out_box = MergeBoundingBox(left_box, right_box);
+        return node_index;
+    }
+
+    u32 DynamicBvh::BeginRebuild(u32 max_subtree_count) {
+
+        /* Gather leaves */
+        u32 leaf_count = 0;
+        for (u32 i = 0; i < m_node_capacity; ++i) {
+            if (m_node_array[i].IsLeaf() == false) { continue; }
+            m_build_entry_array[leaf_count] = { this->GetNodeBoundingBox(i), i };
+            ++leaf_count;
+        }
+
+        /* Reserve internal nodes for the build and free the rest */
+        const u32 internal_count = (leaf_count == 0) ? 0 : leaf_count - 1;
+        u32       slot_count     = 0;
+        m_free_index = cInvalidIndex;
+        for (u32 i = m_node_capacity; 0 < i; --i) {
+            const u32 node_index = i - 1;
+            if (m_node_array[node_index].IsLeaf() == true) { continue; }
+            if (slot_count < internal_count) {
+                m_internal_slot_array[slot_count] = node_index;
+                ++slot_count;
+                continue;
+            }
+            this->FreeNode(node_index);
+        }
+
+        m_rebuild_range_count = 0;
+        m_top_node_count      = 0;
+        m_root_index          = cInvalidIndex;
+        if (leaf_count == 0) { return 0; }
+
+        /* Split the largest range until there are enough subtrees */
+        m_rebuild_range_array[0] = { 0, leaf_count, 0, cInvalidIndex, 0 };
+        m_rebuild_range_count    = 1;
+        max_subtree_count        = Min(Max(max_subtree_count, 1u), cMaxRebuildSubtreeCount);
+        while (m_rebuild_range_count < max_subtree_count) {
+
+            u32 largest = 0;
+            for (u32 i = 1; i < m_rebuild_range_count; ++i) {
+                if ((m_rebuild_range_array[largest].leaf_end - m_rebuild_range_array[largest].leaf_begin) < (m_rebuild_range_array[i].leaf_end - m_rebuild_range_array[i].leaf_begin)) { largest = i; }
+            }
+            const RebuildRange range = m_rebuild_range_array[largest];
+            if (range.leaf_end - range.leaf_begin < 2) { break; }
+
+            /* Link a top node, its bounds are set by EndRebuild */
+            const u32 leaf_mid   = this->SplitBuildRange(range.leaf_begin, range.leaf_end);
+            const u32 node_index = m_internal_slot_array[range.slot_base];
+            Node     *node       = std::addressof(m_node_array[node_index]);
+            node->height         = 1;
+            if (range.parent_index == cInvalidIndex) {
+                m_root_index       = node_index;
+                node->parent_index = cInvalidIndex;
+                node->parent_slot  = 0;
+            } else {
+                m_node_array[range.parent_index].child_index[range.parent_slot] = node_index;
+                node->parent_index = range.parent_index;
+                node->parent_slot  = range.parent_slot;
+            }
+            m_top_node_array[m_top_node_count] = node_index;
+            ++m_top_node_count;
+
+            m_rebuild_range_array[largest]               = { range.leaf_begin, leaf_mid, range.slot_base + 1, node_index, 0 };
+            m_rebuild_range_array[m_rebuild_range_count] = { leaf_mid, range.leaf_end, range.slot_base + (leaf_mid - range.leaf_begin), node_index, 1 };
+            ++m_rebuild_range_count;
+        }
+
+        return m_rebuild_range_count;
+    }
+
+    void DynamicBvh::RebuildSubtree(u32 subtree_index) {
+
+        /* Subtrees write disjoint nodes and their own slot of a top node */
+        const RebuildRange &range      = m_rebuild_range_array[subtree_index];
+        BoundingBox3f       box        = {};
+        const u32           root_index = this->BuildRange(std::addressof(box), range.leaf_begin, range.leaf_end, range.slot_base);
+        if (range.parent_index == cInvalidIndex) {
+            this->SetRoot(root_index, box);
+        } else {
+            this->SetChild(range.parent_index, range.parent_slot, root_index, box);
+        }
+    }
+
+    void DynamicBvh::EndRebuild() {
+
+        /* Top nodes were linked parents first, so refit them in reverse */
+        for (u32 i = m_top_node_count; 0 < i; --i) {
+            const u32 node_index = m_top_node_array[i - 1];
+            Node     *node       = std::addressof(m_node_array[node_index]);
+            node->height = 1 + Max(m_node_array[node->child_index[0]].height, m_node_array[node->child_index[1]].height);
+            this->SetNodeBoundingBox(node_index, MergeBoundingBox(GetChildBoundingBox(*node, 0), GetChildBoundingBox(*node, 1)));
+        }
+
+        m_rebuild_range_count = 0;
+        m_top_node_count      = 0;
+    }
+
+    void DynamicBvh::Rebuild() {
+        const u32 subtree_count = this->BeginRebuild(1);
+        for (u32 i = 0; i < subtree_count; ++i) {
+            this->RebuildSubtree(i);
+        }
+        this->EndRebuild();
+    }
+}
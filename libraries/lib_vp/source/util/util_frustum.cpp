@@ -0,0 +1,199 @@
+/*
+ *  Copyright (C) W. Michael Knudson
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 2 as 
+ *  published by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with this program; 
+ *  if not, see <https://www.gnu.org/licenses/>.
+ */
+#include <vp.hpp>
+
+namespace vp::util {
+
+    namespace {
+
+        constexpr u32 cLaneCount = sizeof(v8f) / sizeof(float);
+
+        ALWAYS_INLINE v8f LoadLane(const float *address) {
+            v8f lane;
+            ::memcpy(std::addressof(lane), address, sizeof(v8f));
+            return lane;
+        }
+
+        ALWAYS_INLINE v8f BroadcastLane(float value) {
+            return v8f{ value, value, value, value, value, value, value, value };
+        }
+
+        /* Packs the sign bit of each lane into the low 8 bits */
+        ALWAYS_INLINE u32 GetLaneMask(v8si mask) {
+            #if defined(VP_TARGET_ARCHITECTURE_x86)
+                return static_cast<u32>(__builtin_ia32_movmskps256(reinterpret_cast<v8f>(mask)));
+            #else
+                u32 bits = 0;
+                for (u32 i = 0; i < cLaneCount; ++i) {
+                    bits |= static_cast<u32>(mask[i] & 1) << i;
+                }
+                return bits;
+            #endif
+        }
+
+        /* Appends the index of each set lane bit */
+        ALWAYS_INLINE u32 WriteVisibleIndices(u32 *out_visible_index_array, u32 visible_count, u32 lane_mask, u32 base_index) {
+            while (lane_mask != 0) {
+                out_visible_index_array[visible_count] = base_index + __builtin_ctz(lane_mask);
+                ++visible_count;
+                lane_mask &= lane_mask - 1;
+            }
+            return visible_count;
+        }
+
+        ALWAYS_INLINE Vector4f NormalizePlane(const Vector4f &plane) {
+            const float inverse_length = 1.0f / ::sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            return Vector4f(plane.x * inverse_length, plane.y * inverse_length, plane.z * inverse_length, plane.w * inverse_length);
+        }
+    }
+
+    void Frustum::Set(const Matrix44f &view_projection) {
+
+        /* Gribb-Hartmann, each plane is the w row plus or minus an axis row */
+        const v4f row1 = view_projection.m_row1.GetVectorType();
+        const v4f row2 = view_projection.m_row2.GetVectorType();
+        const v4f row3 = view_projection.m_row3.GetVectorType();
+        const v4f row4 = view_projection.m_row4.GetVectorType();
+        m_plane_array[PlaneIndex_Left]   = NormalizePlane(Vector4f(row4 + row1));
+        m_plane_array[PlaneIndex_Right]  = NormalizePlane(Vector4f(row4 - row1));
+        m_plane_array[PlaneIndex_Bottom] = NormalizePlane(Vector4f(row4 + row2));
+        m_plane_array[PlaneIndex_Top]    = NormalizePlane(Vector4f(row4 - row2));
+        m_plane_array[PlaneIndex_Near]   = NormalizePlane(Vector4f(row4 + row3));
+        m_plane_array[PlaneIndex_Far]    = NormalizePlane(Vector4f(row4 - row3));
+    }
+
+    void Frustum::Set(const Matrix44f &projection, const Matrix34f &view) {
+
+        /* Multiply by the view extended with a 0 0 0 1 row */
+        Matrix44f view_projection;
+        for (u32 i = 0; i < 4; ++i) {
+            for (u32 j = 0; j < 4; ++j) {
+                view_projection.m_arr2d[i][j] = projection.m_arr2d[i][0] * view.m_arr2d[0][j] + projection.m_arr2d[i][1] * view.m_arr2d[1][j] + projection.m_arr2d[i][2] * view.m_arr2d[2][j];
+            }
+            view_projection.m_arr2d[i][3] += projection.m_arr2d[i][3];
+        }
+
+        this->Set(view_projection);
+    }
+
+    void Frustum::Set(Projection *projection, const Camera *camera) {
+        this->Set(*projection->GetProjectionMatrix(), *camera->GetCameraMatrix());
+    }
+
+    u32 Frustum::CullSphereArray(u32 *out_visible_index_array, const ConstBoundingSphere3fSoaArray &sphere_array, u32 base_index, u32 count) const {
+
+        /* Broadcast planes */
+        v8f plane_x[cPlaneCount];
+        v8f plane_y[cPlaneCount];
+        v8f plane_z[cPlaneCount];
+        v8f plane_w[cPlaneCount];
+        for (u32 i = 0; i < cPlaneCount; ++i) {
+            plane_x[i] = BroadcastLane(m_plane_array[i].x);
+            plane_y[i] = BroadcastLane(m_plane_array[i].y);
+            plane_z[i] = BroadcastLane(m_plane_array[i].z);
+            plane_w[i] = BroadcastLane(m_plane_array[i].w);
+        }
+
+        /* Test 8 spheres against every plane */
+        u32       visible_count = 0;
+        const u32 end_index     = base_index + count;
+        const u32 lane_end      = base_index + (count & ~(cLaneCount - 1));
+        u32       index         = base_index;
+        for (; index < lane_end; index += cLaneCount) {
+
+            const v8f center_x     = LoadLane(sphere_array.center_x + index);
+            const v8f center_y     = LoadLane(sphere_array.center_y + index);
+            const v8f center_z     = LoadLane(sphere_array.center_z + index);
+            const v8f neg_radius   = -LoadLane(sphere_array.radius + index);
+
+            v8si visible = v8si{ -1, -1, -1, -1, -1, -1, -1, -1 };
+            for (u32 i = 0; i < cPlaneCount; ++i) {
+                const v8f distance = plane_x[i] * center_x + plane_y[i] * center_y + plane_z[i] * center_z + plane_w[i];
+                visible &= (neg_radius <= distance);
+            }
+
+            visible_count = WriteVisibleIndices(out_visible_index_array, visible_count, GetLaneMask(visible), index);
+        }
+
+        /* Remainder */
+        for (; index < end_index; ++index) {
+            const Vector3f center(sphere_array.center_x[index], sphere_array.center_y[index], sphere_array.center_z[index]);
+            out_visible_index_array[visible_count] = index;
+            visible_count += this->IsSphereVisible(center, sphere_array.radius[index]);
+        }
+
+        return visible_count;
+    }
+
+    u32 Frustum::CullBoundingBoxArray(u32 *out_visible_index_array, const ConstBoundingBox3fSoaArray &box_array, u32 base_index, u32 count) const {
+
+        /* Broadcast planes and select the box extent furthest along each plane normal */
+        v8f          plane_x[cPlaneCount];
+        v8f          plane_y[cPlaneCount];
+        v8f          plane_z[cPlaneCount];
+        v8f          plane_w[cPlaneCount];
+        const float *corner_x[cPlaneCount];
+        const float *corner_y[cPlaneCount];
+        const float *corner_z[cPlaneCount];
+        for (u32 i = 0; i < cPlaneCount; ++i) {
+            plane_x[i]  = BroadcastLane(m_plane_array[i].x);
+            plane_y[i]  = BroadcastLane(m_plane_array[i].y);
+            plane_z[i]  = BroadcastLane(m_plane_array[i].z);
+            plane_w[i]  = BroadcastLane(m_plane_array[i].w);
+            corner_x[i] = (0.0f <= m_plane_array[i].x) ? box_array.max_x : box_array.min_x;
+            corner_y[i] = (0.0f <= m_plane_array[i].y) ? box_array.max_y : box_array.min_y;
+            corner_z[i] = (0.0f <= m_plane_array[i].z) ? box_array.max_z : box_array.min_z;
+        }
+
+        /* Test 8 boxes against every plane */
+        u32       visible_count = 0;
+        const u32 end_index     = base_index + count;
+        const u32 lane_end      = base_index + (count & ~(cLaneCount - 1));
+        u32       index         = base_index;
+        for (; index < lane_end; index += cLaneCount) {
+
+            v8si visible = v8si{ -1, -1, -1, -1, -1, -1, -1, -1 };
+            for (u32 i = 0; i < cPlaneCount; ++i) {
+                const v8f distance = plane_x[i] * LoadLane(corner_x[i] + index) + plane_y[i] * LoadLane(corner_y[i] + index) + plane_z[i] * LoadLane(corner_z[i] + index) + plane_w[i];
+                visible &= (0.0f <= distance);
+            }
+
+            visible_count = WriteVisibleIndices(out_visible_index_array, visible_count, GetLaneMask(visible), index);
+        }
+
+        /* Remainder */
+        for (; index < end_index; ++index) {
+            const BoundingBox3f box = {
+                Vector3f(box_array.min_x[index], box_array.min_y[index], box_array.min_z[index]),
+                Vector3f(box_array.max_x[index], box_array.max_y[index], box_array.max_z[index])
+            };
+            out_visible_index_array[visible_count] = index;
+            visible_count += this->IsBoundingBoxVisible(box);
+        }
+
+        return visible_count;
+    }
+
+    u32 FrustumCullJob::CompactVisibleIndexArray(u32 *out_visible_index_array, const FrustumCullJob *job_array, u32 job_count) {
+        u32 visible_count = 0;
+        for (u32 i = 0; i < job_count; ++i) {
+            const u32 job_visible_count = job_array[i].GetVisibleCount();
+            ::memmove(out_visible_index_array + visible_count, job_array[i].GetVisibleIndexArray(), job_visible_count * sizeof(u32));
+            visible_count += job_visible_count;
+        }
+        return visible_count;
+    }
+}